@@ -0,0 +1,104 @@
+#!/usr/bin/python3
+
+# Stand-in LED-Rails backend for testing without the real servers. Serves a synthetic
+# realtime feed (trains stepping along the blocks of both strands) with ETag / 304 and
+# optional gzip, and the per-board config document (see include/remoteConfig.h).
+#
+# Usage:
+#   python "Host Tools/feed-server.py" [port]                         (default 3000)
+#
+#   Feed:   http://<this computer>:3000/<city>-ltm/<version>.json      e.g. /akl-ltm/110.json
+#   Config: http://<this computer>:3000/<city>-ltm/config/<board>.json (from config/<board>.json if present)
+#
+# Point a map at it with the commented out local server in src/main.cpp, OVERLAY_FEED_URL, or
+# a "mirrors" entry in the config document.
+
+import gzip
+import hashlib
+import json
+import os
+import re
+import sys
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+UPDATE_INTERVAL = 30  # Seconds, sent as "update"
+TRAINS = 12
+STRANDS = ((100, 235), (300, 45))  # (first block, blocks), LED_1 / LED_2 like the boards
+COLORS = {"Red": [255, 0, 0], "Green": [0, 255, 0], "Blue": [0, 64, 255], "Yellow": [255, 200, 0]}
+SECONDS_PER_BLOCK = 20
+
+
+def make_feed(version: str, now: int) -> dict:
+    """Trains advance one block every SECONDS_PER_BLOCK, updates cover the next interval"""
+    base = now - now % UPDATE_INTERVAL
+    updates = []
+    for train in range(TRAINS):
+        first, count = STRANDS[train % len(STRANDS)]
+        position = (base // SECONDS_PER_BLOCK + train * 17) % count
+        block = first + position
+        updates.append({"b": [0, block], "c": train % len(COLORS), "t": 0})  # Where the train is now
+
+        # Moves within the next interval
+        step_time = SECONDS_PER_BLOCK - base % SECONDS_PER_BLOCK
+        while step_time <= UPDATE_INTERVAL:
+            position = (position + 1) % count
+            updates.append({"b": [block, first + position], "c": train % len(COLORS), "t": step_time})
+            block = first + position
+            step_time += SECONDS_PER_BLOCK
+
+    return {"version": version, "timestamp": base, "update": UPDATE_INTERVAL, "colors": COLORS, "updates": updates}
+
+
+class FeedServer(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"  # Keep-alive, like the real servers
+
+    def do_GET(self):
+        feed = re.fullmatch(r"/([a-z]+)-ltm/(\d+)\.json", self.path)
+        config = re.fullmatch(r"/([a-z]+)-ltm/config/(\w+)\.json", self.path)
+
+        if feed:
+            body = json.dumps(make_feed(feed.group(2), int(time.time())), separators=(",", ":")).encode()
+        elif config and os.path.exists(f"config/{config.group(2)}.json"):
+            with open(f"config/{config.group(2)}.json", "rb") as file:
+                body = file.read()
+        else:
+            self.reply(404, b"")
+            return
+
+        etag = '"' + hashlib.sha1(body).hexdigest()[:16] + '"'
+        if self.headers.get("If-None-Match") == etag:
+            self.reply(304, None, etag=etag)
+            return
+
+        encoding = None
+        if "gzip" in self.headers.get("Accept-Encoding", ""):
+            body = gzip.compress(body)
+            encoding = "gzip"
+        self.reply(200, body, etag=etag, encoding=encoding)
+
+    def reply(self, status, body, etag=None, encoding=None):
+        self.send_response(status)
+        if etag:
+            self.send_header("ETag", etag)
+        if body is not None:
+            self.send_header("Content-Type", "application/json")
+            self.send_header("Content-Length", str(len(body)))
+        if encoding:
+            self.send_header("Content-Encoding", encoding)
+        self.end_headers()
+        if body:
+            self.wfile.write(body)
+
+    def log_message(self, format, *args):
+        print(f"{time.strftime('%H:%M:%S')} {self.client_address[0]} {format % args}", flush=True)
+
+
+def main():
+    port = int(sys.argv[1]) if len(sys.argv) > 1 else 3000
+    print(f"Serving the stand-in feed on port {port}")
+    ThreadingHTTPServer(("", port), FeedServer).serve_forever()
+
+
+if __name__ == "__main__":
+    main()
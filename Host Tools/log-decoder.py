@@ -0,0 +1,155 @@
+#!/usr/bin/python3
+
+# Decodes the binary log records written by LOG_BINARY firmware builds (see include/log.h).
+# Text lines are passed through unchanged.
+#
+# Usage:
+#   python "Host Tools/log-decoder.py" COM5            (live, needs pyserial)
+#   python "Host Tools/log-decoder.py" capture.bin     (raw serial capture)
+
+import struct
+import sys
+from datetime import datetime
+
+SYNC = b"\x1e\xa5"
+
+# id: (name, struct format, field names, text format) - must match the records in include/log.h
+RECORDS = {
+    1: (
+        "Fetch",
+        "<IhbbHHHHIIHII",
+        (
+            "epoch",
+            "fetchDelay",
+            "mcuTemperature",
+            "rssi",
+            "ledFrames",
+            "ledUnderruns",
+            "ledRetransmits",
+            "ledMaxTxMicros",
+            "ledMaxEncodeCycles",
+            "loopMaxMicros",
+            "blocksTouched",
+            "photonMaxMicros",
+            "photonMeanMicros",
+        ),
+        "{clock} fetchDelay:{fetchDelay}s MCU:{mcuTemperature}°C WiFi:{rssi}dBm "
+        "LED:{ledFrames} frames, {ledUnderruns} underruns, {ledRetransmits} resent, max {ledMaxTxMicros}us, "
+        "encode {ledMaxEncodeCycles} cycles, loop max {loopMaxMicros}us, {blocksTouched} blocks touched, "
+        "photon max {photonMaxMicros}us mean {photonMeanMicros}us",
+    ),
+    2: (
+        "Http",
+        "<hBIIIIi",
+        ("status", "reused", "bodyBytes", "connectMicros", "firstByteMicros", "totalMicros", "heapUsed"),
+        "Fetch {status}: {bodyBytes} bytes, connect {connectMicros}us, first byte {firstByteMicros}us, "
+        "total {totalMicros}us, heap used {heapUsed} bytes, reused {reused}",
+    ),
+    3: (
+        "BlockRange",
+        "<H",
+        ("block",),
+        "Block {block} is out of range for both strands.",
+    ),
+    4: (
+        "Brightness",
+        "<HBH",
+        ("gain", "powerOn", "lux"),
+        "Brightness set to {gain}/65535 (power {powerOn}), {lux} lux",
+    ),
+    5: (
+        "Button",
+        "<BIII",
+        ("pin", "latencyMicros", "maxIsrCycles", "overflows"),
+        "Button {pin}: {latencyMicros}us, ISR max {maxIsrCycles} cycles, {overflows} edges dropped",
+    ),
+    6: (
+        "Scheduling",
+        "<BBHII",
+        ("core", "dualCore", "wakes", "maxMicros", "meanMicros"),
+        "Scheduling core {core} (dual-core layout {dualCore}): {wakes} wakes, max {maxMicros}us, mean {meanMicros}us",
+    ),
+}
+
+
+def decode_record(record_id: int, payload: bytes) -> str:
+    if record_id not in RECORDS:
+        return f"[?] Unknown record {record_id}: {payload.hex()}"
+
+    name, fmt, fields, text = RECORDS[record_id]
+    if struct.calcsize(fmt) != len(payload):
+        return f"[?] {name} record has {len(payload)} bytes, expected {struct.calcsize(fmt)}"
+
+    values = dict(zip(fields, struct.unpack(fmt, payload)))
+    if "epoch" in values:
+        values["clock"] = datetime.fromtimestamp(values["epoch"]).strftime("%H:%M:%S")
+    return f"[R] {text.format(**values)}"
+
+
+def decode_stream(read):
+    """Splits the byte stream into text lines and binary records, yields printable lines"""
+    buffer = b""
+    while True:
+        chunk = read()
+        if chunk is None:
+            if buffer:
+                yield buffer.decode(errors="replace")
+            return
+        buffer += chunk
+
+        while True:
+            sync = buffer.find(SYNC)
+            newline = buffer.find(b"\n")
+
+            # Text before the next record
+            if newline != -1 and (sync == -1 or newline < sync):
+                yield buffer[:newline].decode(errors="replace").rstrip("\r")
+                buffer = buffer[newline + 1 :]
+                continue
+
+            if sync == -1 or len(buffer) < sync + 4:
+                break
+
+            length = buffer[sync + 3]
+            end = sync + 4 + length + 1
+            if len(buffer) < end:
+                break
+
+            if sync > 0:
+                yield buffer[:sync].decode(errors="replace")
+
+            record_id = buffer[sync + 2]
+            payload = buffer[sync + 4 : end - 1]
+            checksum = 0
+            for byte in buffer[sync + 2 : end - 1]:
+                checksum ^= byte
+
+            if checksum == buffer[end - 1]:
+                yield decode_record(record_id, payload)
+                buffer = buffer[end:]
+            else:
+                buffer = buffer[sync + 1 :]  # Not a record, resync after this byte
+
+
+def main():
+    if len(sys.argv) != 2:
+        print("Usage: log-decoder.py <serial port | capture file>")
+        sys.exit(1)
+
+    source = sys.argv[1]
+    try:
+        stream = open(source, "rb")
+        read = lambda: stream.read(4096) or None  # None marks the end of the capture
+    except FileNotFoundError:
+        import serial  # pyserial, only needed for live decoding
+
+        port = serial.Serial(source, 115200, timeout=0.1)
+        read = lambda: port.read(4096)  # Empty on timeout, never ends
+
+    for line in decode_stream(read):
+        if line:
+            print(line, flush=True)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,99 @@
+#!/usr/bin/python3
+
+# Decodes the minute by minute metrics history of a map (see include/metricsHistory.h) into CSV.
+#
+# Usage:
+#   python "Host Tools/metrics-decoder.py" http://<map ip>/metrics.bin [out.csv]
+#   python "Host Tools/metrics-decoder.py" metrics.bin [out.csv]          (a saved download)
+#
+# Writes to stdout without an output file. Times are local to this computer.
+
+import csv
+import struct
+import sys
+import urllib.request
+import zlib
+from datetime import datetime
+
+# Must match MetricsPageHeader and MetricsSample in include/metricsHistory.h
+VERSION = 1
+PAGE_SIZE = 256
+HEADER = struct.Struct("<BBHII")
+FIELDS = ("fetchMsMax", "fetches", "failures", "rssi", "heapMin", "lux", "brightness")
+
+
+def varints(data: bytes):
+    value = shift = 0
+    for byte in data:
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            yield (value >> 1) ^ -(value & 1)  # Zigzag
+            value = shift = 0
+
+
+def decode_page(page: bytes):
+    """Samples of one page as (epoch, values), empty for erased, torn or foreign pages"""
+    version, count, length, epoch, crc = HEADER.unpack_from(page)
+    if version != VERSION or not HEADER.size <= length <= PAGE_SIZE:
+        return []
+    body = page[HEADER.size : length]
+    if zlib.crc32(body) != crc:
+        return []
+
+    values = list(varints(body))
+    if len(values) != count * len(FIELDS):
+        return []
+    samples = []
+    previous = [0] * len(FIELDS)
+    for i in range(count):
+        fields = values[i * len(FIELDS) : (i + 1) * len(FIELDS)]
+        if i > 0:
+            fields = [base + delta for base, delta in zip(previous, fields)]
+        samples.append((epoch + i * 60, fields))
+        previous = fields
+    return samples
+
+
+def decode(data: bytes):
+    samples = {}
+    pages = 0
+    for offset in range(0, len(data) - PAGE_SIZE + 1, PAGE_SIZE):
+        page = decode_page(data[offset : offset + PAGE_SIZE])
+        pages += bool(page)
+        samples.update(page)
+    return [samples[epoch] + [epoch] for epoch in sorted(samples)], pages
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit("usage: metrics-decoder.py <url or file> [out.csv]")
+    source = sys.argv[1]
+    if source.startswith("http://"):
+        with urllib.request.urlopen(source, timeout=60) as response:
+            data = response.read()
+    else:
+        with open(source, "rb") as file:
+            data = file.read()
+
+    rows, pages = decode(data)
+    used = sum(1 for offset in range(0, len(data), PAGE_SIZE) if data[offset] == VERSION) * PAGE_SIZE
+    if rows:
+        first, last = datetime.fromtimestamp(rows[0][-1]), datetime.fromtimestamp(rows[-1][-1])
+        print(
+            f"{len(rows)} minutes from {first:%Y-%m-%d %H:%M} to {last:%Y-%m-%d %H:%M} in {pages} pages, "
+            f"{used / len(rows):.1f} bytes a minute ({len(FIELDS) * 4} uncompressed)",
+            file=sys.stderr,
+        )
+    else:
+        print("No samples", file=sys.stderr)
+
+    output = open(sys.argv[2], "w", newline="") if len(sys.argv) > 2 else sys.stdout
+    writer = csv.writer(output)
+    writer.writerow(("time",) + FIELDS)
+    for row in rows:
+        writer.writerow([datetime.fromtimestamp(row[-1]).strftime("%Y-%m-%d %H:%M")] + row[:-1])
+
+
+if __name__ == "__main__":
+    main()
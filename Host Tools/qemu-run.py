@@ -0,0 +1,125 @@
+#!/usr/bin/python3
+
+# Boots the merged firmware image (see merge-bin.py) in Espressif's QEMU and captures the
+# serial console with timestamps, binary log records decoded (see log-decoder.py).
+#
+# Needs Espressif's QEMU fork (qemu-system-riscv32 with the esp32c3 machine) on the PATH,
+# or given with --qemu. Build a *_QEMU environment, its console is on UART0 instead of USB:
+#
+#   pio run -e WLG_V1_0_0_QEMU -t mergebin
+#   python "Host Tools/qemu-run.py" WLG_V1_0_0_QEMU [--seconds 60] [--icount] [--log capture.txt]
+#
+# Prints a summary of boot time, setup time, heap and fetch timings at the end. The firmware
+# networks over Wi-Fi, which QEMU does not emulate, so feed fetches only appear in builds
+# with a network QEMU provides (openeth); use "Host Tools/feed-server.py" as the backend.
+
+import argparse
+import importlib.util
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+FLASH_SIZE = 4 * 1024 * 1024  # QEMU only accepts full size flash images
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+
+def load_log_decoder():
+    spec = importlib.util.spec_from_file_location("log_decoder", os.path.join(HERE, "log-decoder.py"))
+    module = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(module)
+    return module
+
+
+def padded_image(merged: str) -> str:
+    with open(merged, "rb") as file:
+        image = file.read()
+    if len(image) > FLASH_SIZE:
+        sys.exit(f"{merged} is larger than the {FLASH_SIZE // (1024 * 1024)}MB flash")
+
+    padded = os.path.join(tempfile.mkdtemp(), "flash.bin")
+    with open(padded, "wb") as file:
+        file.write(image + b"\xff" * (FLASH_SIZE - len(image)))
+    return padded
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Run the merged firmware image in QEMU")
+    parser.add_argument("env", help="PlatformIO environment, e.g. WLG_V1_0_0_QEMU")
+    parser.add_argument("--qemu", default="qemu-system-riscv32")
+    parser.add_argument("--seconds", type=float, default=60, help="how long to run")
+    parser.add_argument("--icount", action="store_true", help="deterministic virtual clock (slower)")
+    parser.add_argument("--log", help="also write the decoded console to this file")
+    args = parser.parse_args()
+
+    merged = os.path.join(HERE, "..", ".pio", "build", args.env, "firmware-merged.bin")
+    if not os.path.exists(merged):
+        sys.exit(f"{merged} not found, run: pio run -e {args.env} -t mergebin")
+    if shutil.which(args.qemu) is None:
+        sys.exit(f"{args.qemu} not found, install Espressif's QEMU (idf_tools.py install qemu-riscv32)")
+
+    command = [
+        args.qemu,
+        "-nographic",
+        "-machine", "esp32c3",
+        "-drive", f"file={padded_image(merged)},if=mtd,format=raw",
+        "-serial", "stdio",
+    ]  # fmt: skip
+    if args.icount:
+        command += ["-icount", "3"]
+
+    decoder = load_log_decoder()
+    qemu = subprocess.Popen(command, stdout=subprocess.PIPE, stdin=subprocess.DEVNULL)
+    os.set_blocking(qemu.stdout.fileno(), False)
+    start = time.monotonic()
+    output = open(args.log, "w") if args.log else None
+
+    def read():
+        if time.monotonic() - start > args.seconds or qemu.poll() is not None:
+            return None
+        chunk = qemu.stdout.read(4096)
+        if not chunk:
+            time.sleep(0.01)
+        return chunk or b""
+
+    summary = {}
+    try:
+        for line in decoder.decode_stream(read):
+            if not line:
+                continue
+            elapsed = time.monotonic() - start
+            stamped = f"{elapsed:9.3f} {line}"
+            print(stamped, flush=True)
+            if output:
+                output.write(stamped + "\n")
+
+            if "boot:" in line and "boot" not in summary:
+                summary["boot"] = elapsed
+            if (match := re.search(r"Setup done in (\d+) ms, free heap (\d+)", line)) and "setup" not in summary:
+                summary["setup"] = (elapsed, int(match.group(1)), int(match.group(2)))
+            if re.match(r"\[[RI]\] Fetch -?\d+:", line) and "firstFetch" not in summary:
+                summary["firstFetch"] = (elapsed, line)
+    finally:
+        qemu.kill()
+        if output:
+            output.close()
+
+    print("\n--- Summary (host seconds since QEMU start) ---")
+    print(f"ROM boot banner:  {summary['boot']:.3f}s" if "boot" in summary else "ROM boot banner:  not seen")
+    if "setup" in summary:
+        elapsed, millis, heap = summary["setup"]
+        print(f"setup() done:     {elapsed:.3f}s ({millis} ms firmware time), {heap} bytes free heap")
+    else:
+        print("setup() done:     not seen")
+    if "firstFetch" in summary:
+        elapsed, line = summary["firstFetch"]
+        print(f"First fetch:      {elapsed:.3f}s {line[4:]}")
+    else:
+        print("First fetch:      not seen (no network in this QEMU build)")
+
+
+if __name__ == "__main__":
+    main()
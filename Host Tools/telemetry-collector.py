@@ -0,0 +1,125 @@
+#!/usr/bin/python3
+
+# Stand-in telemetry collector for TELEMETRY_URL firmware builds (see include/telemetry.h).
+# Accepts the binary batches posted by the maps, prints them and appends one JSON line per
+# sample to a log file.
+#
+# Usage:
+#   python "Host Tools/telemetry-collector.py" [port] [log file]      (default 8080, telemetry.jsonl)
+#   build with -DTELEMETRY_URL=\"http://<this computer>:8080/telemetry\"
+#
+#   python "Host Tools/telemetry-collector.py" --decode batch.bin      (decode a saved batch)
+
+import json
+import struct
+import sys
+from datetime import datetime, timezone
+from http.server import BaseHTTPRequestHandler, HTTPServer
+
+# Must match TelemetryHeader and TelemetrySample in include/telemetry.h
+VERSION = 1
+HEADER = struct.Struct("<B6s4s8sHBIHB")
+HEADER_FIELDS = ("version", "mac", "city", "firmware", "bootCount", "resetReason", "uptimeS", "droppedSamples", "sampleCount")
+SAMPLE = struct.Struct("<IHHHHHHHHHbb")
+SAMPLE_FIELDS = (
+    "epoch",
+    "fetches",
+    "fetchFailures",
+    "fetchMsAvg",
+    "fetchMsMax",
+    "heapMinKb",
+    "fpsX10",
+    "ledUnderruns",
+    "luxMin",
+    "luxMax",
+    "rssiMin",
+    "temperatureMax",
+)
+
+# esp_reset_reason_t
+RESET_REASONS = ["UNKNOWN", "POWERON", "EXT", "SW", "PANIC", "INT_WDT", "TASK_WDT", "WDT", "DEEPSLEEP", "BROWNOUT", "SDIO"]
+
+
+def decode_batch(body: bytes) -> tuple[dict, list[dict]]:
+    if len(body) < HEADER.size:
+        raise ValueError(f"batch too short ({len(body)} bytes)")
+
+    header = dict(zip(HEADER_FIELDS, HEADER.unpack_from(body)))
+    if header["version"] != VERSION:
+        raise ValueError(f"unsupported version {header['version']}")
+    expected = HEADER.size + header["sampleCount"] * SAMPLE.size
+    if len(body) != expected:
+        raise ValueError(f"batch has {len(body)} bytes, expected {expected}")
+
+    header["mac"] = header["mac"].hex(":")
+    header["city"] = header["city"].rstrip(b"\0").decode(errors="replace")
+    header["firmware"] = header["firmware"].rstrip(b"\0").decode(errors="replace")
+    reason = header["resetReason"]
+    header["resetReason"] = RESET_REASONS[reason] if reason < len(RESET_REASONS) else str(reason)
+
+    samples = []
+    for i in range(header["sampleCount"]):
+        sample = dict(zip(SAMPLE_FIELDS, SAMPLE.unpack_from(body, HEADER.size + i * SAMPLE.size)))
+        sample["fps"] = sample.pop("fpsX10") / 10
+        samples.append(sample)
+    return header, samples
+
+
+def print_batch(header: dict, samples: list[dict]) -> None:
+    print(
+        f"{header['mac']} {header['city']} v{header['firmware']} boot {header['bootCount']} "
+        f"({header['resetReason']}), up {header['uptimeS'] // 3600}h, "
+        f"{header['sampleCount']} samples, {header['droppedSamples']} dropped"
+    )
+    for s in samples:
+        clock = datetime.fromtimestamp(s["epoch"], timezone.utc).strftime("%Y-%m-%d %H:%M")
+        print(
+            f"  {clock}Z fetches {s['fetches']} ({s['fetchFailures']} failed, avg {s['fetchMsAvg']}ms, "
+            f"max {s['fetchMsMax']}ms) heap {s['heapMinKb']}KiB {s['fps']}fps {s['ledUnderruns']} underruns "
+            f"lux {s['luxMin']}-{s['luxMax']} {s['rssiMin']}dBm {s['temperatureMax']}°C"
+        )
+
+
+class Collector(BaseHTTPRequestHandler):
+    log_file = "telemetry.jsonl"
+
+    def do_POST(self):
+        body = self.rfile.read(int(self.headers.get("Content-Length", 0)))
+        try:
+            header, samples = decode_batch(body)
+        except ValueError as error:
+            print(f"Rejected batch from {self.client_address[0]}: {error}")
+            self.send_response(400)
+            self.send_header("Content-Length", "0")
+            self.end_headers()
+            return
+
+        print_batch(header, samples)
+        with open(self.log_file, "a") as log:
+            for sample in samples:
+                log.write(json.dumps({**header, **sample}) + "\n")
+
+        self.send_response(204)
+        self.end_headers()
+
+    def log_message(self, format, *args):
+        pass  # Batches are printed instead
+
+
+def main():
+    if len(sys.argv) == 3 and sys.argv[1] == "--decode":
+        with open(sys.argv[2], "rb") as file:
+            print_batch(*decode_batch(file.read()))
+        return
+
+    port = int(sys.argv[1]) if len(sys.argv) > 1 else 8080
+    if len(sys.argv) > 2:
+        Collector.log_file = sys.argv[2]
+
+    Collector.protocol_version = "HTTP/1.1"  # Keep-alive, like the feed servers
+    print(f"Collecting telemetry on port {port} into {Collector.log_file}")
+    HTTPServer(("", port), Collector).serve_forever()
+
+
+if __name__ == "__main__":
+    main()
@@ -1,6 +1,8 @@
+import io
 import json
 import re
 import statistics
+from collections import deque
 from typing import Dict, List, Tuple, Any
 
 # STATION_BLOCKS = {100, 101, 102, 103, 104}
@@ -65,16 +67,61 @@ def seconds_to_time_string(seconds: int) -> str:
     return f"{hours:02d}:{minutes:02d}:{secs:02d}"
 
 
+def zigzag(value: int) -> int:
+    return (value << 1) ^ (value >> 63)
+
+
+def varint(value: int) -> List[int]:
+    encoded = []
+    while value >= 0x80:
+        encoded.append((value & 0x7F) | 0x80)
+        value >>= 7
+    encoded.append(value)
+    return encoded
+
+
+def encode_entry(offset: int, block: int, previous: Tuple[int, int]) -> List[int]:
+    """Entry as its change from the one before it, see TimetableData in include/timetable.h"""
+    offset_change = zigzag(offset - previous[0]) << 3
+    block_change = block - previous[1]
+    if -2 <= block_change <= 2:
+        return varint(offset_change | (block_change + 2))
+    return varint(offset_change | 7) + varint(zigzag(block_change))
+
+
+def write_entries(output_file: Any, lines: List[Tuple[Any, str]]) -> Tuple[int, int]:
+    """Write the encoded entries with each one's value as a comment, returns (entries, bytes)"""
+    previous = (0, 0)
+    count = length = 0
+    for entry, comment in lines:
+        if entry is None:
+            output_file.write(f"\t//{comment}\n")
+            continue
+        encoded = encode_entry(entry[0], entry[1], previous)
+        previous = entry
+        count += 1
+        length += len(encoded)
+        output_file.write(
+            f"\t{', '.join(f'0x{byte:02x}' for byte in encoded)},  // {{ {entry[0]}, {entry[1]} }}{comment}\n"
+        )
+    return count, length
+
+
 def process_route_set(
-    set_name: str, config: Dict[str, Any], data: Dict[str, Any], output_file: Any
+    set_name: str,
+    config: Dict[str, Any],
+    data: Dict[str, Any],
+    output_file: Any,
+    block_sequences: List[List[int]],
 ) -> List[str]:
-    """Process a single route set and write to output file"""
+    """Process a single route set and write to output file, returns the route classes and (entries, bytes)"""
     filter_str: str = config["FILTER"]
     end_dwell: int = config["END_DWELL"]
     excluded_blocks: set[int] = config["EXCLUDED_BLOCKS"]
     color: Tuple[int, int, int] = config.get("COLOR", (255, 255, 255))
 
     route_classes: List[str] = []
+    total_entries = total_bytes = 0
 
     # Process each schedule that matches this filter
     for schedule_key, entry in data.items():
@@ -116,14 +163,12 @@ def process_route_set(
         else:
             end_time = end_dwell
 
-        # Write class definition
-        output_file.write(f"class {class_name} : public TrainRoute {{\n")
-        output_file.write("  public:\n")
-        output_file.write(
-            "	const std::vector<TimetableEntry>& getEntries() const override {\n"
-        )
-        output_file.write("		return timetable;\n")
-        output_file.write("	}\n\n")
+        # Entries to encode (offset, block) and excluded ones (None), each with a comment
+        lines: List[Tuple[Any, str]] = []
+
+        # The entries are written at namespace scope ahead of the class, so collect the class body first
+        class_file = output_file
+        output_file = io.StringIO()
 
         # output_file.write("	const char* getRouteName() const override {\n")
         # output_file.write(f'		return "{schedule_key}";\n')
@@ -156,20 +201,13 @@ def process_route_set(
         output_file.write("		return startTimes;\n")
         output_file.write("	}\n\n")
 
-        output_file.write("  private:\n")
-        output_file.write(
-            "	static const inline std::vector<TimetableEntry> timetable = {"
-        )
-
-        # Add comment with first start time
+        departure_comment = ""
         if start_times:
             first_time_str = seconds_to_time_string(int(start_times[0]))
-            output_file.write(f"  // First departure: {first_time_str}")
+            departure_comment = f"  // First departure: {first_time_str}"
             if len(start_times) > 1:
                 interval = int(start_times[1] - start_times[0])
-                output_file.write(f", interval ~{interval}s")
-
-        output_file.write("\n")
+                departure_comment += f", interval ~{interval}s"
 
         # Process averages to ensure strictly increasing times
         i = 0
@@ -188,7 +226,7 @@ def process_route_set(
                     exclude = True
 
             if block in excluded_blocks or exclude:
-                output_file.write(f"\t\t//{{ {int(avg)}, {block} }},\n")
+                lines.append((None, f"{{ {int(avg)}, {block} }},"))
                 averages.pop(i)
             elif tweak_time:
                 adjusted_avg = (
@@ -197,31 +235,159 @@ def process_route_set(
                     else prev_avg + 20
                 )
                 if adjusted_avg > prev_avg:
-                    output_file.write(
-                        f"\t\t{{ {int(adjusted_avg)}, {block} }}, // Was: {int(avg)}\n"
-                    )
+                    lines.append(((int(adjusted_avg), block), f" Was: {int(avg)}"))
                     averages[i] = (adjusted_avg, block)
                     i += 1
                 else:
-                    output_file.write(
-                        f"\t\t//{{ {int(avg)}, {block} }}, Failed to adjust: {int(adjusted_avg)}\n"
+                    lines.append(
+                        (None, f"{{ {int(avg)}, {block} }}, Failed to adjust: {int(adjusted_avg)}")
                     )
                     averages.pop(i)
             else:
-                output_file.write(f"\t\t{{ {int(avg)}, {block} }},\n")
+                lines.append(((int(avg), block), ""))
                 i += 1
 
         # Add end entry
-        output_file.write(f"		{{ {int(end_time)}, -1 }}\n")
+        lines.append(((int(end_time), -1), ""))
+        entries = [entry for entry, _ in lines if entry is not None]
+        block_sequences.append([block for _, block in entries if block >= 0])
 
-        output_file.write("	};\n")
+        output_file.write("	TimetableData getTimetable() const override {\n")
+        output_file.write(
+            f"		return {{ {class_name}_entries, sizeof({class_name}_entries), {len(entries)}, "
+            f"{entries[0][0]}, {entries[-1][0]} }};\n"
+        )
+        output_file.write("	}\n")
+        class_body = output_file.getvalue()
+        output_file = class_file
+
+        # Namespace scope, a static constexpr member would need a definition outside the class before C++17
+        output_file.write(f"static const uint8_t {class_name}_entries[] = {{{departure_comment}\n")
+        count, length = write_entries(output_file, lines)
+        total_entries += count
+        total_bytes += length
         output_file.write("};\n\n")
 
-    return route_classes
+        # Write class definition
+        output_file.write(f"class {class_name} : public TrainRoute {{\n")
+        output_file.write("  public:\n")
+        output_file.write(class_body)
+        output_file.write("};\n\n")
+
+    return route_classes, (total_entries, total_bytes)
+
+
+def build_track_graph(block_sequences: List[List[int]]) -> Dict[int, set]:
+    """Block adjacency from the routes' block sequences, without the shortcuts of routes that skip blocks"""
+    adjacency: Dict[int, set] = {}
+    for sequence in block_sequences:
+        for a, b in zip(sequence, sequence[1:]):
+            if a != b:
+                adjacency.setdefault(a, set()).add(b)
+                adjacency.setdefault(b, set()).add(a)
+
+    def connected_between(a: int, b: int) -> bool:
+        """Whether a reaches b through blocks numbered between them (blocks are numbered along the line)"""
+        low, high = min(a, b), max(a, b)
+        stack, seen = [a], {a}
+        while stack:
+            block = stack.pop()
+            for neighbour in adjacency[block]:
+                if neighbour == b and block != a:
+                    return True
+                if low < neighbour < high and neighbour not in seen:
+                    seen.add(neighbour)
+                    stack.append(neighbour)
+        return False
+
+    # Longest shortcuts first, one at a time so the graph stays connected
+    edges = sorted({(min(a, b), max(a, b)) for a in adjacency for b in adjacency[a]}, key=lambda e: e[0] - e[1])
+    for a, b in edges:
+        if connected_between(a, b):
+            adjacency[a].discard(b)
+            adjacency[b].discard(a)
+    return adjacency
+
+
+def write_track_graph(adjacency: Dict[int, set], output_file: str):
+    """Write the graph and the first step of the shortest path between every pair of blocks, see include/trackGraph.h"""
+    blocks = sorted(adjacency)
+    node = {block: index for index, block in enumerate(blocks)}
+    neighbours = [sorted(node[n] for n in adjacency[block]) for block in blocks]
+    if len(blocks) > 255 or max(len(n) for n in neighbours) > 15:
+        raise ValueError("Track graph too large for 8-bit nodes and 4-bit next hops")
+
+    # Breadth first from every target, the next hop of a node is its neighbour closest to the target (lowest on ties)
+    next_hops = []
+    for source in range(len(blocks)):
+        next_hops.append([0xF] * len(blocks))
+    for target in range(len(blocks)):
+        distance = {target: 0}
+        queue = deque([target])
+        while queue:
+            current = queue.popleft()
+            for neighbour in neighbours[current]:
+                if neighbour not in distance:
+                    distance[neighbour] = distance[current] + 1
+                    queue.append(neighbour)
+        for source in distance:
+            if source != target:
+                options = [i for i, n in enumerate(neighbours[source]) if distance.get(n, -1) == distance[source] - 1]
+                next_hops[source][target] = options[0]
+
+    first_block, last_block = blocks[0], blocks[-1]
+    row_bytes = (len(blocks) + 1) // 2
+    edges = sum(len(n) for n in neighbours) // 2
+    with open(output_file, "w") as f:
+        f.write("// Auto-generated by createHeaderFile.py\n")
+        f.write(f"// {len(blocks)} blocks, {edges} edges, next hops {len(blocks) * row_bytes} bytes\n")
+        f.write("const uint8_t trackGraphNodes[] = {  // Node of each block from the first, 0xFF = not on the graph\n")
+        for start in range(first_block, last_block + 1, 16):
+            row = [node.get(block, 0xFF) for block in range(start, min(start + 16, last_block + 1))]
+            f.write(f"\t{', '.join(str(n) for n in row)},\n")
+        f.write("};\n\n")
+
+        f.write("const uint16_t trackGraphBlocks[] = {\n")
+        for start in range(0, len(blocks), 16):
+            f.write(f"\t{', '.join(str(b) for b in blocks[start : start + 16])},\n")
+        f.write("};\n\n")
+
+        f.write("const uint16_t trackGraphEdgeStart[] = {\n")
+        starts = [0]
+        for n in neighbours:
+            starts.append(starts[-1] + len(n))
+        for start in range(0, len(starts), 16):
+            f.write(f"\t{', '.join(str(s) for s in starts[start : start + 16])},\n")
+        f.write("};\n\n")
+
+        f.write("const uint8_t trackGraphNeighbours[] = {\n")
+        for index, block in enumerate(blocks):
+            f.write(f"\t{''.join(f'{n}, ' for n in neighbours[index])} // {block}: {', '.join(str(blocks[n]) for n in neighbours[index])}\n")
+        f.write("};\n\n")
+
+        f.write("const uint8_t trackGraphNextHops[] = {  // Row per block, nibble per target (low first)\n")
+        for index, block in enumerate(blocks):
+            row = next_hops[index] + ([0xF] if len(blocks) % 2 else [])
+            packed = [row[i] | (row[i + 1] << 4) for i in range(0, len(row), 2)]
+            f.write(f"\t// {block}\n")
+            for start in range(0, len(packed), 16):
+                f.write(f"\t{', '.join(f'0x{b:02x}' for b in packed[start : start + 16])},\n")
+        f.write("};\n\n")
+
+        f.write("inline const TrackGraph& getTrackGraph() {\n")
+        f.write(
+            f"\tstatic const TrackGraph graph(\n\t\ttrackGraphNodes, {first_block}, {last_block - first_block + 1}, "
+            f"trackGraphBlocks, {len(blocks)}, trackGraphEdgeStart, trackGraphNeighbours, trackGraphNextHops);\n"
+        )
+        f.write("\treturn graph;\n")
+        f.write("}\n")
+    print(f"Generated {output_file}: {len(blocks)} blocks, {edges} edges, {len(blocks) * row_bytes} bytes of next hops")
 
 
 def generate_cpp_header(
-    filename: str = "block_schedules.json", output_file: str = f"{VERSION}_Timetable.h"
+    filename: str = "block_schedules.json",
+    output_file: str = f"{VERSION}_Timetable.h",
+    graph_file: str = f"{VERSION}_TrackGraph.h",
 ):
     """Generate C++ header file from block schedules JSON with multiple route sets"""
 
@@ -232,15 +398,19 @@ def generate_cpp_header(
     with open(output_file, "w") as f:
 
         all_route_classes = []
+        total_entries = total_bytes = 0
+        block_sequences: List[List[int]] = []
 
         f.write("// Auto-generated by createHeaderFile.py\n")
 
         # Process each route set
         for set_name, config in ROUTE_SETS.items():
             print(f"Processing {set_name} routes...")
-            route_classes = process_route_set(set_name, config, data, f)
+            route_classes, (entries, length) = process_route_set(set_name, config, data, f, block_sequences)
             all_route_classes.extend(route_classes)
-            print(f"  Generated {len(route_classes)} routes for {set_name}")
+            total_entries += entries
+            total_bytes += length
+            print(f"  Generated {len(route_classes)} routes for {set_name}, {entries} entries in {length} bytes")
 
         # Write getAllRoutes function
         f.write("// === Global List of Routes ===\n")
@@ -253,10 +423,18 @@ def generate_cpp_header(
         f.write("}\n\n")
 
     print(f"\nGenerated {output_file} with {len(all_route_classes)} total routes")
+    print(
+        f"Timetable entries: {total_bytes} bytes encoded, {total_entries * 4} bytes at a fixed 4 bytes each "
+        f"({total_entries * 4 / total_bytes:.2f}x)"
+    )
+
+    write_track_graph(build_track_graph(block_sequences), graph_file)
 
 
 if __name__ == "__main__":
     # Generate the header file
     generate_cpp_header(
-        "Timetable Generator/block_schedules.json", f"include/{VERSION}_Timetable.h"
+        "Timetable Generator/block_schedules.json",
+        f"include/{VERSION}_Timetable.h",
+        f"include/{VERSION}_TrackGraph.h",
     )
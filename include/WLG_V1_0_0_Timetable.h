@@ -1,10 +1,25 @@
 // Auto-generated by createHeaderFile.py
+static const uint8_t JVL__0_Schedule_0_entries[] = {  // First departure: 05:32:00, interval ~1800s
+	0xaf, 0x15, 0xc8, 0x01,  // { -171, 100 }
+	//{ -283, 101 },
+	//{ -247, 102 },
+	0xe7, 0x1f, 0x0a,  // { 83, 105 }
+	0xd7, 0x0d, 0x06,  // { 192, 108 }
+	0xb7, 0x01, 0x96, 0x01,  // { 203, 183 }
+	0x93, 0x0f,  // { 324, 184 }
+	0xb3, 0x07,  // { 383, 185 }
+	0xc3, 0x1c,  // { 611, 186 }
+	0x83, 0x17,  // { 795, 187 }
+	0xf3, 0x09,  // { 874, 188 }
+	0xb3, 0x0d,  // { 981, 189 }
+	0xa3, 0x0d,  // { 1087, 190 }
+	0xe3, 0x17,  // { 1277, 191 }
+	0xd3, 0x12,  // { 1426, 192 }
+	0xc7, 0x25, 0x81, 0x03,  // { 1726, -1 }
+};
+
 class JVL__0_Schedule_0 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(0, 191, 191);
 	}
@@ -18,33 +33,32 @@ class JVL__0_Schedule_0 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 05:32:00, interval ~1800s
-		{ -171, 100 },
-		//{ -283, 101 },
-		//{ -247, 102 },
-		{ 83, 105 },
-		{ 192, 108 },
-		{ 203, 183 },
-		{ 324, 184 },
-		{ 383, 185 },
-		{ 611, 186 },
-		{ 795, 187 },
-		{ 874, 188 },
-		{ 981, 189 },
-		{ 1087, 190 },
-		{ 1277, 191 },
-		{ 1426, 192 },
-		{ 1726, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { JVL__0_Schedule_0_entries, sizeof(JVL__0_Schedule_0_entries), 14, -171, 1726 };
+	}
+};
+
+static const uint8_t JVL__1_Schedule_0_entries[] = {  // First departure: 06:00:00, interval ~1800s
+	0x8f, 0x15, 0x80, 0x03,  // { -169, 192 }
+	0xa1, 0x20,  // { 89, 191 }
+	0xc1, 0x13,  // { 245, 190 }
+	0xa1, 0x17,  // { 431, 189 }
+	0xb1, 0x07,  // { 490, 188 }
+	0xf1, 0x0e,  // { 609, 187 }
+	0xc1, 0x0d,  // { 717, 186 }
+	0x91, 0x18,  // { 910, 185 }
+	0x91, 0x18,  // { 1103, 184 }
+	0xc1, 0x07,  // { 1163, 183 }
+	0xb7, 0x10, 0x95, 0x01,  // { 1294, 108 }
+	0xb7, 0x05, 0x05,  // { 1337, 105 }
+	//{ 1446, 102 },
+	//{ 1401, 101 },
+	0xc7, 0x0b, 0x09,  // { 1429, 100 }
+	0xc7, 0x25, 0xc9, 0x01,  // { 1729, -1 }
 };
 
 class JVL__1_Schedule_0 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(0, 191, 191);
 	}
@@ -58,33 +72,31 @@ class JVL__1_Schedule_0 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 06:00:00, interval ~1800s
-		{ -169, 192 },
-		{ 89, 191 },
-		{ 245, 190 },
-		{ 431, 189 },
-		{ 490, 188 },
-		{ 609, 187 },
-		{ 717, 186 },
-		{ 910, 185 },
-		{ 1103, 184 },
-		{ 1163, 183 },
-		{ 1294, 108 },
-		{ 1337, 105 },
-		//{ 1446, 102 },
-		//{ 1401, 101 },
-		{ 1429, 100 },
-		{ 1729, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { JVL__1_Schedule_0_entries, sizeof(JVL__1_Schedule_0_entries), 14, -169, 1729 };
+	}
+};
+
+static const uint8_t JVL__0_Schedule_1_entries[] = {  // First departure: 06:12:00
+	0xbf, 0x24, 0xc8, 0x01,  // { -292, 100 }
+	//{ -18, 101 },
+	0xe7, 0x2e, 0x0a,  // { 82, 105 }
+	0xd7, 0x0e, 0x06,  // { 199, 108 }
+	0x87, 0x01, 0x96, 0x01,  // { 207, 183 }
+	0xd3, 0x0e,  // { 324, 184 }
+	0x93, 0x13,  // { 477, 185 }
+	0x83, 0x1e,  // { 717, 186 }
+	0xb3, 0x0e,  // { 832, 187 }
+	0x83, 0x0f,  // { 952, 188 }
+	0xe3, 0x0d,  // { 1062, 189 }
+	0xe3, 0x0c,  // { 1164, 190 }
+	0xf3, 0x2c,  // { 1523, 191 }
+	0xf3, 0x12,  // { 1674, 192 }
+	0xc7, 0x25, 0x81, 0x03,  // { 1974, -1 }
 };
 
 class JVL__0_Schedule_1 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(0, 191, 191);
 	}
@@ -94,32 +106,31 @@ class JVL__0_Schedule_1 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 06:12:00
-		{ -292, 100 },
-		//{ -18, 101 },
-		{ 82, 105 },
-		{ 199, 108 },
-		{ 207, 183 },
-		{ 324, 184 },
-		{ 477, 185 },
-		{ 717, 186 },
-		{ 832, 187 },
-		{ 952, 188 },
-		{ 1062, 189 },
-		{ 1164, 190 },
-		{ 1523, 191 },
-		{ 1674, 192 },
-		{ 1974, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { JVL__0_Schedule_1_entries, sizeof(JVL__0_Schedule_1_entries), 14, -292, 1974 };
+	}
+};
+
+static const uint8_t JVL__0_Schedule_2_entries[] = {  // First departure: 06:42:00, interval ~900s
+	0x9f, 0x0e, 0xc8, 0x01,  // { -114, 100 }
+	//{ -200, 101 },
+	0xe7, 0x19, 0x0a,  // { 92, 105 }
+	0x97, 0x08, 0x06,  // { 157, 108 }
+	0xa7, 0x06, 0x96, 0x01,  // { 207, 183 }
+	0xb3, 0x0f,  // { 330, 184 }
+	0xf3, 0x14,  // { 497, 185 }
+	0xb3, 0x1e,  // { 740, 186 }
+	0x83, 0x27,  // { 1052, 187 }
+	0xd3, 0x0e,  // { 1169, 188 }
+	0xa3, 0x0e,  // { 1283, 189 }
+	0xc3, 0x0e,  // { 1399, 190 }
+	0x93, 0x16,  // { 1576, 191 }
+	0xf3, 0x0f,  // { 1703, 192 }
+	0xc7, 0x25, 0x81, 0x03,  // { 2003, -1 }
 };
 
 class JVL__0_Schedule_2 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(0, 191, 191);
 	}
@@ -129,32 +140,32 @@ class JVL__0_Schedule_2 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 06:42:00, interval ~900s
-		{ -114, 100 },
-		//{ -200, 101 },
-		{ 92, 105 },
-		{ 157, 108 },
-		{ 207, 183 },
-		{ 330, 184 },
-		{ 497, 185 },
-		{ 740, 186 },
-		{ 1052, 187 },
-		{ 1169, 188 },
-		{ 1283, 189 },
-		{ 1399, 190 },
-		{ 1576, 191 },
-		{ 1703, 192 },
-		{ 2003, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { JVL__0_Schedule_2_entries, sizeof(JVL__0_Schedule_2_entries), 14, -114, 2003 };
+	}
+};
+
+static const uint8_t JVL__1_Schedule_1_entries[] = {  // First departure: 15:30:00, interval ~1800s
+	0xbf, 0x0a, 0x80, 0x03,  // { -84, 192 }
+	0xa1, 0x17,  // { 102, 191 }
+	0xb1, 0x13,  // { 257, 190 }
+	0xb1, 0x1d,  // { 492, 189 }
+	0x91, 0x0d,  // { 597, 188 }
+	0xa1, 0x0c,  // { 695, 187 }
+	0xa1, 0x0d,  // { 801, 186 }
+	0xe1, 0x10,  // { 935, 185 }
+	0xe1, 0x26,  // { 1245, 184 }
+	0xa1, 0x1a,  // { 1455, 183 }
+	0xc7, 0x0e, 0x95, 0x01,  // { 1571, 108 }
+	0x87, 0x08, 0x05,  // { 1635, 105 }
+	//{ 1697, 102 },
+	//{ 1702, 101 },
+	0xd7, 0x07, 0x09,  // { 1696, 100 }
+	0xc7, 0x25, 0xc9, 0x01,  // { 1996, -1 }
 };
 
 class JVL__1_Schedule_1 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(0, 191, 191);
 	}
@@ -164,33 +175,77 @@ class JVL__1_Schedule_1 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 15:30:00, interval ~1800s
-		{ -84, 192 },
-		{ 102, 191 },
-		{ 257, 190 },
-		{ 492, 189 },
-		{ 597, 188 },
-		{ 695, 187 },
-		{ 801, 186 },
-		{ 935, 185 },
-		{ 1245, 184 },
-		{ 1455, 183 },
-		{ 1571, 108 },
-		{ 1635, 105 },
-		//{ 1697, 102 },
-		//{ 1702, 101 },
-		{ 1696, 100 },
-		{ 1996, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { JVL__1_Schedule_1_entries, sizeof(JVL__1_Schedule_1_entries), 14, -84, 1996 };
+	}
+};
+
+static const uint8_t HVL__0_Schedule_0_entries[] = {  // First departure: 05:50:00, interval ~1080s
+	//{ -223, 100 },
+	//{ -288, 101 },
+	0xcf, 0x24, 0xcc, 0x01,  // { -293, 102 }
+	//{ -287, 103 },
+	//{ -295, 104 },
+	0xb7, 0x31, 0x08,  // { 102, 106 }
+	//{ 130, 107 },
+	0xd7, 0x0b, 0x06,  // { 195, 109 }
+	0x43,  // { 199, 110 }
+	0xa4, 0x03,  // { 225, 112 }
+	0xd4, 0x03,  // { 254, 114 }
+	0x84, 0x04,  // { 286, 116 }
+	0xe3, 0x01,  // { 300, 117 }
+	0xc3, 0x07,  // { 360, 118 }
+	0x83, 0x04,  // { 392, 119 } Was: 360
+	0x83, 0x04,  // { 424, 120 }
+	0xa3, 0x03,  // { 450, 121 }
+	0xf3, 0x05,  // { 497, 122 }
+	0xa3, 0x08,  // { 563, 123 }
+	0xd3, 0x06,  // { 616, 124 }
+	0x83, 0x0d,  // { 720, 125 }
+	0xc3, 0x07,  // { 780, 126 }
+	0x83, 0x03,  // { 804, 127 }
+	0xc3, 0x06,  // { 856, 128 }
+	0x83, 0x08,  // { 920, 129 }
+	0x93, 0x03,  // { 945, 130 }
+	0xb3, 0x04,  // { 980, 131 }
+	0xd3, 0x07,  // { 1041, 132 }
+	0xc3, 0x0b,  // { 1133, 133 }
+	0x83, 0x05,  // { 1173, 134 }
+	0xc3, 0x07,  // { 1233, 135 }
+	0x83, 0x07,  // { 1289, 136 }
+	0xf3, 0x08,  // { 1360, 137 }
+	0xd3, 0x06,  // { 1413, 138 }
+	0xa3, 0x05,  // { 1455, 139 }
+	0xc3, 0x06,  // { 1507, 140 }
+	0x83, 0x07,  // { 1563, 141 }
+	0xf3, 0x08,  // { 1634, 142 }
+	0xa3, 0x06,  // { 1684, 143 }
+	0xe3, 0x08,  // { 1754, 144 }
+	0xf3, 0x07,  // { 1817, 145 }
+	0xb3, 0x08,  // { 1884, 146 }
+	0xd3, 0x05,  // { 1929, 147 }
+	0xd3, 0x08,  // { 1998, 148 }
+	0x83, 0x0c,  // { 2094, 149 }
+	0xd3, 0x03,  // { 2123, 150 }
+	0xe3, 0x0b,  // { 2217, 151 }
+	0xb3, 0x08,  // { 2284, 152 }
+	0xe3, 0x07,  // { 2346, 153 }
+	0xf3, 0x06,  // { 2401, 154 }
+	0xe3, 0x09,  // { 2479, 155 }
+	0x93, 0x0d,  // { 2584, 156 }
+	0x83, 0x05,  // { 2624, 157 }
+	0x93, 0x06,  // { 2673, 158 }
+	0x93, 0x06,  // { 2722, 159 }
+	0xe3, 0x06,  // { 2776, 160 }
+	0xc3, 0x07,  // { 2836, 161 }
+	//{ 2824, 162 },
+	//{ 2132, 229 },
+	//{ 2182, 230 },
+	0xc7, 0x07, 0xc3, 0x02,  // { 2896, -1 }
 };
 
 class HVL__0_Schedule_0 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(255, 96, 0);
 	}
@@ -205,78 +260,74 @@ class HVL__0_Schedule_0 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 05:50:00, interval ~1080s
-		//{ -223, 100 },
-		//{ -288, 101 },
-		{ -293, 102 },
-		//{ -287, 103 },
-		//{ -295, 104 },
-		{ 102, 106 },
-		//{ 130, 107 },
-		{ 195, 109 },
-		{ 199, 110 },
-		{ 225, 112 },
-		{ 254, 114 },
-		{ 286, 116 },
-		{ 300, 117 },
-		{ 360, 118 },
-		{ 392, 119 }, // Was: 360
-		{ 424, 120 },
-		{ 450, 121 },
-		{ 497, 122 },
-		{ 563, 123 },
-		{ 616, 124 },
-		{ 720, 125 },
-		{ 780, 126 },
-		{ 804, 127 },
-		{ 856, 128 },
-		{ 920, 129 },
-		{ 945, 130 },
-		{ 980, 131 },
-		{ 1041, 132 },
-		{ 1133, 133 },
-		{ 1173, 134 },
-		{ 1233, 135 },
-		{ 1289, 136 },
-		{ 1360, 137 },
-		{ 1413, 138 },
-		{ 1455, 139 },
-		{ 1507, 140 },
-		{ 1563, 141 },
-		{ 1634, 142 },
-		{ 1684, 143 },
-		{ 1754, 144 },
-		{ 1817, 145 },
-		{ 1884, 146 },
-		{ 1929, 147 },
-		{ 1998, 148 },
-		{ 2094, 149 },
-		{ 2123, 150 },
-		{ 2217, 151 },
-		{ 2284, 152 },
-		{ 2346, 153 },
-		{ 2401, 154 },
-		{ 2479, 155 },
-		{ 2584, 156 },
-		{ 2624, 157 },
-		{ 2673, 158 },
-		{ 2722, 159 },
-		{ 2776, 160 },
-		{ 2836, 161 },
-		//{ 2824, 162 },
-		//{ 2132, 229 },
-		//{ 2182, 230 },
-		{ 2896, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { HVL__0_Schedule_0_entries, sizeof(HVL__0_Schedule_0_entries), 53, -293, 2896 };
+	}
+};
+
+static const uint8_t HVL__1_Schedule_0_entries[] = {  // First departure: 04:30:00, interval ~3600s
+	//{ -240, 162 },
+	0xe7, 0x01, 0xc2, 0x02,  // { 14, 161 }
+	0x81, 0x0c,  // { 110, 160 }
+	0xa1, 0x0b,  // { 200, 159 }
+	0xe1, 0x01,  // { 214, 158 }
+	0xc1, 0x04,  // { 250, 157 }
+	0xe1, 0x0a,  // { 336, 156 }
+	0xf1, 0x09,  // { 415, 155 }
+	0xf1, 0x04,  // { 454, 154 }
+	0xd1, 0x04,  // { 491, 153 }
+	0xa1, 0x0c,  // { 589, 152 }
+	0xd1, 0x07,  // { 650, 151 }
+	0xe1, 0x08,  // { 720, 150 }
+	0xf1, 0x0a,  // { 807, 149 }
+	0xc1, 0x02,  // { 827, 148 }
+	0xf1, 0x0e,  // { 946, 147 }
+	0x91, 0x01,  // { 955, 146 }
+	0xd1, 0x0d,  // { 1064, 145 }
+	0xc1, 0x09,  // { 1140, 144 }
+	0x81, 0x05,  // { 1180, 143 }
+	0xe1, 0x03,  // { 1210, 142 }
+	0xe1, 0x0b,  // { 1304, 141 }
+	0xa1, 0x03,  // { 1330, 140 }
+	0xe1, 0x0b,  // { 1424, 139 }
+	0xc1, 0x01,  // { 1436, 138 }
+	0x81, 0x0a,  // { 1516, 137 }
+	0xc1, 0x02,  // { 1536, 136 }
+	0x81, 0x0d,  // { 1640, 135 }
+	0xc1, 0x05,  // { 1684, 134 }
+	0xd1, 0x09,  // { 1761, 133 }
+	0xa1, 0x04,  // { 1795, 132 }
+	0xe1, 0x0a,  // { 1881, 131 }
+	0x91, 0x03,  // { 1906, 130 }
+	0x81, 0x03,  // { 1930, 129 }
+	0xe1, 0x0d,  // { 2040, 128 }
+	0x81, 0x01,  // { 2048, 127 } Was: 2039
+	0x91, 0x01,  // { 2057, 126 }
+	0xd1, 0x0b,  // { 2150, 125 }
+	0x81, 0x02,  // { 2166, 124 }
+	0xc1, 0x0e,  // { 2282, 123 }
+	0xb1, 0x06,  // { 2333, 122 } Was: 2281
+	0xc1, 0x06,  // { 2385, 121 }
+	0xa1, 0x01,  // { 2395, 120 }
+	0xa1, 0x0b,  // { 2485, 119 }
+	0x91, 0x02,  // { 2502, 118 } Was: 2484
+	0x91, 0x02,  // { 2519, 117 }
+	0x71,  // { 2526, 116 }
+	0xe0, 0x01,  // { 2540, 114 }
+	0x80, 0x09,  // { 2612, 112 }
+	0xc0, 0x01,  // { 2624, 110 }
+	0xd1, 0x02,  // { 2645, 109 }
+	//{ 2769, 107 },
+	0xf7, 0x09, 0x05,  // { 2724, 106 }
+	//{ 2836, 104 },
+	//{ 2837, 103 },
+	0x87, 0x06, 0x07,  // { 2772, 102 }
+	//{ 2830, 101 },
+	0xc7, 0x07, 0xcd, 0x01,  // { 2832, -1 }
 };
 
 class HVL__1_Schedule_0 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(255, 96, 0);
 	}
@@ -291,75 +342,69 @@ class HVL__1_Schedule_0 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 04:30:00, interval ~3600s
-		//{ -240, 162 },
-		{ 14, 161 },
-		{ 110, 160 },
-		{ 200, 159 },
-		{ 214, 158 },
-		{ 250, 157 },
-		{ 336, 156 },
-		{ 415, 155 },
-		{ 454, 154 },
-		{ 491, 153 },
-		{ 589, 152 },
-		{ 650, 151 },
-		{ 720, 150 },
-		{ 807, 149 },
-		{ 827, 148 },
-		{ 946, 147 },
-		{ 955, 146 },
-		{ 1064, 145 },
-		{ 1140, 144 },
-		{ 1180, 143 },
-		{ 1210, 142 },
-		{ 1304, 141 },
-		{ 1330, 140 },
-		{ 1424, 139 },
-		{ 1436, 138 },
-		{ 1516, 137 },
-		{ 1536, 136 },
-		{ 1640, 135 },
-		{ 1684, 134 },
-		{ 1761, 133 },
-		{ 1795, 132 },
-		{ 1881, 131 },
-		{ 1906, 130 },
-		{ 1930, 129 },
-		{ 2040, 128 },
-		{ 2048, 127 }, // Was: 2039
-		{ 2057, 126 },
-		{ 2150, 125 },
-		{ 2166, 124 },
-		{ 2282, 123 },
-		{ 2333, 122 }, // Was: 2281
-		{ 2385, 121 },
-		{ 2395, 120 },
-		{ 2485, 119 },
-		{ 2502, 118 }, // Was: 2484
-		{ 2519, 117 },
-		{ 2526, 116 },
-		{ 2540, 114 },
-		{ 2612, 112 },
-		{ 2624, 110 },
-		{ 2645, 109 },
-		//{ 2769, 107 },
-		{ 2724, 106 },
-		//{ 2836, 104 },
-		//{ 2837, 103 },
-		{ 2772, 102 },
-		//{ 2830, 101 },
-		{ 2832, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { HVL__1_Schedule_0_entries, sizeof(HVL__1_Schedule_0_entries), 53, 14, 2832 };
+	}
+};
+
+static const uint8_t HVL__1_Schedule_1_entries[] = {  // First departure: 06:00:00, interval ~1200s
+	//{ -288, 162 },
+	0x8f, 0x06, 0xc2, 0x02,  // { -49, 161 }
+	0x81, 0x13,  // { 103, 160 }
+	0xa1, 0x0c,  // { 201, 159 }
+	0xe1, 0x01,  // { 215, 158 }
+	0xc1, 0x09,  // { 291, 157 }
+	0xb1, 0x07,  // { 350, 156 }
+	0xa1, 0x0b,  // { 440, 155 }
+	0xe1, 0x02,  // { 462, 154 }
+	0xf1, 0x0b,  // { 557, 153 }
+	0xe1, 0x04,  // { 595, 152 }
+	0xf1, 0x0a,  // { 682, 151 }
+	0x81, 0x05,  // { 722, 150 }
+	0xb1, 0x0d,  // { 829, 149 }
+	0x81, 0x03,  // { 853, 148 }
+	0xb1, 0x0c,  // { 952, 147 }
+	0xf1, 0x0a,  // { 1039, 146 }
+	0x91, 0x04,  // { 1072, 145 }
+	0xf1, 0x0a,  // { 1159, 144 }
+	0xc1, 0x02,  // { 1179, 143 } Was: 1131
+	0xc1, 0x02,  // { 1199, 142 }
+	0xc0, 0x07,  // { 1259, 140 }
+	0xa1, 0x07,  // { 1317, 139 }
+	0xf0, 0x01,  // { 1332, 137 }
+	0xc1, 0x09,  // { 1408, 136 }
+	0xd1, 0x05,  // { 1453, 135 }
+	0xa1, 0x0a,  // { 1535, 134 }
+	0x81, 0x01,  // { 1543, 133 }
+	0x91, 0x04,  // { 1576, 132 }
+	0xe1, 0x03,  // { 1606, 131 }
+	0xd1, 0x05,  // { 1651, 130 }
+	0xf1, 0x03,  // { 1682, 129 }
+	0x91, 0x07,  // { 1739, 128 }
+	0xc1, 0x02,  // { 1759, 127 } Was: 1679
+	0xd1, 0x02,  // { 1780, 126 } Was: 1695
+	0xe1, 0x02,  // { 1802, 125 }
+	0x91, 0x0b,  // { 1891, 124 }
+	0xe1, 0x04,  // { 1929, 123 }
+	0xc1, 0x06,  // { 1981, 122 } Was: 1929
+	0xd1, 0x06,  // { 2034, 121 }
+	0xd1, 0x01,  // { 2047, 120 }
+	0xc1, 0x02,  // { 2067, 119 } Was: 2045
+	0xd1, 0x02,  // { 2088, 118 }
+	0xd1, 0x01,  // { 2101, 117 }
+	0xa1, 0x16,  // { 2279, 116 }
+	0xc0, 0x02,  // { 2299, 114 } Was: 2157
+	0xc0, 0x02,  // { 2319, 112 } Was: 2259
+	0xc0, 0x02,  // { 2339, 110 } Was: 2276
+	0xa1, 0x01,  // { 2349, 109 } Was: 2267
+	//{ 2360, 107 },
+	0xa7, 0x02, 0x05,  // { 2367, 106 }
+	//{ 2379, 101 },
+	0xc7, 0x07, 0xd5, 0x01,  // { 2427, -1 }
 };
 
 class HVL__1_Schedule_1 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(255, 96, 0);
 	}
@@ -369,70 +414,57 @@ class HVL__1_Schedule_1 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 06:00:00, interval ~1200s
-		//{ -288, 162 },
-		{ -49, 161 },
-		{ 103, 160 },
-		{ 201, 159 },
-		{ 215, 158 },
-		{ 291, 157 },
-		{ 350, 156 },
-		{ 440, 155 },
-		{ 462, 154 },
-		{ 557, 153 },
-		{ 595, 152 },
-		{ 682, 151 },
-		{ 722, 150 },
-		{ 829, 149 },
-		{ 853, 148 },
-		{ 952, 147 },
-		{ 1039, 146 },
-		{ 1072, 145 },
-		{ 1159, 144 },
-		{ 1179, 143 }, // Was: 1131
-		{ 1199, 142 },
-		{ 1259, 140 },
-		{ 1317, 139 },
-		{ 1332, 137 },
-		{ 1408, 136 },
-		{ 1453, 135 },
-		{ 1535, 134 },
-		{ 1543, 133 },
-		{ 1576, 132 },
-		{ 1606, 131 },
-		{ 1651, 130 },
-		{ 1682, 129 },
-		{ 1739, 128 },
-		{ 1759, 127 }, // Was: 1679
-		{ 1780, 126 }, // Was: 1695
-		{ 1802, 125 },
-		{ 1891, 124 },
-		{ 1929, 123 },
-		{ 1981, 122 }, // Was: 1929
-		{ 2034, 121 },
-		{ 2047, 120 },
-		{ 2067, 119 }, // Was: 2045
-		{ 2088, 118 },
-		{ 2101, 117 },
-		{ 2279, 116 },
-		{ 2299, 114 }, // Was: 2157
-		{ 2319, 112 }, // Was: 2259
-		{ 2339, 110 }, // Was: 2276
-		{ 2349, 109 }, // Was: 2267
-		//{ 2360, 107 },
-		{ 2367, 106 },
-		//{ 2379, 101 },
-		{ 2427, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { HVL__1_Schedule_1_entries, sizeof(HVL__1_Schedule_1_entries), 50, -49, 2427 };
+	}
+};
+
+static const uint8_t HVL__1_Schedule_2_entries[] = {  // First departure: 06:20:00, interval ~1200s
+	0xcf, 0x24, 0xa2, 0x02,  // { -293, 145 }
+	0x91, 0x2f,  // { 84, 144 }
+	0xa1, 0x0e,  // { 198, 143 }
+	0xb1, 0x02,  // { 217, 142 }
+	0xa1, 0x0c,  // { 315, 141 }
+	0xf1, 0x03,  // { 346, 140 }
+	0xb1, 0x06,  // { 397, 139 }
+	0x91, 0x0a,  // { 478, 138 }
+	0xb1, 0x06,  // { 529, 137 }
+	0xe1, 0x04,  // { 567, 136 }
+	0xe1, 0x0d,  // { 677, 135 }
+	0xa1, 0x06,  // { 727, 134 }
+	0xf1, 0x08,  // { 798, 133 }
+	0xf1, 0x04,  // { 837, 132 }
+	0xd1, 0x09,  // { 914, 131 }
+	0xe1, 0x04,  // { 952, 130 }
+	0xd1, 0x0a,  // { 1037, 129 }
+	0xa1, 0x02,  // { 1055, 128 } Was: 1009
+	0xb1, 0x02,  // { 1074, 127 }
+	0x21,  // { 1076, 126 }
+	0x91, 0x06,  // { 1125, 125 }
+	0x81, 0x18,  // { 1317, 124 }
+	0x71,  // { 1324, 123 } Was: 1204
+	0x81, 0x01,  // { 1332, 122 }
+	0xd1, 0x08,  // { 1401, 121 }
+	0x61,  // { 1407, 120 } Was: 1329
+	0x61,  // { 1413, 119 }
+	0xd1, 0x0a,  // { 1498, 118 }
+	0xc1, 0x02,  // { 1518, 117 } Was: 1494
+	0xc1, 0x02,  // { 1538, 116 } Was: 1444
+	0x80, 0x04,  // { 1570, 114 } Was: 1506
+	0x90, 0x04,  // { 1603, 112 }
+	0x80, 0x05,  // { 1643, 110 }
+	0x51,  // { 1648, 109 }
+	//{ 1776, 107 },
+	0xa7, 0x04, 0x05,  // { 1682, 106 }
+	//{ 1726, 104 },
+	//{ 1763, 103 },
+	0xf7, 0x0f, 0x07,  // { 1809, 102 }
+	//{ 1814, 101 },
+	0xc7, 0x07, 0xcd, 0x01,  // { 1869, -1 }
 };
 
 class HVL__1_Schedule_2 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(255, 96, 0);
 	}
@@ -442,58 +474,71 @@ class HVL__1_Schedule_2 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 06:20:00, interval ~1200s
-		{ -293, 145 },
-		{ 84, 144 },
-		{ 198, 143 },
-		{ 217, 142 },
-		{ 315, 141 },
-		{ 346, 140 },
-		{ 397, 139 },
-		{ 478, 138 },
-		{ 529, 137 },
-		{ 567, 136 },
-		{ 677, 135 },
-		{ 727, 134 },
-		{ 798, 133 },
-		{ 837, 132 },
-		{ 914, 131 },
-		{ 952, 130 },
-		{ 1037, 129 },
-		{ 1055, 128 }, // Was: 1009
-		{ 1074, 127 },
-		{ 1076, 126 },
-		{ 1125, 125 },
-		{ 1317, 124 },
-		{ 1324, 123 }, // Was: 1204
-		{ 1332, 122 },
-		{ 1401, 121 },
-		{ 1407, 120 }, // Was: 1329
-		{ 1413, 119 },
-		{ 1498, 118 },
-		{ 1518, 117 }, // Was: 1494
-		{ 1538, 116 }, // Was: 1444
-		{ 1570, 114 }, // Was: 1506
-		{ 1603, 112 },
-		{ 1643, 110 },
-		{ 1648, 109 },
-		//{ 1776, 107 },
-		{ 1682, 106 },
-		//{ 1726, 104 },
-		//{ 1763, 103 },
-		{ 1809, 102 },
-		//{ 1814, 101 },
-		{ 1869, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { HVL__1_Schedule_2_entries, sizeof(HVL__1_Schedule_2_entries), 37, -293, 1869 };
+	}
+};
+
+static const uint8_t HVL__1_Schedule_3_entries[] = {  // First departure: 07:00:00, interval ~2400s
+	//{ -41, 162 },
+	0x8f, 0x13, 0xc2, 0x02,  // { -153, 161 }
+	0xd1, 0x20,  // { 108, 160 }
+	0xb1, 0x0b,  // { 199, 159 }
+	0xc1, 0x02,  // { 219, 158 }
+	0x81, 0x03,  // { 243, 157 }
+	0x81, 0x0d,  // { 347, 156 }
+	0xb1, 0x0a,  // { 430, 155 }
+	0x81, 0x06,  // { 478, 154 }
+	0xa1, 0x0a,  // { 560, 153 }
+	0xb1, 0x0a,  // { 643, 152 }
+	0xc1, 0x05,  // { 687, 151 }
+	0xe1, 0x12,  // { 837, 150 }
+	0xb1, 0x05,  // { 880, 149 } Was: 837
+	0xb1, 0x05,  // { 923, 148 }
+	0xe1, 0x04,  // { 961, 147 }
+	0xa1, 0x0a,  // { 1043, 146 }
+	0x81, 0x0a,  // { 1123, 145 }
+	0x81, 0x05,  // { 1163, 144 }
+	0xe1, 0x26,  // { 1473, 143 }
+	0xc1, 0x02,  // { 1493, 142 } Was: 1210
+	0xc0, 0x02,  // { 1513, 140 } Was: 1319
+	0xc1, 0x02,  // { 1533, 139 } Was: 1323
+	0xc1, 0x02,  // { 1553, 138 } Was: 1324
+	0xc1, 0x02,  // { 1573, 137 } Was: 1437
+	0xc1, 0x02,  // { 1593, 136 } Was: 1438
+	0xc1, 0x02,  // { 1613, 135 } Was: 1519
+	0xc1, 0x01,  // { 1625, 134 } Was: 1524
+	0xd1, 0x01,  // { 1638, 133 }
+	0x91, 0x03,  // { 1663, 132 }
+	0x41,  // { 1667, 131 } Was: 1606
+	0x51,  // { 1672, 130 }
+	0xf1, 0x0a,  // { 1759, 129 }
+	0xe1, 0x04,  // { 1797, 128 }
+	0xb1, 0x01,  // { 1808, 127 }
+	0x31,  // { 1811, 126 } Was: 1803
+	0x31,  // { 1814, 125 }
+	0xa1, 0x0d,  // { 1920, 124 }
+	0xc1, 0x16,  // { 2100, 123 }
+	0xc1, 0x02,  // { 2120, 122 } Was: 2037
+	0xa1, 0x01,  // { 2130, 121 } Was: 2081
+	0xa1, 0x01,  // { 2140, 120 }
+	0x31,  // { 2143, 119 }
+	0x71,  // { 2150, 118 } Was: 2044
+	0x81, 0x01,  // { 2158, 117 }
+	0xd1, 0x0d,  // { 2267, 116 }
+	0xc0, 0x01,  // { 2279, 114 }
+	0x80, 0x01,  // { 2287, 112 }
+	0xe0, 0x03,  // { 2317, 110 }
+	0x81, 0x07,  // { 2373, 109 }
+	//{ 2602, 107 },
+	0xe7, 0x07, 0x05,  // { 2435, 106 }
+	//{ 2470, 103 },
+	//{ 2530, 101 },
+	0xc7, 0x07, 0xd5, 0x01,  // { 2495, -1 }
 };
 
 class HVL__1_Schedule_3 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(255, 96, 0);
 	}
@@ -503,72 +548,73 @@ class HVL__1_Schedule_3 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 07:00:00, interval ~2400s
-		//{ -41, 162 },
-		{ -153, 161 },
-		{ 108, 160 },
-		{ 199, 159 },
-		{ 219, 158 },
-		{ 243, 157 },
-		{ 347, 156 },
-		{ 430, 155 },
-		{ 478, 154 },
-		{ 560, 153 },
-		{ 643, 152 },
-		{ 687, 151 },
-		{ 837, 150 },
-		{ 880, 149 }, // Was: 837
-		{ 923, 148 },
-		{ 961, 147 },
-		{ 1043, 146 },
-		{ 1123, 145 },
-		{ 1163, 144 },
-		{ 1473, 143 },
-		{ 1493, 142 }, // Was: 1210
-		{ 1513, 140 }, // Was: 1319
-		{ 1533, 139 }, // Was: 1323
-		{ 1553, 138 }, // Was: 1324
-		{ 1573, 137 }, // Was: 1437
-		{ 1593, 136 }, // Was: 1438
-		{ 1613, 135 }, // Was: 1519
-		{ 1625, 134 }, // Was: 1524
-		{ 1638, 133 },
-		{ 1663, 132 },
-		{ 1667, 131 }, // Was: 1606
-		{ 1672, 130 },
-		{ 1759, 129 },
-		{ 1797, 128 },
-		{ 1808, 127 },
-		{ 1811, 126 }, // Was: 1803
-		{ 1814, 125 },
-		{ 1920, 124 },
-		{ 2100, 123 },
-		{ 2120, 122 }, // Was: 2037
-		{ 2130, 121 }, // Was: 2081
-		{ 2140, 120 },
-		{ 2143, 119 },
-		{ 2150, 118 }, // Was: 2044
-		{ 2158, 117 },
-		{ 2267, 116 },
-		{ 2279, 114 },
-		{ 2287, 112 },
-		{ 2317, 110 },
-		{ 2373, 109 },
-		//{ 2602, 107 },
-		{ 2435, 106 },
-		//{ 2470, 103 },
-		//{ 2530, 101 },
-		{ 2495, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { HVL__1_Schedule_3_entries, sizeof(HVL__1_Schedule_3_entries), 51, -153, 2495 };
+	}
+};
+
+static const uint8_t HVL__0_Schedule_1_entries[] = {  // First departure: 15:18:00, interval ~1080s
+	//{ -290, 101 },
+	0x8f, 0x21, 0xcc, 0x01,  // { -265, 102 }
+	//{ -177, 103 },
+	0x87, 0x32, 0x08,  // { 135, 106 }
+	//{ 114, 107 },
+	0x97, 0x05, 0x06,  // { 176, 109 }
+	0xf3, 0x02,  // { 199, 110 }
+	0xd4, 0x05,  // { 244, 112 }
+	0xd4, 0x02,  // { 265, 114 }
+	0xd4, 0x01,  // { 278, 116 }
+	0xa3, 0x02,  // { 296, 117 }
+	0xc3, 0x07,  // { 356, 118 }
+	0xa3, 0x01,  // { 366, 119 }
+	0xf3, 0x03,  // { 397, 120 }
+	0xf3, 0x02,  // { 420, 121 }
+	0xa3, 0x01,  // { 430, 122 }
+	0xe3, 0x08,  // { 500, 123 }
+	0xe3, 0x06,  // { 554, 124 }
+	0xe3, 0x0c,  // { 656, 125 }
+	0x83, 0x08,  // { 720, 126 }
+	0x63,  // { 726, 127 }
+	0x13,  // { 727, 128 }
+	0xe3, 0x06,  // { 781, 129 }
+	0xa3, 0x01,  // { 791, 130 }
+	0xf3, 0x06,  // { 846, 131 }
+	0xb3, 0x05,  // { 889, 132 }
+	0xf3, 0x0a,  // { 976, 133 }
+	0x93, 0x03,  // { 1001, 134 }
+	0xc3, 0x02,  // { 1021, 135 }
+	0xb3, 0x09,  // { 1096, 136 }
+	0xe3, 0x06,  // { 1150, 137 }
+	0xb3, 0x01,  // { 1161, 138 }
+	0x93, 0x03,  // { 1186, 139 }
+	0xb3, 0x09,  // { 1261, 140 }
+	0xd3, 0x03,  // { 1290, 141 } Was: 1259
+	0xd3, 0x03,  // { 1319, 142 }
+	0xb3, 0x08,  // { 1386, 143 }
+	0xe3, 0x01,  // { 1400, 144 }
+	0xe3, 0x10,  // { 1534, 145 }
+	0xe3, 0x05,  // { 1580, 146 }
+	0x83, 0x0c,  // { 1676, 147 }
+	0x83, 0x08,  // { 1740, 148 }
+	0x83, 0x0d,  // { 1844, 149 }
+	0xf3, 0x03,  // { 1875, 150 }
+	0x93, 0x0d,  // { 1980, 151 }
+	0xe3, 0x06,  // { 2034, 152 }
+	0xd3, 0x07,  // { 2095, 153 }
+	0xa3, 0x09,  // { 2169, 154 }
+	0x93, 0x07,  // { 2226, 155 }
+	0xb3, 0x0c,  // { 2325, 156 }
+	0xa3, 0x02,  // { 2343, 157 }
+	0xf3, 0x07,  // { 2406, 158 }
+	0x83, 0x09,  // { 2478, 159 }
+	0xc3, 0x06,  // { 2530, 160 }
+	0xc3, 0x1e,  // { 2774, 161 }
+	//{ 2550, 162 },
+	0xc7, 0x07, 0xc3, 0x02,  // { 2834, -1 }
 };
 
 class HVL__0_Schedule_1 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(255, 96, 0);
 	}
@@ -578,74 +624,56 @@ class HVL__0_Schedule_1 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 15:18:00, interval ~1080s
-		//{ -290, 101 },
-		{ -265, 102 },
-		//{ -177, 103 },
-		{ 135, 106 },
-		//{ 114, 107 },
-		{ 176, 109 },
-		{ 199, 110 },
-		{ 244, 112 },
-		{ 265, 114 },
-		{ 278, 116 },
-		{ 296, 117 },
-		{ 356, 118 },
-		{ 366, 119 },
-		{ 397, 120 },
-		{ 420, 121 },
-		{ 430, 122 },
-		{ 500, 123 },
-		{ 554, 124 },
-		{ 656, 125 },
-		{ 720, 126 },
-		{ 726, 127 },
-		{ 727, 128 },
-		{ 781, 129 },
-		{ 791, 130 },
-		{ 846, 131 },
-		{ 889, 132 },
-		{ 976, 133 },
-		{ 1001, 134 },
-		{ 1021, 135 },
-		{ 1096, 136 },
-		{ 1150, 137 },
-		{ 1161, 138 },
-		{ 1186, 139 },
-		{ 1261, 140 },
-		{ 1290, 141 }, // Was: 1259
-		{ 1319, 142 },
-		{ 1386, 143 },
-		{ 1400, 144 },
-		{ 1534, 145 },
-		{ 1580, 146 },
-		{ 1676, 147 },
-		{ 1740, 148 },
-		{ 1844, 149 },
-		{ 1875, 150 },
-		{ 1980, 151 },
-		{ 2034, 152 },
-		{ 2095, 153 },
-		{ 2169, 154 },
-		{ 2226, 155 },
-		{ 2325, 156 },
-		{ 2343, 157 },
-		{ 2406, 158 },
-		{ 2478, 159 },
-		{ 2530, 160 },
-		{ 2774, 161 },
-		//{ 2550, 162 },
-		{ 2834, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { HVL__0_Schedule_1_entries, sizeof(HVL__0_Schedule_1_entries), 53, -265, 2834 };
+	}
+};
+
+static const uint8_t HVL__0_Schedule_2_entries[] = {  // First departure: 15:29:00, interval ~1200s
+	//{ -294, 101 },
+	0xef, 0x1f, 0xcc, 0x01,  // { -255, 102 }
+	//{ -75, 103 },
+	//{ -295, 104 },
+	0x97, 0x31, 0x08,  // { 138, 106 }
+	//{ 148, 107 },
+	0xc7, 0x03, 0x06,  // { 166, 109 }
+	0xc3, 0x0b,  // { 258, 110 }
+	0x34,  // { 261, 112 }
+	0x84, 0x01,  // { 269, 114 }
+	0xa4, 0x02,  // { 287, 116 }
+	0xc3, 0x01,  // { 299, 117 }
+	0x83, 0x18,  // { 491, 118 }
+	0xc3, 0x02,  // { 511, 119 } Was: 418
+	0xc3, 0x02,  // { 531, 120 } Was: 431
+	0xc3, 0x02,  // { 551, 121 } Was: 419
+	0xc3, 0x02,  // { 571, 122 } Was: 481
+	0xe3, 0x02,  // { 593, 123 } Was: 529
+	0xf3, 0x02,  // { 616, 124 }
+	0xd3, 0x05,  // { 661, 125 }
+	0xb3, 0x0e,  // { 776, 126 }
+	0x83, 0x05,  // { 816, 127 } Was: 775
+	0x83, 0x05,  // { 856, 128 }
+	0x43,  // { 860, 129 }
+	0x93, 0x05,  // { 901, 130 }
+	0xb3, 0x09,  // { 976, 131 }
+	0x83, 0x05,  // { 1016, 132 }
+	0xa3, 0x0b,  // { 1106, 133 }
+	0xf3, 0x04,  // { 1145, 134 }
+	0xa3, 0x09,  // { 1219, 135 }
+	0xa3, 0x06,  // { 1269, 136 }
+	0xf3, 0x08,  // { 1340, 137 }
+	0xd3, 0x0a,  // { 1425, 138 }
+	0xf3, 0x03,  // { 1456, 139 }
+	0xc3, 0x05,  // { 1500, 140 }
+	0x83, 0x0a,  // { 1580, 141 }
+	0xe3, 0x02,  // { 1602, 142 }
+	0xa3, 0x0c,  // { 1700, 143 }
+	0xb3, 0x02,  // { 1719, 144 }
+	0xc7, 0x07, 0xa1, 0x02,  // { 1779, -1 }
 };
 
 class HVL__0_Schedule_2 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(255, 96, 0);
 	}
@@ -655,57 +683,53 @@ class HVL__0_Schedule_2 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 15:29:00, interval ~1200s
-		//{ -294, 101 },
-		{ -255, 102 },
-		//{ -75, 103 },
-		//{ -295, 104 },
-		{ 138, 106 },
-		//{ 148, 107 },
-		{ 166, 109 },
-		{ 258, 110 },
-		{ 261, 112 },
-		{ 269, 114 },
-		{ 287, 116 },
-		{ 299, 117 },
-		{ 491, 118 },
-		{ 511, 119 }, // Was: 418
-		{ 531, 120 }, // Was: 431
-		{ 551, 121 }, // Was: 419
-		{ 571, 122 }, // Was: 481
-		{ 593, 123 }, // Was: 529
-		{ 616, 124 },
-		{ 661, 125 },
-		{ 776, 126 },
-		{ 816, 127 }, // Was: 775
-		{ 856, 128 },
-		{ 860, 129 },
-		{ 901, 130 },
-		{ 976, 131 },
-		{ 1016, 132 },
-		{ 1106, 133 },
-		{ 1145, 134 },
-		{ 1219, 135 },
-		{ 1269, 136 },
-		{ 1340, 137 },
-		{ 1425, 138 },
-		{ 1456, 139 },
-		{ 1500, 140 },
-		{ 1580, 141 },
-		{ 1602, 142 },
-		{ 1700, 143 },
-		{ 1719, 144 },
-		{ 1779, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { HVL__0_Schedule_2_entries, sizeof(HVL__0_Schedule_2_entries), 36, -255, 1779 };
+	}
+};
+
+static const uint8_t HVL__1_Schedule_4_entries[] = {  // First departure: 16:42:00
+	0xff, 0x09, 0xa2, 0x02,  // { -80, 145 }
+	0xb1, 0x31,  // { 315, 144 }
+	0xe1, 0x09,  // { 393, 143 }
+	0x91, 0x08,  // { 458, 142 }
+	0xf1, 0x0c,  // { 561, 141 }
+	0xc1, 0x02,  // { 581, 140 } Was: 497
+	0xe1, 0x08,  // { 651, 139 } Was: 517
+	0xe1, 0x08,  // { 721, 138 }
+	0x91, 0x02,  // { 738, 137 }
+	0x91, 0x0e,  // { 851, 136 }
+	0x71,  // { 858, 135 }
+	0x91, 0x07,  // { 915, 134 }
+	0x91, 0x09,  // { 988, 133 }
+	0x91, 0x29,  // { 1317, 132 }
+	0xc1, 0x02,  // { 1337, 131 } Was: 1113
+	0xc1, 0x02,  // { 1357, 130 } Was: 1153
+	0xc0, 0x02,  // { 1377, 128 } Was: 1195
+	0xc1, 0x02,  // { 1397, 127 } Was: 1263
+	0xc1, 0x02,  // { 1417, 126 } Was: 1363
+	0x91, 0x10,  // { 1546, 125 } Was: 1275
+	0xa1, 0x10,  // { 1676, 124 }
+	0xc1, 0x02,  // { 1696, 123 } Was: 1435
+	0xc1, 0x02,  // { 1716, 122 } Was: 1620
+	0xc1, 0x02,  // { 1736, 121 } Was: 1598
+	0xc1, 0x02,  // { 1756, 120 } Was: 1492
+	0xc1, 0x02,  // { 1776, 119 } Was: 1571
+	0x81, 0x04,  // { 1808, 118 } Was: 1740
+	0x81, 0x04,  // { 1840, 117 }
+	0x31,  // { 1843, 116 } Was: 1811
+	0x20,  // { 1845, 114 }
+	0xc0, 0x04,  // { 1881, 112 }
+	0xd0, 0x14,  // { 2046, 110 }
+	0x81, 0x09,  // { 2118, 109 } Was: 1843
+	//{ 2191, 107 },
+	0xc7, 0x02, 0x05,  // { 2138, 106 } Was: 1898
+	//{ 1968, 103 },
+	0xff, 0x03, 0xd5, 0x01,  // { 2106, -1 }
 };
 
 class HVL__1_Schedule_4 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(255, 96, 0);
 	}
@@ -715,54 +739,53 @@ class HVL__1_Schedule_4 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 16:42:00
-		{ -80, 145 },
-		{ 315, 144 },
-		{ 393, 143 },
-		{ 458, 142 },
-		{ 561, 141 },
-		{ 581, 140 }, // Was: 497
-		{ 651, 139 }, // Was: 517
-		{ 721, 138 },
-		{ 738, 137 },
-		{ 851, 136 },
-		{ 858, 135 },
-		{ 915, 134 },
-		{ 988, 133 },
-		{ 1317, 132 },
-		{ 1337, 131 }, // Was: 1113
-		{ 1357, 130 }, // Was: 1153
-		{ 1377, 128 }, // Was: 1195
-		{ 1397, 127 }, // Was: 1263
-		{ 1417, 126 }, // Was: 1363
-		{ 1546, 125 }, // Was: 1275
-		{ 1676, 124 },
-		{ 1696, 123 }, // Was: 1435
-		{ 1716, 122 }, // Was: 1620
-		{ 1736, 121 }, // Was: 1598
-		{ 1756, 120 }, // Was: 1492
-		{ 1776, 119 }, // Was: 1571
-		{ 1808, 118 }, // Was: 1740
-		{ 1840, 117 },
-		{ 1843, 116 }, // Was: 1811
-		{ 1845, 114 },
-		{ 1881, 112 },
-		{ 2046, 110 },
-		{ 2118, 109 }, // Was: 1843
-		//{ 2191, 107 },
-		{ 2138, 106 }, // Was: 1898
-		//{ 1968, 103 },
-		{ 2106, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { HVL__1_Schedule_4_entries, sizeof(HVL__1_Schedule_4_entries), 35, -80, 2106 };
+	}
+};
+
+static const uint8_t HVL__1_Schedule_5_entries[] = {  // First departure: 17:01:00
+	0xb7, 0x03, 0xa2, 0x02,  // { 27, 145 }
+	0xf1, 0x12,  // { 178, 144 }
+	0xf1, 0x13,  // { 337, 143 }
+	0xd1, 0x26,  // { 646, 142 }
+	0xe1, 0x07,  // { 708, 141 } Was: 622
+	0xf1, 0x07,  // { 771, 140 }
+	0x20,  // { 773, 138 }
+	0xd1, 0x05,  // { 818, 137 } Was: 670
+	0xd1, 0x05,  // { 863, 136 }
+	0xf1, 0x05,  // { 910, 135 }
+	0xb1, 0x09,  // { 985, 134 }
+	0xf1, 0x1c,  // { 1216, 133 }
+	0xc1, 0x02,  // { 1236, 132 } Was: 1105
+	0xc1, 0x02,  // { 1256, 131 } Was: 975
+	0xc1, 0x06,  // { 1308, 130 } Was: 1213
+	0xd1, 0x06,  // { 1361, 129 }
+	0xa1, 0x06,  // { 1411, 128 } Was: 1125
+	0xa1, 0x06,  // { 1461, 127 }
+	0xc1, 0x02,  // { 1481, 126 } Was: 1345
+	0xf1, 0x08,  // { 1552, 125 } Was: 1360
+	0x81, 0x09,  // { 1624, 124 }
+	0xd1, 0x07,  // { 1685, 123 } Was: 1372
+	0xd1, 0x07,  // { 1746, 122 }
+	0xc1, 0x02,  // { 1766, 121 } Was: 1499
+	0xd1, 0x05,  // { 1811, 120 } Was: 1520
+	0xd0, 0x05,  // { 1856, 118 }
+	0x51,  // { 1861, 117 }
+	0xc1, 0x02,  // { 1881, 116 } Was: 1818
+	0xd0, 0x04,  // { 1918, 114 } Was: 1790
+	0xd0, 0x04,  // { 1955, 112 }
+	0xc0, 0x02,  // { 1975, 110 }
+	0xa1, 0x0a,  // { 2057, 109 }
+	//{ 2150, 107 },
+	0x37, 0x05,  // { 2060, 106 }
+	//{ 2176, 103 },
+	0xe7, 0x2c, 0x07,  // { 2418, 102 }
+	0xc7, 0x07, 0xcd, 0x01,  // { 2478, -1 }
 };
 
 class HVL__1_Schedule_5 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(255, 96, 0);
 	}
@@ -772,54 +795,70 @@ class HVL__1_Schedule_5 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 17:01:00
-		{ 27, 145 },
-		{ 178, 144 },
-		{ 337, 143 },
-		{ 646, 142 },
-		{ 708, 141 }, // Was: 622
-		{ 771, 140 },
-		{ 773, 138 },
-		{ 818, 137 }, // Was: 670
-		{ 863, 136 },
-		{ 910, 135 },
-		{ 985, 134 },
-		{ 1216, 133 },
-		{ 1236, 132 }, // Was: 1105
-		{ 1256, 131 }, // Was: 975
-		{ 1308, 130 }, // Was: 1213
-		{ 1361, 129 },
-		{ 1411, 128 }, // Was: 1125
-		{ 1461, 127 },
-		{ 1481, 126 }, // Was: 1345
-		{ 1552, 125 }, // Was: 1360
-		{ 1624, 124 },
-		{ 1685, 123 }, // Was: 1372
-		{ 1746, 122 },
-		{ 1766, 121 }, // Was: 1499
-		{ 1811, 120 }, // Was: 1520
-		{ 1856, 118 },
-		{ 1861, 117 },
-		{ 1881, 116 }, // Was: 1818
-		{ 1918, 114 }, // Was: 1790
-		{ 1955, 112 },
-		{ 1975, 110 },
-		{ 2057, 109 },
-		//{ 2150, 107 },
-		{ 2060, 106 },
-		//{ 2176, 103 },
-		{ 2418, 102 },
-		{ 2478, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { HVL__1_Schedule_5_entries, sizeof(HVL__1_Schedule_5_entries), 35, 27, 2478 };
+	}
+};
+
+static const uint8_t KPL__0_Schedule_0_entries[] = {  // First departure: 05:52:00, interval ~1680s
+	//{ 695, 100 },
+	0xbf, 0x24, 0xca, 0x01,  // { -292, 101 }
+	//{ -291, 102 },
+	//{ -291, 103 },
+	//{ -294, 104 },
+	0xe7, 0x34, 0x0a,  // { 130, 106 }
+	//{ 135, 107 },
+	0xb4, 0x05,  // { 173, 108 }
+	0xb4, 0x03,  // { 200, 110 }
+	0x83, 0x06,  // { 248, 111 }
+	0x84, 0x02,  // { 264, 113 }
+	0xf4, 0x01,  // { 279, 115 }
+	0x87, 0x03, 0x9c, 0x01,  // { 303, 193 }
+	0x93, 0x0f,  // { 424, 194 }
+	0xc3, 0x1d,  // { 660, 195 }
+	0xb3, 0x09,  // { 735, 196 }
+	0xb3, 0x04,  // { 770, 197 }
+	0xe3, 0x0a,  // { 856, 198 }
+	0xc3, 0x03,  // { 884, 199 }
+	0xb3, 0x05,  // { 927, 200 }
+	0x83, 0x07,  // { 983, 201 }
+	0xc3, 0x07,  // { 1043, 202 }
+	0xb3, 0x07,  // { 1102, 203 }
+	0xc3, 0x07,  // { 1162, 204 }
+	0xd3, 0x07,  // { 1223, 205 }
+	0xd3, 0x0c,  // { 1324, 206 }
+	0x83, 0x05,  // { 1364, 207 }
+	0xe3, 0x0a,  // { 1450, 208 }
+	0xd3, 0x06,  // { 1503, 209 }
+	0x83, 0x09,  // { 1575, 210 }
+	0xf3, 0x04,  // { 1614, 211 }
+	0xc3, 0x0a,  // { 1698, 212 }
+	0xe3, 0x05,  // { 1744, 213 }
+	0xf3, 0x09,  // { 1823, 214 }
+	0x84, 0x07,  // { 1879, 216 }
+	0xd3, 0x19,  // { 2084, 217 }
+	0xc3, 0x0f,  // { 2208, 218 }
+	0xc3, 0x06,  // { 2260, 219 }
+	0x83, 0x08,  // { 2324, 220 }
+	0x93, 0x0c,  // { 2421, 221 }
+	0xc3, 0x1d,  // { 2657, 222 }
+	0xc3, 0x15,  // { 2829, 223 }
+	0xb3, 0x10,  // { 2960, 224 }
+	0xf3, 0x0c,  // { 3063, 225 }
+	0x83, 0x0e,  // { 3175, 226 }
+	0xf3, 0x08,  // { 3246, 227 }
+	//{ 3405, 228 },
+	0xa4, 0x0e,  // { 3360, 229 }
+	0xb3, 0x04,  // { 3395, 230 }
+	0xb3, 0x11,  // { 3534, 231 }
+	0x83, 0x08,  // { 3598, 232 }
+	0xc3, 0x07,  // { 3658, 233 }
+	0xa3, 0x08,  // { 3724, 234 }
+	0xc7, 0x25, 0xd5, 0x03,  // { 4024, -1 }
 };
 
 class KPL__0_Schedule_0 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(159, 223, 0);
 	}
@@ -834,71 +873,70 @@ class KPL__0_Schedule_0 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 05:52:00, interval ~1680s
-		//{ 695, 100 },
-		{ -292, 101 },
-		//{ -291, 102 },
-		//{ -291, 103 },
-		//{ -294, 104 },
-		{ 130, 106 },
-		//{ 135, 107 },
-		{ 173, 108 },
-		{ 200, 110 },
-		{ 248, 111 },
-		{ 264, 113 },
-		{ 279, 115 },
-		{ 303, 193 },
-		{ 424, 194 },
-		{ 660, 195 },
-		{ 735, 196 },
-		{ 770, 197 },
-		{ 856, 198 },
-		{ 884, 199 },
-		{ 927, 200 },
-		{ 983, 201 },
-		{ 1043, 202 },
-		{ 1102, 203 },
-		{ 1162, 204 },
-		{ 1223, 205 },
-		{ 1324, 206 },
-		{ 1364, 207 },
-		{ 1450, 208 },
-		{ 1503, 209 },
-		{ 1575, 210 },
-		{ 1614, 211 },
-		{ 1698, 212 },
-		{ 1744, 213 },
-		{ 1823, 214 },
-		{ 1879, 216 },
-		{ 2084, 217 },
-		{ 2208, 218 },
-		{ 2260, 219 },
-		{ 2324, 220 },
-		{ 2421, 221 },
-		{ 2657, 222 },
-		{ 2829, 223 },
-		{ 2960, 224 },
-		{ 3063, 225 },
-		{ 3175, 226 },
-		{ 3246, 227 },
-		//{ 3405, 228 },
-		{ 3360, 229 },
-		{ 3395, 230 },
-		{ 3534, 231 },
-		{ 3598, 232 },
-		{ 3658, 233 },
-		{ 3724, 234 },
-		{ 4024, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { KPL__0_Schedule_0_entries, sizeof(KPL__0_Schedule_0_entries), 48, -292, 4024 };
+	}
+};
+
+static const uint8_t KPL__1_Schedule_0_entries[] = {  // First departure: 05:00:00, interval ~1800s
+	0xcf, 0x23, 0xd4, 0x03,  // { -285, 234 }
+	0xb1, 0x2d,  // { 78, 233 }
+	0xd1, 0x04,  // { 115, 232 }
+	0xb1, 0x0f,  // { 238, 231 }
+	0xe1, 0x0e,  // { 356, 230 }
+	0xa1, 0x02,  // { 374, 229 }
+	//{ 418, 228 },
+	0xc0, 0x08,  // { 442, 227 }
+	0xc1, 0x13,  // { 598, 226 }
+	0xc1, 0x07,  // { 658, 225 }
+	0x81, 0x08,  // { 722, 224 }
+	0x81, 0x0e,  // { 834, 223 }
+	0x91, 0x0b,  // { 923, 222 }
+	0xd1, 0x1b,  // { 1144, 221 }
+	0xb1, 0x16,  // { 1323, 220 }
+	0xe1, 0x09,  // { 1401, 219 }
+	0xa1, 0x04,  // { 1435, 218 }
+	0xd1, 0x0a,  // { 1520, 217 }
+	0xe1, 0x14,  // { 1686, 216 }
+	//{ 2045, 215 },
+	0xf0, 0x17,  // { 1877, 214 }
+	0xf1, 0x05,  // { 1924, 213 }
+	0x81, 0x0a,  // { 2004, 212 }
+	0xf1, 0x05,  // { 2051, 211 }
+	0xc1, 0x0a,  // { 2135, 210 }
+	0x81, 0x04,  // { 2167, 209 }
+	0xc1, 0x0d,  // { 2275, 208 }
+	0xa1, 0x01,  // { 2285, 207 }
+	0x81, 0x0b,  // { 2373, 206 }
+	0x91, 0x07,  // { 2430, 205 }
+	0xc1, 0x0a,  // { 2514, 204 }
+	0x81, 0x0a,  // { 2594, 203 }
+	0xc1, 0x04,  // { 2630, 202 }
+	0xd1, 0x0a,  // { 2715, 201 }
+	0xd1, 0x03,  // { 2744, 200 }
+	0xe1, 0x02,  // { 2766, 199 }
+	0xa1, 0x09,  // { 2840, 198 }
+	0xf1, 0x05,  // { 2887, 197 }
+	0x91, 0x0a,  // { 2968, 196 }
+	0x91, 0x06,  // { 3017, 195 }
+	0xa1, 0x2f,  // { 3395, 194 }
+	0x91, 0x03,  // { 3420, 193 }
+	0x87, 0x07, 0x9b, 0x01,  // { 3476, 115 }
+	0xa0, 0x01,  // { 3486, 113 }
+	0xe0, 0x06,  // { 3540, 111 }
+	0x81, 0x08,  // { 3604, 110 }
+	0xd0, 0x0b,  // { 3697, 108 } Was: 3595
+	//{ 3791, 107 },
+	0xa0, 0x09,  // { 3771, 106 } Was: 3675
+	//{ 3845, 104 },
+	//{ 3795, 103 },
+	//{ 3696, 102 },
+	0xc7, 0x02, 0x09,  // { 3791, 101 } Was: 3730
+	0xf7, 0x1d, 0xcb, 0x01,  // { 4030, -1 }
 };
 
 class KPL__1_Schedule_0 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(159, 223, 0);
 	}
@@ -913,71 +951,68 @@ class KPL__1_Schedule_0 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 05:00:00, interval ~1800s
-		{ -285, 234 },
-		{ 78, 233 },
-		{ 115, 232 },
-		{ 238, 231 },
-		{ 356, 230 },
-		{ 374, 229 },
-		//{ 418, 228 },
-		{ 442, 227 },
-		{ 598, 226 },
-		{ 658, 225 },
-		{ 722, 224 },
-		{ 834, 223 },
-		{ 923, 222 },
-		{ 1144, 221 },
-		{ 1323, 220 },
-		{ 1401, 219 },
-		{ 1435, 218 },
-		{ 1520, 217 },
-		{ 1686, 216 },
-		//{ 2045, 215 },
-		{ 1877, 214 },
-		{ 1924, 213 },
-		{ 2004, 212 },
-		{ 2051, 211 },
-		{ 2135, 210 },
-		{ 2167, 209 },
-		{ 2275, 208 },
-		{ 2285, 207 },
-		{ 2373, 206 },
-		{ 2430, 205 },
-		{ 2514, 204 },
-		{ 2594, 203 },
-		{ 2630, 202 },
-		{ 2715, 201 },
-		{ 2744, 200 },
-		{ 2766, 199 },
-		{ 2840, 198 },
-		{ 2887, 197 },
-		{ 2968, 196 },
-		{ 3017, 195 },
-		{ 3395, 194 },
-		{ 3420, 193 },
-		{ 3476, 115 },
-		{ 3486, 113 },
-		{ 3540, 111 },
-		{ 3604, 110 },
-		{ 3697, 108 }, // Was: 3595
-		//{ 3791, 107 },
-		{ 3771, 106 }, // Was: 3675
-		//{ 3845, 104 },
-		//{ 3795, 103 },
-		//{ 3696, 102 },
-		{ 3791, 101 }, // Was: 3730
-		{ 4030, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { KPL__1_Schedule_0_entries, sizeof(KPL__1_Schedule_0_entries), 48, -285, 4030 };
+	}
+};
+
+static const uint8_t KPL__1_Schedule_1_entries[] = {  // First departure: 06:00:00, interval ~1680s
+	0xcf, 0x24, 0xd4, 0x03,  // { -293, 234 }
+	0xe1, 0x2e,  // { 81, 233 }
+	0xf1, 0x03,  // { 112, 232 }
+	0xa1, 0x10,  // { 242, 231 }
+	0xd1, 0x0e,  // { 359, 230 }
+	0x81, 0x01,  // { 367, 229 }
+	//{ 443, 228 },
+	0xd0, 0x09,  // { 444, 227 }
+	0xc1, 0x13,  // { 600, 226 }
+	0xb1, 0x0e,  // { 715, 225 }
+	0x71,  // { 722, 224 }
+	0x81, 0x0f,  // { 842, 223 }
+	0xa1, 0x0a,  // { 924, 222 }
+	0x81, 0x15,  // { 1092, 221 }
+	0xf1, 0x1c,  // { 1323, 220 }
+	0xf1, 0x09,  // { 1402, 219 }
+	0xc1, 0x04,  // { 1438, 218 }
+	0xc1, 0x0a,  // { 1522, 217 }
+	0xa1, 0x14,  // { 1684, 216 }
+	//{ 1924, 215 },
+	0xe0, 0x18,  // { 1882, 214 }
+	0x91, 0x03,  // { 1907, 213 }
+	0x81, 0x0c,  // { 2003, 212 }
+	0xa1, 0x04,  // { 2037, 211 }
+	0xf1, 0x0a,  // { 2124, 210 }
+	0xe1, 0x04,  // { 2162, 209 }
+	0xf1, 0x0c,  // { 2265, 208 }
+	0xa1, 0x02,  // { 2283, 207 }
+	0xd1, 0x0d,  // { 2392, 206 }
+	0xb1, 0x0a,  // { 2475, 205 }
+	0xf1, 0x05,  // { 2522, 204 }
+	0x11,  // { 2523, 203 }
+	0x90, 0x01,  // { 2532, 201 }
+	0x91, 0x1c,  // { 2757, 200 }
+	0xc1, 0x02,  // { 2777, 199 } Was: 2642
+	0xc1, 0x02,  // { 2797, 198 } Was: 2643
+	0xc1, 0x02,  // { 2817, 197 } Was: 2649
+	0xc1, 0x02,  // { 2837, 196 } Was: 2691
+	0xb1, 0x14,  // { 3000, 195 } Was: 2753
+	0xb1, 0x14,  // { 3163, 194 }
+	0x81, 0x05,  // { 3203, 193 } Was: 3155
+	0x97, 0x05, 0x9b, 0x01,  // { 3244, 115 }
+	0xd0, 0x05,  // { 3289, 113 }
+	0xc0, 0x03,  // { 3317, 111 }
+	0x61,  // { 3323, 110 }
+	0xe0, 0x02,  // { 3345, 108 }
+	//{ 3438, 107 },
+	0xe0, 0x0b,  // { 3439, 106 }
+	//{ 3563, 103 },
+	//{ 3558, 102 },
+	0xe7, 0x2e, 0x09,  // { 3813, 101 }
+	0xc7, 0x25, 0xcb, 0x01,  // { 4113, -1 }
 };
 
 class KPL__1_Schedule_1 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(159, 223, 0);
 	}
@@ -987,69 +1022,49 @@ class KPL__1_Schedule_1 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 06:00:00, interval ~1680s
-		{ -293, 234 },
-		{ 81, 233 },
-		{ 112, 232 },
-		{ 242, 231 },
-		{ 359, 230 },
-		{ 367, 229 },
-		//{ 443, 228 },
-		{ 444, 227 },
-		{ 600, 226 },
-		{ 715, 225 },
-		{ 722, 224 },
-		{ 842, 223 },
-		{ 924, 222 },
-		{ 1092, 221 },
-		{ 1323, 220 },
-		{ 1402, 219 },
-		{ 1438, 218 },
-		{ 1522, 217 },
-		{ 1684, 216 },
-		//{ 1924, 215 },
-		{ 1882, 214 },
-		{ 1907, 213 },
-		{ 2003, 212 },
-		{ 2037, 211 },
-		{ 2124, 210 },
-		{ 2162, 209 },
-		{ 2265, 208 },
-		{ 2283, 207 },
-		{ 2392, 206 },
-		{ 2475, 205 },
-		{ 2522, 204 },
-		{ 2523, 203 },
-		{ 2532, 201 },
-		{ 2757, 200 },
-		{ 2777, 199 }, // Was: 2642
-		{ 2797, 198 }, // Was: 2643
-		{ 2817, 197 }, // Was: 2649
-		{ 2837, 196 }, // Was: 2691
-		{ 3000, 195 }, // Was: 2753
-		{ 3163, 194 },
-		{ 3203, 193 }, // Was: 3155
-		{ 3244, 115 },
-		{ 3289, 113 },
-		{ 3317, 111 },
-		{ 3323, 110 },
-		{ 3345, 108 },
-		//{ 3438, 107 },
-		{ 3439, 106 },
-		//{ 3563, 103 },
-		//{ 3558, 102 },
-		{ 3813, 101 },
-		{ 4113, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { KPL__1_Schedule_1_entries, sizeof(KPL__1_Schedule_1_entries), 47, -293, 4113 };
+	}
+};
+
+static const uint8_t KPL__1_Schedule_2_entries[] = {  // First departure: 06:13:00, interval ~1920s
+	0xbf, 0x24, 0xac, 0x03,  // { -292, 214 }
+	0x91, 0x2f,  // { 85, 213 }
+	0xb1, 0x0a,  // { 168, 212 }
+	0xe1, 0x0b,  // { 262, 211 }
+	0xa1, 0x05,  // { 304, 210 }
+	0xe1, 0x09,  // { 382, 209 }
+	0xa1, 0x02,  // { 400, 208 }
+	0xf1, 0x0e,  // { 519, 207 }
+	0xc1, 0x03,  // { 547, 206 }
+	0xb1, 0x09,  // { 622, 205 }
+	0x91, 0x0c,  // { 719, 204 }
+	0xf1, 0x02,  // { 742, 203 }
+	0xe1, 0x0a,  // { 828, 202 }
+	0xc1, 0x04,  // { 864, 201 }
+	0xf1, 0x0c,  // { 967, 200 }
+	0xd1, 0x02,  // { 988, 199 }
+	0xb1, 0x02,  // { 1007, 198 }
+	0x81, 0x0c,  // { 1103, 197 }
+	0x81, 0x05,  // { 1143, 196 }
+	0x81, 0x0a,  // { 1223, 195 }
+	0xb1, 0x25,  // { 1522, 194 }
+	0xd1, 0x0c,  // { 1623, 193 }
+	0x97, 0x0b, 0x9f, 0x01,  // { 1712, 113 }
+	0xf0, 0x03,  // { 1743, 111 }
+	0x81, 0x05,  // { 1783, 110 } Was: 1737
+	0x80, 0x05,  // { 1823, 108 }
+	//{ 2053, 107 },
+	0xf0, 0x01,  // { 1838, 106 }
+	//{ 1900, 104 },
+	//{ 2152, 103 },
+	//{ 2058, 102 },
+	0x87, 0x0d, 0x09,  // { 1942, 101 }
+	0xc7, 0x25, 0xcb, 0x01,  // { 2242, -1 }
 };
 
 class KPL__1_Schedule_2 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(159, 223, 0);
 	}
@@ -1059,50 +1074,42 @@ class KPL__1_Schedule_2 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 06:13:00, interval ~1920s
-		{ -292, 214 },
-		{ 85, 213 },
-		{ 168, 212 },
-		{ 262, 211 },
-		{ 304, 210 },
-		{ 382, 209 },
-		{ 400, 208 },
-		{ 519, 207 },
-		{ 547, 206 },
-		{ 622, 205 },
-		{ 719, 204 },
-		{ 742, 203 },
-		{ 828, 202 },
-		{ 864, 201 },
-		{ 967, 200 },
-		{ 988, 199 },
-		{ 1007, 198 },
-		{ 1103, 197 },
-		{ 1143, 196 },
-		{ 1223, 195 },
-		{ 1522, 194 },
-		{ 1623, 193 },
-		{ 1712, 113 },
-		{ 1743, 111 },
-		{ 1783, 110 }, // Was: 1737
-		{ 1823, 108 },
-		//{ 2053, 107 },
-		{ 1838, 106 },
-		//{ 1900, 104 },
-		//{ 2152, 103 },
-		//{ 2058, 102 },
-		{ 1942, 101 },
-		{ 2242, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { KPL__1_Schedule_2_entries, sizeof(KPL__1_Schedule_2_entries), 29, -292, 2242 };
+	}
+};
+
+static const uint8_t KPL__0_Schedule_1_entries[] = {  // First departure: 07:03:00, interval ~28680s
+	//{ 54, 100 },
+	0xdf, 0x24, 0xca, 0x01,  // { -294, 101 }
+	//{ -66, 102 },
+	//{ -293, 103 },
+	//{ -294, 104 },
+	0x97, 0x36, 0x0a,  // { 139, 106 }
+	//{ 140, 107 },
+	0x94, 0x03,  // { 164, 108 }
+	0x84, 0x03,  // { 188, 110 }
+	0x83, 0x09,  // { 260, 111 }
+	0xa4, 0x01,  // { 270, 113 }
+	0x24,  // { 272, 115 }
+	0x87, 0x03, 0x9c, 0x01,  // { 296, 193 }
+	0xd3, 0x0f,  // { 421, 194 }
+	0xa3, 0x1e,  // { 663, 195 }
+	0xd3, 0x09,  // { 740, 196 }
+	0x93, 0x03,  // { 765, 197 }
+	0xf3, 0x0b,  // { 860, 198 }
+	0x93, 0x04,  // { 893, 199 }
+	0xb3, 0x0a,  // { 976, 200 }
+	0xd3, 0x02,  // { 997, 201 }
+	0xe3, 0x0c,  // { 1099, 202 }
+	0x93, 0x03,  // { 1124, 203 }
+	0xf3, 0x0b,  // { 1219, 204 }
+	0xe3, 0x04,  // { 1257, 205 }
+	0xc7, 0x25, 0x9b, 0x03,  // { 1557, -1 }
 };
 
 class KPL__0_Schedule_1 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(159, 223, 0);
 	}
@@ -1112,43 +1119,38 @@ class KPL__0_Schedule_1 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 07:03:00, interval ~28680s
-		//{ 54, 100 },
-		{ -294, 101 },
-		//{ -66, 102 },
-		//{ -293, 103 },
-		//{ -294, 104 },
-		{ 139, 106 },
-		//{ 140, 107 },
-		{ 164, 108 },
-		{ 188, 110 },
-		{ 260, 111 },
-		{ 270, 113 },
-		{ 272, 115 },
-		{ 296, 193 },
-		{ 421, 194 },
-		{ 663, 195 },
-		{ 740, 196 },
-		{ 765, 197 },
-		{ 860, 198 },
-		{ 893, 199 },
-		{ 976, 200 },
-		{ 997, 201 },
-		{ 1099, 202 },
-		{ 1124, 203 },
-		{ 1219, 204 },
-		{ 1257, 205 },
-		{ 1557, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { KPL__0_Schedule_1_entries, sizeof(KPL__0_Schedule_1_entries), 21, -294, 1557 };
+	}
+};
+
+static const uint8_t KPL__1_Schedule_3_entries[] = {  // First departure: 07:11:00
+	0xcf, 0x24, 0x9e, 0x03,  // { -293, 207 }
+	0xc1, 0x27,  // { 23, 206 }
+	0xb1, 0x02,  // { 42, 205 }
+	0x91, 0x0d,  // { 147, 204 }
+	0xb1, 0x05,  // { 190, 203 }
+	0x81, 0x0a,  // { 270, 202 }
+	0x81, 0x0e,  // { 382, 201 }
+	0xd1, 0x02,  // { 403, 200 }
+	0xd1, 0x05,  // { 448, 199 }
+	0xf1, 0x06,  // { 503, 198 }
+	0xe1, 0x05,  // { 549, 197 }
+	0xb1, 0x09,  // { 624, 196 }
+	0x81, 0x0f,  // { 744, 195 }
+	0xa1, 0x26,  // { 1050, 194 }
+	0xb1, 0x0b,  // { 1141, 193 }
+	0xf7, 0x04, 0x9f, 0x01,  // { 1180, 113 }
+	0xe0, 0x05,  // { 1226, 111 }
+	0xc1, 0x05,  // { 1270, 110 }
+	0xf0, 0x03,  // { 1301, 108 }
+	0xb0, 0x07,  // { 1360, 106 }
+	//{ 1400, 103 },
+	0xc7, 0x25, 0xd5, 0x01,  // { 1660, -1 }
 };
 
 class KPL__1_Schedule_3 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(159, 223, 0);
 	}
@@ -1158,39 +1160,40 @@ class KPL__1_Schedule_3 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 07:11:00
-		{ -293, 207 },
-		{ 23, 206 },
-		{ 42, 205 },
-		{ 147, 204 },
-		{ 190, 203 },
-		{ 270, 202 },
-		{ 382, 201 },
-		{ 403, 200 },
-		{ 448, 199 },
-		{ 503, 198 },
-		{ 549, 197 },
-		{ 624, 196 },
-		{ 744, 195 },
-		{ 1050, 194 },
-		{ 1141, 193 },
-		{ 1180, 113 },
-		{ 1226, 111 },
-		{ 1270, 110 },
-		{ 1301, 108 },
-		{ 1360, 106 },
-		//{ 1400, 103 },
-		{ 1660, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { KPL__1_Schedule_3_entries, sizeof(KPL__1_Schedule_3_entries), 21, -293, 1660 };
+	}
+};
+
+static const uint8_t KPL__1_Schedule_4_entries[] = {  // First departure: 07:29:00, interval ~780s
+	0xbf, 0x18, 0x9c, 0x03,  // { -196, 206 }
+	0xa1, 0x21,  // { 70, 205 }
+	0xd1, 0x0f,  // { 195, 204 }
+	0xe1, 0x07,  // { 257, 203 }
+	0x91, 0x07,  // { 314, 202 }
+	0xf1, 0x07,  // { 377, 201 }
+	0xf1, 0x07,  // { 440, 200 }
+	0xb1, 0x07,  // { 499, 199 }
+	0xf1, 0x01,  // { 514, 198 }
+	0x81, 0x0c,  // { 610, 197 }
+	0xf1, 0x07,  // { 673, 196 }
+	0x91, 0x08,  // { 738, 195 }
+	0xb1, 0x2a,  // { 1077, 194 }
+	0xf1, 0x08,  // { 1148, 193 }
+	0xc7, 0x0f, 0x9b, 0x01,  // { 1272, 115 }
+	0xc0, 0x02,  // { 1292, 113 } Was: 1219
+	0x40,  // { 1296, 111 } Was: 1269
+	0x41,  // { 1300, 110 }
+	0xd0, 0x04,  // { 1337, 108 }
+	0x90, 0x05,  // { 1378, 106 }
+	//{ 1462, 103 },
+	//{ 1456, 102 },
+	0x87, 0x14, 0x09,  // { 1538, 101 }
+	0xc7, 0x25, 0xcb, 0x01,  // { 1838, -1 }
 };
 
 class KPL__1_Schedule_4 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(159, 223, 0);
 	}
@@ -1200,41 +1203,46 @@ class KPL__1_Schedule_4 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 07:29:00, interval ~780s
-		{ -196, 206 },
-		{ 70, 205 },
-		{ 195, 204 },
-		{ 257, 203 },
-		{ 314, 202 },
-		{ 377, 201 },
-		{ 440, 200 },
-		{ 499, 199 },
-		{ 514, 198 },
-		{ 610, 197 },
-		{ 673, 196 },
-		{ 738, 195 },
-		{ 1077, 194 },
-		{ 1148, 193 },
-		{ 1272, 115 },
-		{ 1292, 113 }, // Was: 1219
-		{ 1296, 111 }, // Was: 1269
-		{ 1300, 110 },
-		{ 1337, 108 },
-		{ 1378, 106 },
-		//{ 1462, 103 },
-		//{ 1456, 102 },
-		{ 1538, 101 },
-		{ 1838, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { KPL__1_Schedule_4_entries, sizeof(KPL__1_Schedule_4_entries), 22, -196, 1838 };
+	}
+};
+
+static const uint8_t KPL__1_Schedule_5_entries[] = {  // First departure: 07:35:00
+	0xbf, 0x24, 0xac, 0x03,  // { -292, 214 }
+	0xa1, 0x2b,  // { 54, 213 }
+	0xe1, 0x0d,  // { 164, 212 }
+	0x81, 0x0c,  // { 260, 211 }
+	0xa1, 0x05,  // { 302, 210 }
+	0xd1, 0x09,  // { 379, 209 }
+	0x51,  // { 384, 208 }
+	0xd1, 0x13,  // { 541, 207 }
+	0x21,  // { 543, 206 }
+	0xf1, 0x18,  // { 742, 205 }
+	0xf1, 0x0e,  // { 861, 204 }
+	0x11,  // { 862, 203 }
+	0xd1, 0x0e,  // { 979, 202 }
+	0x91, 0x03,  // { 1004, 201 }
+	0xc1, 0x0c,  // { 1104, 200 }
+	0x81, 0x03,  // { 1128, 199 }
+	0x81, 0x03,  // { 1152, 198 }
+	0xd1, 0x0b,  // { 1245, 197 }
+	0x81, 0x0c,  // { 1341, 196 }
+	0xf1, 0x02,  // { 1364, 195 }
+	0xa1, 0x30,  // { 1750, 194 }
+	0xb1, 0x0c,  // { 1849, 193 }
+	0xb7, 0x01, 0x9b, 0x01,  // { 1860, 115 }
+	0x20,  // { 1862, 113 }
+	0xd0, 0x09,  // { 1939, 111 }
+	0xf1, 0x02,  // { 1962, 110 }
+	0xb0, 0x01,  // { 1973, 108 }
+	0xa0, 0x0b,  // { 2063, 106 }
+	0x87, 0x10, 0x09,  // { 2191, 101 }
+	0xc7, 0x25, 0xcb, 0x01,  // { 2491, -1 }
 };
 
 class KPL__1_Schedule_5 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(159, 223, 0);
 	}
@@ -1244,47 +1252,90 @@ class KPL__1_Schedule_5 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 07:35:00
-		{ -292, 214 },
-		{ 54, 213 },
-		{ 164, 212 },
-		{ 260, 211 },
-		{ 302, 210 },
-		{ 379, 209 },
-		{ 384, 208 },
-		{ 541, 207 },
-		{ 543, 206 },
-		{ 742, 205 },
-		{ 861, 204 },
-		{ 862, 203 },
-		{ 979, 202 },
-		{ 1004, 201 },
-		{ 1104, 200 },
-		{ 1128, 199 },
-		{ 1152, 198 },
-		{ 1245, 197 },
-		{ 1341, 196 },
-		{ 1364, 195 },
-		{ 1750, 194 },
-		{ 1849, 193 },
-		{ 1860, 115 },
-		{ 1862, 113 },
-		{ 1939, 111 },
-		{ 1962, 110 },
-		{ 1973, 108 },
-		{ 2063, 106 },
-		{ 2191, 101 },
-		{ 2491, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { KPL__1_Schedule_5_entries, sizeof(KPL__1_Schedule_5_entries), 30, -292, 2491 };
+	}
+};
+
+static const uint8_t KPL__0_Schedule_2_entries[] = {  // First departure: 15:35:00, interval ~1200s
+	//{ -287, 102 },
+	//{ -293, 103 },
+	//{ -290, 104 },
+	0x87, 0x11, 0xd4, 0x01,  // { 136, 106 }
+	//{ 358, 107 },
+	0xe4, 0x03,  // { 166, 108 }
+	0xb4, 0x0b,  // { 257, 110 }
+	0x43,  // { 261, 111 }
+	0x84, 0x02,  // { 277, 113 }
+	0xc4, 0x01,  // { 289, 115 }
+	//{ 1806, 118 },
+	//{ 1757, 120 },
+	//{ 1687, 121 },
+	//{ 1676, 122 },
+	//{ 1556, 124 },
+	//{ 1436, 126 },
+	//{ 1416, 127 },
+	//{ 1326, 129 },
+	//{ 1287, 130 },
+	//{ 1276, 131 },
+	//{ 1206, 132 },
+	//{ 1156, 133 },
+	//{ 1076, 134 },
+	//{ 1037, 135 },
+	//{ 966, 136 },
+	//{ 917, 137 },
+	//{ 836, 139 },
+	//{ 796, 140 },
+	//{ 726, 141 },
+	//{ 676, 142 },
+	//{ 556, 144 },
+	//{ 477, 145 },
+	//{ 436, 146 },
+	//{ 366, 147 },
+	//{ 356, 148 },
+	0xd7, 0x01, 0x9c, 0x01,  // { 302, 193 }
+	0xa3, 0x0f,  // { 424, 194 }
+	0xa3, 0x1f,  // { 674, 195 }
+	0xd3, 0x05,  // { 719, 196 } Was: 669
+	0xd3, 0x05,  // { 764, 197 }
+	0xa3, 0x02,  // { 782, 198 }
+	0x63,  // { 788, 199 }
+	0x84, 0x07,  // { 844, 201 } Was: 784
+	0x84, 0x07,  // { 900, 203 }
+	0x33,  // { 903, 204 } Was: 900
+	0x33,  // { 906, 205 }
+	0xc3, 0x0d,  // { 1014, 206 }
+	0xe3, 0x0a,  // { 1100, 207 }
+	0xc3, 0x05,  // { 1144, 208 }
+	0x83, 0x0f,  // { 1264, 209 }
+	0x83, 0x05,  // { 1304, 210 } Was: 1264
+	0x83, 0x05,  // { 1344, 211 }
+	0xf3, 0x07,  // { 1407, 212 }
+	0xf3, 0x06,  // { 1462, 213 }
+	0xf3, 0x0e,  // { 1581, 214 }
+	0xa4, 0x04,  // { 1615, 216 }
+	0x83, 0x1e,  // { 1855, 217 }
+	0xd3, 0x0e,  // { 1972, 218 }
+	0x83, 0x0a,  // { 2052, 219 }
+	0xf3, 0x02,  // { 2075, 220 }
+	0xa3, 0x0e,  // { 2189, 221 }
+	0xa3, 0x21,  // { 2455, 222 }
+	0xf3, 0x10,  // { 2590, 223 }
+	0xa3, 0x15,  // { 2760, 224 }
+	0xa3, 0x08,  // { 2826, 225 }
+	0xa3, 0x0e,  // { 2940, 226 }
+	0x83, 0x0f,  // { 3060, 227 }
+	//{ 3066, 228 },
+	0xb4, 0x0d,  // { 3167, 229 }
+	0x53,  // { 3172, 230 }
+	0x83, 0x10,  // { 3300, 231 }
+	0xb3, 0x0e,  // { 3415, 232 }
+	0xb3, 0x04,  // { 3450, 233 }
+	0xc7, 0x25, 0xd3, 0x03,  // { 3750, -1 }
 };
 
 class KPL__0_Schedule_2 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(159, 223, 0);
 	}
@@ -1294,91 +1345,39 @@ class KPL__0_Schedule_2 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 15:35:00, interval ~1200s
-		//{ -287, 102 },
-		//{ -293, 103 },
-		//{ -290, 104 },
-		{ 136, 106 },
-		//{ 358, 107 },
-		{ 166, 108 },
-		{ 257, 110 },
-		{ 261, 111 },
-		{ 277, 113 },
-		{ 289, 115 },
-		//{ 1806, 118 },
-		//{ 1757, 120 },
-		//{ 1687, 121 },
-		//{ 1676, 122 },
-		//{ 1556, 124 },
-		//{ 1436, 126 },
-		//{ 1416, 127 },
-		//{ 1326, 129 },
-		//{ 1287, 130 },
-		//{ 1276, 131 },
-		//{ 1206, 132 },
-		//{ 1156, 133 },
-		//{ 1076, 134 },
-		//{ 1037, 135 },
-		//{ 966, 136 },
-		//{ 917, 137 },
-		//{ 836, 139 },
-		//{ 796, 140 },
-		//{ 726, 141 },
-		//{ 676, 142 },
-		//{ 556, 144 },
-		//{ 477, 145 },
-		//{ 436, 146 },
-		//{ 366, 147 },
-		//{ 356, 148 },
-		{ 302, 193 },
-		{ 424, 194 },
-		{ 674, 195 },
-		{ 719, 196 }, // Was: 669
-		{ 764, 197 },
-		{ 782, 198 },
-		{ 788, 199 },
-		{ 844, 201 }, // Was: 784
-		{ 900, 203 },
-		{ 903, 204 }, // Was: 900
-		{ 906, 205 },
-		{ 1014, 206 },
-		{ 1100, 207 },
-		{ 1144, 208 },
-		{ 1264, 209 },
-		{ 1304, 210 }, // Was: 1264
-		{ 1344, 211 },
-		{ 1407, 212 },
-		{ 1462, 213 },
-		{ 1581, 214 },
-		{ 1615, 216 },
-		{ 1855, 217 },
-		{ 1972, 218 },
-		{ 2052, 219 },
-		{ 2075, 220 },
-		{ 2189, 221 },
-		{ 2455, 222 },
-		{ 2590, 223 },
-		{ 2760, 224 },
-		{ 2826, 225 },
-		{ 2940, 226 },
-		{ 3060, 227 },
-		//{ 3066, 228 },
-		{ 3167, 229 },
-		{ 3172, 230 },
-		{ 3300, 231 },
-		{ 3415, 232 },
-		{ 3450, 233 },
-		{ 3750, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { KPL__0_Schedule_2_entries, sizeof(KPL__0_Schedule_2_entries), 44, 136, 3750 };
+	}
+};
+
+static const uint8_t KPL__0_Schedule_3_entries[] = {  // First departure: 16:41:00, interval ~1200s
+	//{ -209, 103 },
+	//{ -294, 104 },
+	0xa7, 0x11, 0xd4, 0x01,  // { 138, 106 }
+	//{ 446, 107 },
+	0xd4, 0x0f,  // { 263, 108 }
+	0x74,  // { 270, 110 }
+	0x83, 0x05,  // { 310, 111 }
+	0xc4, 0x04,  // { 346, 113 }
+	0xa4, 0x04,  // { 380, 115 } Was: 309
+	0xb7, 0x04, 0x9c, 0x01,  // { 415, 193 }
+	0xe3, 0x0f,  // { 541, 194 }
+	0xd3, 0x1d,  // { 778, 195 }
+	0x83, 0x01,  // { 786, 196 }
+	0xd3, 0x0a,  // { 871, 197 }
+	0xc3, 0x0c,  // { 971, 198 }
+	0xe3, 0x03,  // { 1001, 199 }
+	0x83, 0x03,  // { 1025, 200 }
+	0xb3, 0x09,  // { 1100, 201 }
+	0xc3, 0x0e,  // { 1216, 202 }
+	0x53,  // { 1221, 203 }
+	0xd3, 0x0d,  // { 1330, 204 }
+	0xb3, 0x01,  // { 1341, 205 }
+	0xc7, 0x25, 0x9b, 0x03,  // { 1641, -1 }
 };
 
 class KPL__0_Schedule_3 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(159, 223, 0);
 	}
@@ -1388,40 +1387,43 @@ class KPL__0_Schedule_3 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 16:41:00, interval ~1200s
-		//{ -209, 103 },
-		//{ -294, 104 },
-		{ 138, 106 },
-		//{ 446, 107 },
-		{ 263, 108 },
-		{ 270, 110 },
-		{ 310, 111 },
-		{ 346, 113 },
-		{ 380, 115 }, // Was: 309
-		{ 415, 193 },
-		{ 541, 194 },
-		{ 778, 195 },
-		{ 786, 196 },
-		{ 871, 197 },
-		{ 971, 198 },
-		{ 1001, 199 },
-		{ 1025, 200 },
-		{ 1100, 201 },
-		{ 1216, 202 },
-		{ 1221, 203 },
-		{ 1330, 204 },
-		{ 1341, 205 },
-		{ 1641, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { KPL__0_Schedule_3_entries, sizeof(KPL__0_Schedule_3_entries), 20, 138, 1641 };
+	}
+};
+
+static const uint8_t MEL__0_Schedule_0_entries[] = {  // First departure: 06:14:00, interval ~2460s
+	//{ -237, 100 },
+	//{ -265, 101 },
+	//{ -286, 102 },
+	0xdf, 0x1f, 0xce, 0x01,  // { -254, 103 }
+	0xe7, 0x2e, 0x06,  // { 120, 106 }
+	//{ 139, 107 },
+	0xf7, 0x05, 0x06,  // { 167, 109 }
+	0xd3, 0x05,  // { 212, 110 }
+	0xa4, 0x06,  // { 262, 112 }
+	0x54,  // { 267, 114 } Was: 259
+	0x54,  // { 272, 116 }
+	0xa3, 0x03,  // { 298, 117 }
+	0xd3, 0x0b,  // { 391, 118 }
+	0x33,  // { 394, 119 }
+	0xe3, 0x13,  // { 552, 120 }
+	0xc3, 0x02,  // { 572, 121 } Was: 418
+	0xc3, 0x02,  // { 592, 122 } Was: 424
+	0xc3, 0x02,  // { 612, 123 } Was: 503
+	0xf3, 0x02,  // { 635, 124 } Was: 548
+	0x83, 0x03,  // { 659, 125 }
+	0xe3, 0x07,  // { 721, 126 }
+	0xe3, 0x02,  // { 743, 127 }
+	0x93, 0x06,  // { 792, 128 }
+	0xf7, 0x08, 0x66,  // { 863, 179 }
+	0xa3, 0x0e,  // { 977, 180 }
+	0xf3, 0x03,  // { 1008, 181 }
+	0xc7, 0x16, 0xeb, 0x02,  // { 1188, -1 }
 };
 
 class MEL__0_Schedule_0 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(255, 96, 128);
 	}
@@ -1431,44 +1433,44 @@ class MEL__0_Schedule_0 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 06:14:00, interval ~2460s
-		//{ -237, 100 },
-		//{ -265, 101 },
-		//{ -286, 102 },
-		{ -254, 103 },
-		{ 120, 106 },
-		//{ 139, 107 },
-		{ 167, 109 },
-		{ 212, 110 },
-		{ 262, 112 },
-		{ 267, 114 }, // Was: 259
-		{ 272, 116 },
-		{ 298, 117 },
-		{ 391, 118 },
-		{ 394, 119 },
-		{ 552, 120 },
-		{ 572, 121 }, // Was: 418
-		{ 592, 122 }, // Was: 424
-		{ 612, 123 }, // Was: 503
-		{ 635, 124 }, // Was: 548
-		{ 659, 125 },
-		{ 721, 126 },
-		{ 743, 127 },
-		{ 792, 128 },
-		{ 863, 179 },
-		{ 977, 180 },
-		{ 1008, 181 },
-		{ 1188, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { MEL__0_Schedule_0_entries, sizeof(MEL__0_Schedule_0_entries), 23, -254, 1188 };
+	}
+};
+
+static const uint8_t MEL__1_Schedule_0_entries[] = {  // First departure: 06:35:00, interval ~2460s
+	0xbf, 0x0e, 0xec, 0x02,  // { -116, 182 }
+	0xb1, 0x15,  // { 55, 181 }
+	0xd1, 0x11,  // { 196, 180 }
+	0xf1, 0x07,  // { 259, 179 }
+	0xc7, 0x11, 0x65,  // { 399, 128 }
+	0xd1, 0x0b,  // { 492, 127 }
+	0x81, 0x02,  // { 508, 126 }
+	0xb1, 0x04,  // { 543, 125 }
+	0xd1, 0x0e,  // { 660, 124 }
+	0xe1, 0x01,  // { 674, 123 }
+	0xd1, 0x0c,  // { 775, 122 }
+	0xe1, 0x01,  // { 789, 121 }
+	0xf1, 0x08,  // { 860, 120 }
+	0xf1, 0x04,  // { 899, 119 }
+	0xe1, 0x03,  // { 929, 118 } Was: 896
+	0xf1, 0x03,  // { 960, 117 }
+	0x91, 0x08,  // { 1025, 116 }
+	0x50,  // { 1030, 114 }
+	0xc0, 0x05,  // { 1074, 112 }
+	0x90, 0x03,  // { 1099, 110 }
+	0xd1, 0x02,  // { 1120, 109 }
+	//{ 1209, 107 },
+	0xc7, 0x0a, 0x05,  // { 1204, 106 }
+	//{ 1254, 104 },
+	0x87, 0x07, 0x05,  // { 1260, 103 }
+	//{ 1350, 102 },
+	//{ 1230, 101 },
+	0xc7, 0x16, 0xcf, 0x01,  // { 1440, -1 }
 };
 
 class MEL__1_Schedule_0 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(255, 96, 128);
 	}
@@ -1481,45 +1483,44 @@ class MEL__1_Schedule_0 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 06:35:00, interval ~2460s
-		{ -116, 182 },
-		{ 55, 181 },
-		{ 196, 180 },
-		{ 259, 179 },
-		{ 399, 128 },
-		{ 492, 127 },
-		{ 508, 126 },
-		{ 543, 125 },
-		{ 660, 124 },
-		{ 674, 123 },
-		{ 775, 122 },
-		{ 789, 121 },
-		{ 860, 120 },
-		{ 899, 119 },
-		{ 929, 118 }, // Was: 896
-		{ 960, 117 },
-		{ 1025, 116 },
-		{ 1030, 114 },
-		{ 1074, 112 },
-		{ 1099, 110 },
-		{ 1120, 109 },
-		//{ 1209, 107 },
-		{ 1204, 106 },
-		//{ 1254, 104 },
-		{ 1260, 103 },
-		//{ 1350, 102 },
-		//{ 1230, 101 },
-		{ 1440, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { MEL__1_Schedule_0_entries, sizeof(MEL__1_Schedule_0_entries), 24, -116, 1440 };
+	}
+};
+
+static const uint8_t MEL__0_Schedule_1_entries[] = {  // First departure: 07:34:00, interval ~960s
+	//{ 23, 100 },
+	//{ -287, 101 },
+	//{ -294, 102 },
+	0xbf, 0x24, 0xce, 0x01,  // { -292, 103 }
+	//{ -224, 104 },
+	0xf7, 0x35, 0x06,  // { 139, 106 }
+	//{ 146, 107 },
+	0xd7, 0x05, 0x06,  // { 184, 109 }
+	0xd3, 0x06,  // { 237, 110 }
+	0xc4, 0x04,  // { 273, 112 }
+	0xc4, 0x01,  // { 285, 114 }
+	0x74,  // { 292, 116 } Was: 276
+	0x83, 0x01,  // { 300, 117 }
+	0xb3, 0x0e,  // { 415, 118 }
+	0x13,  // { 416, 119 }
+	0x43,  // { 420, 120 }
+	0xa3, 0x09,  // { 494, 121 }
+	0xc3, 0x04,  // { 530, 122 }
+	0xa3, 0x07,  // { 588, 123 }
+	0xb3, 0x06,  // { 639, 124 }
+	0xc3, 0x0a,  // { 723, 125 }
+	0xe3, 0x07,  // { 785, 126 }
+	0xe3, 0x04,  // { 823, 127 }
+	0xc3, 0x05,  // { 867, 128 }
+	0xe7, 0x0c, 0x66,  // { 969, 179 }
+	0x83, 0x09,  // { 1041, 180 }
+	0xb3, 0x07,  // { 1100, 181 }
+	0xc7, 0x16, 0xeb, 0x02,  // { 1280, -1 }
 };
 
 class MEL__0_Schedule_1 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(255, 96, 128);
 	}
@@ -1532,45 +1533,42 @@ class MEL__0_Schedule_1 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 07:34:00, interval ~960s
-		//{ 23, 100 },
-		//{ -287, 101 },
-		//{ -294, 102 },
-		{ -292, 103 },
-		//{ -224, 104 },
-		{ 139, 106 },
-		//{ 146, 107 },
-		{ 184, 109 },
-		{ 237, 110 },
-		{ 273, 112 },
-		{ 285, 114 },
-		{ 292, 116 }, // Was: 276
-		{ 300, 117 },
-		{ 415, 118 },
-		{ 416, 119 },
-		{ 420, 120 },
-		{ 494, 121 },
-		{ 530, 122 },
-		{ 588, 123 },
-		{ 639, 124 },
-		{ 723, 125 },
-		{ 785, 126 },
-		{ 823, 127 },
-		{ 867, 128 },
-		{ 969, 179 },
-		{ 1041, 180 },
-		{ 1100, 181 },
-		{ 1280, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { MEL__0_Schedule_1_entries, sizeof(MEL__0_Schedule_1_entries), 23, -292, 1280 };
+	}
+};
+
+static const uint8_t MEL__1_Schedule_1_entries[] = {  // First departure: 07:33:00, interval ~31920s
+	0xff, 0x05, 0xec, 0x02,  // { -48, 182 }
+	0xa1, 0x0e,  // { 66, 181 }
+	0xf1, 0x19,  // { 273, 180 }
+	0xa1, 0x04,  // { 307, 179 }
+	0xc7, 0x17, 0x65,  // { 495, 128 }
+	0x81, 0x01,  // { 503, 127 }
+	0xc1, 0x04,  // { 539, 126 }
+	0xd1, 0x09,  // { 616, 125 }
+	0xb1, 0x05,  // { 659, 124 }
+	0xa1, 0x0f,  // { 781, 123 }
+	0xf1, 0x04,  // { 820, 122 } Was: 775
+	0xf1, 0x04,  // { 859, 121 }
+	0xc1, 0x04,  // { 895, 120 }
+	0xe1, 0x01,  // { 909, 119 }
+	0xe1, 0x08,  // { 979, 118 }
+	0x71,  // { 986, 117 }
+	0xd7, 0x0d, 0x05,  // { 1095, 114 }
+	0xe0, 0x03,  // { 1125, 112 }
+	0xc0, 0x02,  // { 1145, 110 }
+	0x71,  // { 1152, 109 }
+	//{ 1234, 107 },
+	0x97, 0x0b, 0x05,  // { 1241, 106 }
+	//{ 1312, 104 },
+	//{ 1471, 102 },
+	//{ 1287, 101 },
+	0xc7, 0x16, 0xd5, 0x01,  // { 1421, -1 }
 };
 
 class MEL__1_Schedule_1 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(255, 96, 128);
 	}
@@ -1580,43 +1578,84 @@ class MEL__1_Schedule_1 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 07:33:00, interval ~31920s
-		{ -48, 182 },
-		{ 66, 181 },
-		{ 273, 180 },
-		{ 307, 179 },
-		{ 495, 128 },
-		{ 503, 127 },
-		{ 539, 126 },
-		{ 616, 125 },
-		{ 659, 124 },
-		{ 781, 123 },
-		{ 820, 122 }, // Was: 775
-		{ 859, 121 },
-		{ 895, 120 },
-		{ 909, 119 },
-		{ 979, 118 },
-		{ 986, 117 },
-		{ 1095, 114 },
-		{ 1125, 112 },
-		{ 1145, 110 },
-		{ 1152, 109 },
-		//{ 1234, 107 },
-		{ 1241, 106 },
-		//{ 1312, 104 },
-		//{ 1471, 102 },
-		//{ 1287, 101 },
-		{ 1421, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { MEL__1_Schedule_1_entries, sizeof(MEL__1_Schedule_1_entries), 22, -48, 1421 };
+	}
+};
+
+static const uint8_t WRL__1_Schedule_0_entries[] = {  // First departure: 05:46:00, interval ~3660s
+	0xff, 0xaf, 0x05, 0xe4, 0x02,  // { -5504, 178 }
+	0xf1, 0xc8, 0x05,  // { 199, 177 }
+	0xb1, 0x15,  // { 370, 176 }
+	0x91, 0x15,  // { 539, 175 }
+	0xc1, 0x4a,  // { 1135, 174 }
+	0xe1, 0x13,  // { 1293, 173 }
+	0xa1, 0x2b,  // { 1639, 172 }
+	0xa1, 0x0e,  // { 1753, 171 }
+	0x91, 0x24,  // { 2042, 170 }
+	0xc1, 0x10,  // { 2174, 169 }
+	0xf1, 0x2d,  // { 2541, 168 }
+	0xd1, 0x17,  // { 2730, 167 }
+	0xc1, 0x74,  // { 3662, 166 }
+	0xc1, 0x07,  // { 3722, 165 }
+	0x81, 0x01,  // { 3730, 164 }
+	0x91, 0x28,  // { 4051, 163 }
+	0xa1, 0x0c,  // { 4149, 162 }
+	0xa0, 0x1f,  // { 4399, 160 }
+	0x81, 0x03,  // { 4423, 159 }
+	0xc1, 0x02,  // { 4443, 158 } Was: 4415
+	0x91, 0x07,  // { 4500, 157 } Was: 4390
+	0x90, 0x07,  // { 4557, 155 }
+	0x20,  // { 4559, 153 }
+	0x61,  // { 4565, 152 } Was: 4508
+	0x71,  // { 4572, 151 }
+	0xe1, 0x09,  // { 4650, 150 }
+	0x31,  // { 4653, 149 }
+	0x81, 0x12,  // { 4797, 148 }
+	0x41,  // { 4801, 147 }
+	0xf1, 0x0c,  // { 4904, 146 } Was: 4752
+	0xf1, 0x0c,  // { 5007, 145 }
+	0xc1, 0x02,  // { 5027, 144 } Was: 4919
+	0xc1, 0x02,  // { 5047, 143 } Was: 4887
+	0xc1, 0x02,  // { 5067, 142 } Was: 4936
+	0xc1, 0x02,  // { 5087, 141 } Was: 5042
+	0xc1, 0x02,  // { 5107, 140 } Was: 5052
+	0xc1, 0x02,  // { 5127, 139 } Was: 5045
+	0xa1, 0x01,  // { 5137, 138 } Was: 5073
+	0xa1, 0x01,  // { 5147, 137 }
+	0xf1, 0x03,  // { 5178, 136 }
+	0x81, 0x10,  // { 5306, 135 }
+	0x81, 0x01,  // { 5314, 134 }
+	0xa1, 0x06,  // { 5364, 133 }
+	0x91, 0x0b,  // { 5453, 132 }
+	0xe1, 0x08,  // { 5523, 131 }
+	0x91, 0x01,  // { 5532, 130 }
+	0xd1, 0x03,  // { 5561, 129 }
+	0xc1, 0x0b,  // { 5653, 128 }
+	0x71,  // { 5660, 127 }
+	0xc1, 0x01,  // { 5672, 126 }
+	0x81, 0x0c,  // { 5768, 125 }
+	0xa1, 0x0e,  // { 5882, 124 }
+	0xd1, 0x1e,  // { 6127, 123 }
+	0xc1, 0x02,  // { 6147, 122 } Was: 5944
+	0xc1, 0x02,  // { 6167, 121 } Was: 6022
+	0xc1, 0x02,  // { 6187, 120 } Was: 6030
+	0xc1, 0x02,  // { 6207, 119 } Was: 6132
+	0xc1, 0x02,  // { 6227, 118 } Was: 6064
+	0xc1, 0x02,  // { 6247, 117 } Was: 6178
+	0xc1, 0x02,  // { 6267, 116 } Was: 6063
+	0xc0, 0x02,  // { 6287, 114 } Was: 6114
+	0xc0, 0x02,  // { 6307, 112 } Was: 6243
+	0xc0, 0x02,  // { 6327, 110 } Was: 6242
+	0xe1, 0x04,  // { 6365, 109 } Was: 6260
+	0xe0, 0x04,  // { 6403, 107 }
+	//{ 6350, 106 },
+	0xf7, 0x03, 0x05,  // { 6434, 104 }
+	0xc7, 0x25, 0xd1, 0x01,  // { 6734, -1 }
 };
 
 class WRL__1_Schedule_0 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(255, 143, 0);
 	}
@@ -1626,85 +1665,74 @@ class WRL__1_Schedule_0 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 05:46:00, interval ~3660s
-		{ -5504, 178 },
-		{ 199, 177 },
-		{ 370, 176 },
-		{ 539, 175 },
-		{ 1135, 174 },
-		{ 1293, 173 },
-		{ 1639, 172 },
-		{ 1753, 171 },
-		{ 2042, 170 },
-		{ 2174, 169 },
-		{ 2541, 168 },
-		{ 2730, 167 },
-		{ 3662, 166 },
-		{ 3722, 165 },
-		{ 3730, 164 },
-		{ 4051, 163 },
-		{ 4149, 162 },
-		{ 4399, 160 },
-		{ 4423, 159 },
-		{ 4443, 158 }, // Was: 4415
-		{ 4500, 157 }, // Was: 4390
-		{ 4557, 155 },
-		{ 4559, 153 },
-		{ 4565, 152 }, // Was: 4508
-		{ 4572, 151 },
-		{ 4650, 150 },
-		{ 4653, 149 },
-		{ 4797, 148 },
-		{ 4801, 147 },
-		{ 4904, 146 }, // Was: 4752
-		{ 5007, 145 },
-		{ 5027, 144 }, // Was: 4919
-		{ 5047, 143 }, // Was: 4887
-		{ 5067, 142 }, // Was: 4936
-		{ 5087, 141 }, // Was: 5042
-		{ 5107, 140 }, // Was: 5052
-		{ 5127, 139 }, // Was: 5045
-		{ 5137, 138 }, // Was: 5073
-		{ 5147, 137 },
-		{ 5178, 136 },
-		{ 5306, 135 },
-		{ 5314, 134 },
-		{ 5364, 133 },
-		{ 5453, 132 },
-		{ 5523, 131 },
-		{ 5532, 130 },
-		{ 5561, 129 },
-		{ 5653, 128 },
-		{ 5660, 127 },
-		{ 5672, 126 },
-		{ 5768, 125 },
-		{ 5882, 124 },
-		{ 6127, 123 },
-		{ 6147, 122 }, // Was: 5944
-		{ 6167, 121 }, // Was: 6022
-		{ 6187, 120 }, // Was: 6030
-		{ 6207, 119 }, // Was: 6132
-		{ 6227, 118 }, // Was: 6064
-		{ 6247, 117 }, // Was: 6178
-		{ 6267, 116 }, // Was: 6063
-		{ 6287, 114 }, // Was: 6114
-		{ 6307, 112 }, // Was: 6243
-		{ 6327, 110 }, // Was: 6242
-		{ 6365, 109 }, // Was: 6260
-		{ 6403, 107 },
-		//{ 6350, 106 },
-		{ 6434, 104 },
-		{ 6734, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { WRL__1_Schedule_0_entries, sizeof(WRL__1_Schedule_0_entries), 67, -5504, 6734 };
+	}
+};
+
+static const uint8_t WRL__1_Schedule_1_entries[] = {  // First departure: 06:20:00
+	0xaf, 0x97, 0x06, 0xe4, 0x02,  // { -6331, 178 }
+	0xf1, 0xa7, 0x06,  // { 132, 177 }
+	0xe1, 0x17,  // { 322, 176 }
+	0xd1, 0x0e,  // { 439, 175 }
+	0xe1, 0x4f,  // { 1077, 174 }
+	0xf1, 0x1f,  // { 1332, 173 }
+	0xc1, 0x1b,  // { 1552, 172 }
+	0xc1, 0x0b,  // { 1644, 171 }
+	0xb1, 0x32,  // { 2047, 170 }
+	0xd1, 0x0e,  // { 2164, 169 }
+	0x81, 0x37,  // { 2604, 168 }
+	0xb1, 0x13,  // { 2759, 167 }
+	0xd7, 0x78, 0x05,  // { 3724, 164 }
+	0xb1, 0x2c,  // { 4079, 163 }
+	0xc1, 0x0f,  // { 4203, 162 }
+	0x80, 0x1e,  // { 4443, 160 }
+	0xf1, 0x18,  // { 4642, 159 }
+	0xc1, 0x02,  // { 4662, 158 } Was: 4525
+	0xc1, 0x02,  // { 4682, 157 } Was: 4561
+	0xc1, 0x02,  // { 4702, 156 } Was: 4569
+	0xf1, 0x02,  // { 4725, 155 } Was: 4565
+	0xf0, 0x02,  // { 4748, 153 }
+	0xb0, 0x03,  // { 4775, 151 } Was: 4679
+	0xc1, 0x03,  // { 4803, 150 }
+	0x81, 0x01,  // { 4811, 149 }
+	0x81, 0x07,  // { 4867, 148 } Was: 4797
+	0x80, 0x07,  // { 4923, 146 }
+	0xd1, 0x05,  // { 4968, 145 }
+	0xf1, 0x04,  // { 5007, 144 }
+	0xc0, 0x0e,  // { 5123, 142 }
+	0xd1, 0x12,  // { 5272, 141 }
+	0x21,  // { 5274, 140 } Was: 5260
+	0x21,  // { 5276, 139 }
+	0xd1, 0x06,  // { 5329, 138 } Was: 5266
+	0xe1, 0x06,  // { 5383, 137 }
+	0xe1, 0x0b,  // { 5477, 136 }
+	0x91, 0x0f,  // { 5598, 135 }
+	0xf1, 0x0e,  // { 5717, 134 }
+	0xa1, 0x02,  // { 5735, 133 }
+	0xf1, 0x08,  // { 5806, 132 } Was: 5634
+	0x80, 0x09,  // { 5878, 130 }
+	0xb1, 0x05,  // { 5921, 129 }
+	0xa1, 0x05,  // { 5963, 128 }
+	0xc1, 0x0f,  // { 6087, 127 }
+	0x31,  // { 6090, 126 } Was: 6013
+	0x31,  // { 6093, 125 }
+	0xf1, 0x19,  // { 6300, 124 }
+	0xf1, 0x03,  // { 6331, 123 } Was: 6130
+	0x80, 0x04,  // { 6363, 121 }
+	0x87, 0x0f, 0x07,  // { 6483, 117 }
+	0xf7, 0x1c, 0x09,  // { 6714, 112 }
+	0xd0, 0x01,  // { 6727, 110 }
+	0xc1, 0x02,  // { 6747, 109 } Was: 6484
+	0x60,  // { 6753, 107 } Was: 6683
+	//{ 6760, 106 },
+	0x97, 0x15, 0x05,  // { 6922, 104 }
+	//{ 6680, 103 },
+	0xc7, 0x25, 0xd1, 0x01,  // { 7222, -1 }
 };
 
 class WRL__1_Schedule_1 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(255, 143, 0);
 	}
@@ -1714,75 +1742,84 @@ class WRL__1_Schedule_1 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 06:20:00
-		{ -6331, 178 },
-		{ 132, 177 },
-		{ 322, 176 },
-		{ 439, 175 },
-		{ 1077, 174 },
-		{ 1332, 173 },
-		{ 1552, 172 },
-		{ 1644, 171 },
-		{ 2047, 170 },
-		{ 2164, 169 },
-		{ 2604, 168 },
-		{ 2759, 167 },
-		{ 3724, 164 },
-		{ 4079, 163 },
-		{ 4203, 162 },
-		{ 4443, 160 },
-		{ 4642, 159 },
-		{ 4662, 158 }, // Was: 4525
-		{ 4682, 157 }, // Was: 4561
-		{ 4702, 156 }, // Was: 4569
-		{ 4725, 155 }, // Was: 4565
-		{ 4748, 153 },
-		{ 4775, 151 }, // Was: 4679
-		{ 4803, 150 },
-		{ 4811, 149 },
-		{ 4867, 148 }, // Was: 4797
-		{ 4923, 146 },
-		{ 4968, 145 },
-		{ 5007, 144 },
-		{ 5123, 142 },
-		{ 5272, 141 },
-		{ 5274, 140 }, // Was: 5260
-		{ 5276, 139 },
-		{ 5329, 138 }, // Was: 5266
-		{ 5383, 137 },
-		{ 5477, 136 },
-		{ 5598, 135 },
-		{ 5717, 134 },
-		{ 5735, 133 },
-		{ 5806, 132 }, // Was: 5634
-		{ 5878, 130 },
-		{ 5921, 129 },
-		{ 5963, 128 },
-		{ 6087, 127 },
-		{ 6090, 126 }, // Was: 6013
-		{ 6093, 125 },
-		{ 6300, 124 },
-		{ 6331, 123 }, // Was: 6130
-		{ 6363, 121 },
-		{ 6483, 117 },
-		{ 6714, 112 },
-		{ 6727, 110 },
-		{ 6747, 109 }, // Was: 6484
-		{ 6753, 107 }, // Was: 6683
-		//{ 6760, 106 },
-		{ 6922, 104 },
-		//{ 6680, 103 },
-		{ 7222, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { WRL__1_Schedule_1_entries, sizeof(WRL__1_Schedule_1_entries), 56, -6331, 7222 };
+	}
+};
+
+static const uint8_t WRL__0_Schedule_0_entries[] = {  // First departure: 08:21:00, interval ~15840s
+	//{ 144, 103 },
+	0xff, 0x87, 0x02, 0xd0, 0x01,  // { -2112, 104 }
+	//{ 167, 106 },
+	0x97, 0xa9, 0x02, 0x0a,  // { 265, 109 }
+	0xb3, 0x04,  // { 300, 110 }
+	0xf4, 0x09,  // { 379, 112 }
+	0x94, 0x02,  // { 396, 114 }
+	0x64,  // { 402, 116 }
+	0x93, 0x01,  // { 411, 117 }
+	0x43,  // { 415, 118 }
+	0x83, 0x10,  // { 543, 119 }
+	0x44,  // { 547, 121 }
+	0x53,  // { 552, 122 }
+	0xd3, 0x08,  // { 621, 123 }
+	0xd3, 0x03,  // { 650, 124 }
+	0xf3, 0x0f,  // { 777, 125 }
+	0x53,  // { 782, 126 }
+	0xe3, 0x0d,  // { 892, 127 }
+	0xb3, 0x0e,  // { 1007, 128 }
+	0x83, 0x08,  // { 1071, 129 }
+	0xe3, 0x05,  // { 1117, 130 }
+	0x93, 0x07,  // { 1174, 131 }
+	0xf3, 0x02,  // { 1197, 132 } Was: 1144
+	0xf3, 0x02,  // { 1220, 133 }
+	0xa3, 0x01,  // { 1230, 134 }
+	0x83, 0x10,  // { 1358, 135 }
+	0x63,  // { 1364, 136 }
+	0xf3, 0x0c,  // { 1467, 137 }
+	0xe3, 0x01,  // { 1481, 138 }
+	0x83, 0x0c,  // { 1577, 139 }
+	0xe3, 0x0c,  // { 1679, 140 }
+	0xc3, 0x02,  // { 1699, 141 } Was: 1497
+	0xa3, 0x0a,  // { 1781, 142 } Was: 1610
+	0xa3, 0x0a,  // { 1863, 143 }
+	0xc3, 0x02,  // { 1883, 144 } Was: 1737
+	0xc3, 0x02,  // { 1903, 145 } Was: 1717
+	0xc3, 0x02,  // { 1923, 146 } Was: 1740
+	0xc4, 0x02,  // { 1943, 148 } Was: 1804
+	0xc3, 0x02,  // { 1963, 149 } Was: 1860
+	0xc3, 0x02,  // { 1983, 150 } Was: 1870
+	0xc3, 0x02,  // { 2003, 151 } Was: 1915
+	0xa3, 0x06,  // { 2053, 152 } Was: 1980
+	0xa3, 0x06,  // { 2103, 153 }
+	0xc3, 0x02,  // { 2123, 154 } Was: 2038
+	0xd3, 0x01,  // { 2136, 155 } Was: 2100
+	0xe3, 0x01,  // { 2150, 156 }
+	0x83, 0x05,  // { 2190, 157 }
+	0xb3, 0x12,  // { 2337, 158 }
+	0xb4, 0x01,  // { 2348, 160 }
+	//{ -2804, 161 },
+	0x94, 0x19,  // { 2549, 162 } Was: 2230
+	0xa3, 0x19,  // { 2751, 163 }
+	0xe3, 0x1c,  // { 2981, 164 }
+	0x93, 0x14,  // { 3142, 165 }
+	0xe3, 0x1f,  // { 3396, 166 } Was: 3105
+	0xe3, 0x1f,  // { 3650, 167 }
+	0x83, 0x2d,  // { 4010, 168 }
+	0xa3, 0x1f,  // { 4260, 169 }
+	0x83, 0x37,  // { 4700, 170 }
+	0x93, 0x0f,  // { 4821, 171 }
+	0x83, 0x2d,  // { 5181, 172 }
+	0x83, 0x0a,  // { 5261, 173 }
+	0x83, 0x28,  // { 5581, 174 }
+	0xc3, 0x19,  // { 5785, 175 }
+	0x83, 0x52,  // { 6441, 176 }
+	0x83, 0x0f,  // { 6561, 177 }
+	0xe3, 0x43,  // { 7103, 178 }
+	0xc7, 0x25, 0xe5, 0x02,  // { 7403, -1 }
 };
 
 class WRL__0_Schedule_0 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(255, 143, 0);
 	}
@@ -1792,85 +1829,84 @@ class WRL__0_Schedule_0 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 08:21:00, interval ~15840s
-		//{ 144, 103 },
-		{ -2112, 104 },
-		//{ 167, 106 },
-		{ 265, 109 },
-		{ 300, 110 },
-		{ 379, 112 },
-		{ 396, 114 },
-		{ 402, 116 },
-		{ 411, 117 },
-		{ 415, 118 },
-		{ 543, 119 },
-		{ 547, 121 },
-		{ 552, 122 },
-		{ 621, 123 },
-		{ 650, 124 },
-		{ 777, 125 },
-		{ 782, 126 },
-		{ 892, 127 },
-		{ 1007, 128 },
-		{ 1071, 129 },
-		{ 1117, 130 },
-		{ 1174, 131 },
-		{ 1197, 132 }, // Was: 1144
-		{ 1220, 133 },
-		{ 1230, 134 },
-		{ 1358, 135 },
-		{ 1364, 136 },
-		{ 1467, 137 },
-		{ 1481, 138 },
-		{ 1577, 139 },
-		{ 1679, 140 },
-		{ 1699, 141 }, // Was: 1497
-		{ 1781, 142 }, // Was: 1610
-		{ 1863, 143 },
-		{ 1883, 144 }, // Was: 1737
-		{ 1903, 145 }, // Was: 1717
-		{ 1923, 146 }, // Was: 1740
-		{ 1943, 148 }, // Was: 1804
-		{ 1963, 149 }, // Was: 1860
-		{ 1983, 150 }, // Was: 1870
-		{ 2003, 151 }, // Was: 1915
-		{ 2053, 152 }, // Was: 1980
-		{ 2103, 153 },
-		{ 2123, 154 }, // Was: 2038
-		{ 2136, 155 }, // Was: 2100
-		{ 2150, 156 },
-		{ 2190, 157 },
-		{ 2337, 158 },
-		{ 2348, 160 },
-		//{ -2804, 161 },
-		{ 2549, 162 }, // Was: 2230
-		{ 2751, 163 },
-		{ 2981, 164 },
-		{ 3142, 165 },
-		{ 3396, 166 }, // Was: 3105
-		{ 3650, 167 },
-		{ 4010, 168 },
-		{ 4260, 169 },
-		{ 4700, 170 },
-		{ 4821, 171 },
-		{ 5181, 172 },
-		{ 5261, 173 },
-		{ 5581, 174 },
-		{ 5785, 175 },
-		{ 6441, 176 },
-		{ 6561, 177 },
-		{ 7103, 178 },
-		{ 7403, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { WRL__0_Schedule_0_entries, sizeof(WRL__0_Schedule_0_entries), 65, -2112, 7403 };
+	}
+};
+
+static const uint8_t WRL__1_Schedule_2_entries[] = {  // First departure: 10:30:00, interval ~18480s
+	0xbf, 0xd4, 0x01, 0xe4, 0x02,  // { -1700, 178 }
+	0xc1, 0xec, 0x01,  // { 192, 177 }
+	0xc1, 0x13,  // { 348, 176 }
+	0x81, 0x1b,  // { 564, 175 }
+	0xc1, 0x5a,  // { 1288, 174 }
+	0xe1, 0x10,  // { 1422, 173 }
+	0xa1, 0x28,  // { 1744, 172 }
+	0xb1, 0x07,  // { 1803, 171 }
+	0xb1, 0x26,  // { 2110, 170 }
+	0xa1, 0x10,  // { 2240, 169 }
+	0xd1, 0x2e,  // { 2613, 168 }
+	0xe1, 0x1c,  // { 2843, 167 }
+	0xf1, 0x73,  // { 3770, 166 }
+	0xc1, 0x02,  // { 3790, 165 }
+	0x81, 0x06,  // { 3838, 164 }
+	0xa1, 0x10,  // { 3968, 163 }
+	0xe1, 0x17,  // { 4158, 162 }
+	//{ 7104, 161 },
+	0x90, 0x14,  // { 4319, 160 }
+	0xc1, 0x0e,  // { 4435, 159 }
+	0xf1, 0x07,  // { 4498, 158 } Was: 4330
+	0xf1, 0x07,  // { 4561, 157 }
+	0x20,  // { 4563, 155 } Was: 4440
+	0x21,  // { 4565, 154 }
+	0x81, 0x04,  // { 4597, 153 } Was: 4560
+	0x91, 0x04,  // { 4630, 152 }
+	0xe1, 0x02,  // { 4652, 151 } Was: 4560
+	0xf1, 0x02,  // { 4675, 150 }
+	0x81, 0x1e,  // { 4915, 149 }
+	0xc1, 0x02,  // { 4935, 148 } Was: 4742
+	0xc1, 0x02,  // { 4955, 147 } Was: 4799
+	0xc1, 0x02,  // { 4975, 146 } Was: 4760
+	0xc1, 0x02,  // { 4995, 145 } Was: 4902
+	0xc1, 0x02,  // { 5015, 144 } Was: 4867
+	0xc1, 0x02,  // { 5035, 143 } Was: 4858
+	0xc1, 0x02,  // { 5055, 142 } Was: 4940
+	0xc0, 0x02,  // { 5075, 140 } Was: 5035
+	0xc1, 0x02,  // { 5095, 139 } Was: 4917
+	0x90, 0x02,  // { 5112, 137 } Was: 5040
+	0xa1, 0x02,  // { 5130, 136 }
+	0xe1, 0x0d,  // { 5240, 135 }
+	0xa1, 0x01,  // { 5250, 134 }
+	0xe1, 0x0d,  // { 5360, 133 }
+	0x91, 0x0b,  // { 5449, 132 }
+	0xe1, 0x04,  // { 5487, 131 } Was: 5399
+	0xe1, 0x04,  // { 5525, 130 }
+	0xc1, 0x02,  // { 5545, 129 } Was: 5441
+	0xb1, 0x03,  // { 5572, 128 } Was: 5519
+	0xc1, 0x03,  // { 5600, 127 }
+	0xd1, 0x09,  // { 5677, 126 }
+	0xc1, 0x07,  // { 5737, 125 }
+	0xa1, 0x11,  // { 5875, 124 }
+	0x21,  // { 5877, 123 } Was: 5836
+	0x21,  // { 5879, 122 }
+	0xd1, 0x09,  // { 5956, 121 }
+	0x91, 0x04,  // { 5989, 120 }
+	0x91, 0x0f,  // { 6110, 119 }
+	0x71,  // { 6117, 118 } Was: 6003
+	0x81, 0x01,  // { 6125, 117 }
+	0xa1, 0x1c,  // { 6351, 116 }
+	0xc0, 0x02,  // { 6371, 114 } Was: 6238
+	0xb0, 0x13,  // { 6526, 112 } Was: 6235
+	0xb0, 0x13,  // { 6681, 110 }
+	0xc1, 0x02,  // { 6701, 109 } Was: 6325
+	0xc0, 0x02,  // { 6721, 107 } Was: 6330
+	//{ 6297, 106 },
+	0xc7, 0x02, 0x05,  // { 6741, 104 } Was: 6395
+	0x87, 0x1e, 0xd1, 0x01,  // { 6981, -1 }
 };
 
 class WRL__1_Schedule_2 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(255, 143, 0);
 	}
@@ -1880,85 +1916,78 @@ class WRL__1_Schedule_2 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 10:30:00, interval ~18480s
-		{ -1700, 178 },
-		{ 192, 177 },
-		{ 348, 176 },
-		{ 564, 175 },
-		{ 1288, 174 },
-		{ 1422, 173 },
-		{ 1744, 172 },
-		{ 1803, 171 },
-		{ 2110, 170 },
-		{ 2240, 169 },
-		{ 2613, 168 },
-		{ 2843, 167 },
-		{ 3770, 166 },
-		{ 3790, 165 },
-		{ 3838, 164 },
-		{ 3968, 163 },
-		{ 4158, 162 },
-		//{ 7104, 161 },
-		{ 4319, 160 },
-		{ 4435, 159 },
-		{ 4498, 158 }, // Was: 4330
-		{ 4561, 157 },
-		{ 4563, 155 }, // Was: 4440
-		{ 4565, 154 },
-		{ 4597, 153 }, // Was: 4560
-		{ 4630, 152 },
-		{ 4652, 151 }, // Was: 4560
-		{ 4675, 150 },
-		{ 4915, 149 },
-		{ 4935, 148 }, // Was: 4742
-		{ 4955, 147 }, // Was: 4799
-		{ 4975, 146 }, // Was: 4760
-		{ 4995, 145 }, // Was: 4902
-		{ 5015, 144 }, // Was: 4867
-		{ 5035, 143 }, // Was: 4858
-		{ 5055, 142 }, // Was: 4940
-		{ 5075, 140 }, // Was: 5035
-		{ 5095, 139 }, // Was: 4917
-		{ 5112, 137 }, // Was: 5040
-		{ 5130, 136 },
-		{ 5240, 135 },
-		{ 5250, 134 },
-		{ 5360, 133 },
-		{ 5449, 132 },
-		{ 5487, 131 }, // Was: 5399
-		{ 5525, 130 },
-		{ 5545, 129 }, // Was: 5441
-		{ 5572, 128 }, // Was: 5519
-		{ 5600, 127 },
-		{ 5677, 126 },
-		{ 5737, 125 },
-		{ 5875, 124 },
-		{ 5877, 123 }, // Was: 5836
-		{ 5879, 122 },
-		{ 5956, 121 },
-		{ 5989, 120 },
-		{ 6110, 119 },
-		{ 6117, 118 }, // Was: 6003
-		{ 6125, 117 },
-		{ 6351, 116 },
-		{ 6371, 114 }, // Was: 6238
-		{ 6526, 112 }, // Was: 6235
-		{ 6681, 110 },
-		{ 6701, 109 }, // Was: 6325
-		{ 6721, 107 }, // Was: 6330
-		//{ 6297, 106 },
-		{ 6741, 104 }, // Was: 6395
-		{ 6981, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { WRL__1_Schedule_2_entries, sizeof(WRL__1_Schedule_2_entries), 66, -1700, 6981 };
+	}
+};
+
+static const uint8_t WRL__0_Schedule_3_entries[] = {  // First departure: 18:18:00
+	0xff, 0x9a, 0x02, 0xd0, 0x01,  // { -2264, 104 }
+	//{ 160, 106 },
+	0xc7, 0xa7, 0x02, 0x06,  // { 100, 107 }
+	0xa4, 0x15,  // { 270, 109 }
+	0x97, 0x08, 0x06,  // { 335, 112 }
+	0xd4, 0x0e,  // { 452, 114 }
+	0xc4, 0x02,  // { 472, 116 } Was: 400
+	0xc3, 0x02,  // { 492, 117 } Was: 387
+	0xc3, 0x02,  // { 512, 118 } Was: 455
+	0xc3, 0x02,  // { 532, 119 } Was: 465
+	0x84, 0x03,  // { 556, 121 } Was: 485
+	0x83, 0x03,  // { 580, 122 }
+	0xc3, 0x02,  // { 600, 123 }
+	0xf3, 0x0b,  // { 695, 124 }
+	0xb3, 0x03,  // { 722, 125 }
+	0xc4, 0x10,  // { 854, 127 }
+	0xf3, 0x11,  // { 997, 128 }
+	0xd3, 0x06,  // { 1050, 129 }
+	0x83, 0x13,  // { 1202, 130 }
+	0xc3, 0x02,  // { 1222, 131 } Was: 1122
+	0x93, 0x0b,  // { 1311, 132 } Was: 1180
+	0xa3, 0x0b,  // { 1401, 133 }
+	0x94, 0x01,  // { 1410, 135 } Was: 1313
+	0xa3, 0x01,  // { 1420, 136 }
+	0x83, 0x0f,  // { 1540, 137 }
+	0x94, 0x08,  // { 1605, 139 } Was: 1472
+	0x93, 0x08,  // { 1670, 140 }
+	0xd4, 0x15,  // { 1843, 142 }
+	0x93, 0x05,  // { 1884, 143 } Was: 1778
+	0x93, 0x05,  // { 1925, 144 }
+	0xb3, 0x04,  // { 1960, 145 }
+	0xf3, 0x0b,  // { 2055, 146 } Was: 1898
+	0x83, 0x0c,  // { 2151, 147 }
+	0xc3, 0x02,  // { 2171, 148 } Was: 2044
+	0xc4, 0x02,  // { 2191, 150 } Was: 2097
+	0xd3, 0x01,  // { 2204, 151 } Was: 2107
+	0xd4, 0x01,  // { 2217, 153 }
+	0x83, 0x05,  // { 2257, 154 } Was: 2170
+	0x83, 0x05,  // { 2297, 155 }
+	0xc3, 0x02,  // { 2317, 156 } Was: 2203
+	0xc3, 0x02,  // { 2337, 157 } Was: 2136
+	0xf3, 0x03,  // { 2368, 158 } Was: 2155
+	0x83, 0x04,  // { 2400, 159 }
+	0xd3, 0x0f,  // { 2525, 160 }
+	0x94, 0x02,  // { 2542, 162 }
+	0xc3, 0x11,  // { 2682, 163 }
+	0x93, 0x21,  // { 2947, 164 }
+	0x93, 0x0d,  // { 3052, 165 }
+	0xd3, 0x0a,  // { 3137, 166 }
+	0xb3, 0x4e,  // { 3764, 167 }
+	0xd3, 0x29,  // { 4097, 168 }
+	0x93, 0x21,  // { 4362, 169 }
+	0x83, 0x32,  // { 4762, 170 }
+	0x83, 0x0f,  // { 4882, 171 }
+	0x83, 0x28,  // { 5202, 172 }
+	0xe3, 0x08,  // { 5272, 173 }
+	0xc3, 0x2a,  // { 5612, 174 }
+	0x93, 0x0d,  // { 5717, 175 }
+	0x83, 0x4d,  // { 6333, 176 }
+	0xd3, 0x12,  // { 6482, 177 }
+	0xc3, 0x08,  // { 6550, 178 }
+	0xc7, 0x25, 0xe5, 0x02,  // { 6850, -1 }
 };
 
 class WRL__0_Schedule_3 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(255, 143, 0);
 	}
@@ -1968,79 +1997,76 @@ class WRL__0_Schedule_3 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 18:18:00
-		{ -2264, 104 },
-		//{ 160, 106 },
-		{ 100, 107 },
-		{ 270, 109 },
-		{ 335, 112 },
-		{ 452, 114 },
-		{ 472, 116 }, // Was: 400
-		{ 492, 117 }, // Was: 387
-		{ 512, 118 }, // Was: 455
-		{ 532, 119 }, // Was: 465
-		{ 556, 121 }, // Was: 485
-		{ 580, 122 },
-		{ 600, 123 },
-		{ 695, 124 },
-		{ 722, 125 },
-		{ 854, 127 },
-		{ 997, 128 },
-		{ 1050, 129 },
-		{ 1202, 130 },
-		{ 1222, 131 }, // Was: 1122
-		{ 1311, 132 }, // Was: 1180
-		{ 1401, 133 },
-		{ 1410, 135 }, // Was: 1313
-		{ 1420, 136 },
-		{ 1540, 137 },
-		{ 1605, 139 }, // Was: 1472
-		{ 1670, 140 },
-		{ 1843, 142 },
-		{ 1884, 143 }, // Was: 1778
-		{ 1925, 144 },
-		{ 1960, 145 },
-		{ 2055, 146 }, // Was: 1898
-		{ 2151, 147 },
-		{ 2171, 148 }, // Was: 2044
-		{ 2191, 150 }, // Was: 2097
-		{ 2204, 151 }, // Was: 2107
-		{ 2217, 153 },
-		{ 2257, 154 }, // Was: 2170
-		{ 2297, 155 },
-		{ 2317, 156 }, // Was: 2203
-		{ 2337, 157 }, // Was: 2136
-		{ 2368, 158 }, // Was: 2155
-		{ 2400, 159 },
-		{ 2525, 160 },
-		{ 2542, 162 },
-		{ 2682, 163 },
-		{ 2947, 164 },
-		{ 3052, 165 },
-		{ 3137, 166 },
-		{ 3764, 167 },
-		{ 4097, 168 },
-		{ 4362, 169 },
-		{ 4762, 170 },
-		{ 4882, 171 },
-		{ 5202, 172 },
-		{ 5272, 173 },
-		{ 5612, 174 },
-		{ 5717, 175 },
-		{ 6333, 176 },
-		{ 6482, 177 },
-		{ 6550, 178 },
-		{ 6850, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { WRL__0_Schedule_3_entries, sizeof(WRL__0_Schedule_3_entries), 61, -2264, 6850 };
+	}
+};
+
+static const uint8_t WRL__0_Schedule_2_entries[] = {  // First departure: 17:30:00
+	//{ -1024, 103 },
+	//{ 119, 106 },
+	0x97, 0x0b, 0xd6, 0x01,  // { 89, 107 }
+	0xa4, 0x11,  // { 227, 109 }
+	0x83, 0x75,  // { 1163, 110 }
+	0xc4, 0x02,  // { 1183, 112 } Was: 326
+	0xc7, 0x02, 0x08,  // { 1203, 116 } Was: 333
+	0xf3, 0x3b,  // { 1682, 117 } Was: 353
+	0xf3, 0x3b,  // { 2161, 118 }
+	0xc3, 0x02,  // { 2181, 119 } Was: 1328
+	0xc4, 0x02,  // { 2201, 121 } Was: 486
+	0xc3, 0x02,  // { 2221, 122 } Was: 490
+	0xc3, 0x02,  // { 2241, 123 } Was: 582
+	0xc3, 0x02,  // { 2261, 124 } Was: 640
+	0xc3, 0x02,  // { 2281, 125 } Was: 718
+	0xc4, 0x02,  // { 2301, 127 } Was: 832
+	0xc3, 0x02,  // { 2321, 128 } Was: 915
+	0xf3, 0x1a,  // { 2536, 129 } Was: 962
+	0xf3, 0x1a,  // { 2751, 130 }
+	0xc3, 0x02,  // { 2771, 131 } Was: 1039
+	0xc3, 0x02,  // { 2791, 132 } Was: 1117
+	0xc3, 0x02,  // { 2811, 133 } Was: 1988
+	0xc4, 0x02,  // { 2831, 135 } Was: 1310
+	0xc3, 0x02,  // { 2851, 136 } Was: 1302
+	0xc3, 0x02,  // { 2871, 137 } Was: 1457
+	0xc3, 0x02,  // { 2891, 138 } Was: 1477
+	0xc3, 0x02,  // { 2911, 139 } Was: 1487
+	0xd3, 0x14,  // { 3076, 140 } Was: 1497
+	0xd3, 0x14,  // { 3241, 141 }
+	0xc3, 0x02,  // { 3261, 142 } Was: 1555
+	0xc4, 0x02,  // { 3281, 144 } Was: 1623
+	0xc3, 0x02,  // { 3301, 145 } Was: 2458
+	0xc3, 0x02,  // { 3321, 146 } Was: 1732
+	0xc4, 0x02,  // { 3341, 148 } Was: 1742
+	0xc4, 0x02,  // { 3361, 150 } Was: 1921
+	0xc3, 0x02,  // { 3381, 151 } Was: 2698
+	0xc4, 0x02,  // { 3401, 153 } Was: 1973
+	0xc4, 0x1b,  // { 3621, 155 } Was: 2063
+	0xd3, 0x1b,  // { 3842, 156 }
+	0xc3, 0x02,  // { 3862, 157 } Was: 2117
+	0xe3, 0x06,  // { 3916, 158 } Was: 2165
+	0xf4, 0x06,  // { 3971, 160 }
+	0xc4, 0x02,  // { 3991, 162 } Was: 2338
+	0xc3, 0x02,  // { 4011, 163 } Was: 2523
+	0xc3, 0x02,  // { 4031, 164 } Was: 2697
+	0xc3, 0x02,  // { 4051, 165 } Was: 2823
+	0xc3, 0x02,  // { 4071, 166 } Was: 2928
+	0xc3, 0x02,  // { 4091, 167 } Was: 3503
+	0xa3, 0x03,  // { 4117, 168 } Was: 3882
+	0xa3, 0x03,  // { 4143, 169 }
+	0xb3, 0x39,  // { 4602, 170 }
+	0xb3, 0x13,  // { 4757, 171 }
+	0xb3, 0x22,  // { 5032, 172 }
+	0xb3, 0x0b,  // { 5123, 173 }
+	0xf3, 0x27,  // { 5442, 174 }
+	0xd3, 0x16,  // { 5623, 175 }
+	0xc3, 0x46,  // { 6187, 176 }
+	0xf3, 0x1a,  // { 6402, 177 }
+	0xd3, 0x14,  // { 6567, 178 }
+	0xc7, 0x25, 0xe5, 0x02,  // { 6867, -1 }
 };
 
 class WRL__0_Schedule_2 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(255, 143, 0);
 	}
@@ -2050,77 +2076,59 @@ class WRL__0_Schedule_2 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 17:30:00
-		//{ -1024, 103 },
-		//{ 119, 106 },
-		{ 89, 107 },
-		{ 227, 109 },
-		{ 1163, 110 },
-		{ 1183, 112 }, // Was: 326
-		{ 1203, 116 }, // Was: 333
-		{ 1682, 117 }, // Was: 353
-		{ 2161, 118 },
-		{ 2181, 119 }, // Was: 1328
-		{ 2201, 121 }, // Was: 486
-		{ 2221, 122 }, // Was: 490
-		{ 2241, 123 }, // Was: 582
-		{ 2261, 124 }, // Was: 640
-		{ 2281, 125 }, // Was: 718
-		{ 2301, 127 }, // Was: 832
-		{ 2321, 128 }, // Was: 915
-		{ 2536, 129 }, // Was: 962
-		{ 2751, 130 },
-		{ 2771, 131 }, // Was: 1039
-		{ 2791, 132 }, // Was: 1117
-		{ 2811, 133 }, // Was: 1988
-		{ 2831, 135 }, // Was: 1310
-		{ 2851, 136 }, // Was: 1302
-		{ 2871, 137 }, // Was: 1457
-		{ 2891, 138 }, // Was: 1477
-		{ 2911, 139 }, // Was: 1487
-		{ 3076, 140 }, // Was: 1497
-		{ 3241, 141 },
-		{ 3261, 142 }, // Was: 1555
-		{ 3281, 144 }, // Was: 1623
-		{ 3301, 145 }, // Was: 2458
-		{ 3321, 146 }, // Was: 1732
-		{ 3341, 148 }, // Was: 1742
-		{ 3361, 150 }, // Was: 1921
-		{ 3381, 151 }, // Was: 2698
-		{ 3401, 153 }, // Was: 1973
-		{ 3621, 155 }, // Was: 2063
-		{ 3842, 156 },
-		{ 3862, 157 }, // Was: 2117
-		{ 3916, 158 }, // Was: 2165
-		{ 3971, 160 },
-		{ 3991, 162 }, // Was: 2338
-		{ 4011, 163 }, // Was: 2523
-		{ 4031, 164 }, // Was: 2697
-		{ 4051, 165 }, // Was: 2823
-		{ 4071, 166 }, // Was: 2928
-		{ 4091, 167 }, // Was: 3503
-		{ 4117, 168 }, // Was: 3882
-		{ 4143, 169 },
-		{ 4602, 170 },
-		{ 4757, 171 },
-		{ 5032, 172 },
-		{ 5123, 173 },
-		{ 5442, 174 },
-		{ 5623, 175 },
-		{ 6187, 176 },
-		{ 6402, 177 },
-		{ 6567, 178 },
-		{ 6867, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { WRL__0_Schedule_2_entries, sizeof(WRL__0_Schedule_2_entries), 58, 89, 6867 };
+	}
+};
+
+static const uint8_t WRL__0_Schedule_1_entries[] = {  // First departure: 16:25:00
+	0xd7, 0xa7, 0x01, 0xd0, 0x01,  // { 1341, 104 }
+	//{ 1221, 106 },
+	0x87, 0x3c, 0x06,  // { 1821, 107 } Was: 1101
+	0x84, 0x3c,  // { 2301, 109 }
+	0xc7, 0x02, 0x06,  // { 2321, 112 }
+	0xc7, 0x0c, 0x0a,  // { 2421, 117 }
+	0x87, 0x14, 0x0a,  // { 2581, 122 }
+	0x83, 0x0a,  // { 2661, 123 }
+	0xc3, 0x02,  // { 2681, 124 }
+	0xa3, 0x10,  // { 2811, 125 }
+	0xa7, 0x0b, 0x06,  // { 2901, 128 }
+	0xa3, 0x10,  // { 3031, 129 }
+	0xe7, 0x12, 0x06,  // { 3181, 132 }
+	0x97, 0x0f, 0x08,  // { 3302, 136 }
+	0xf4, 0x18,  // { 3501, 138 }
+	0xa3, 0x01,  // { 3511, 139 }
+	0xa3, 0x01,  // { 3521, 140 }
+	0xc7, 0x11, 0x08,  // { 3661, 144 }
+	0xa7, 0x10, 0x08,  // { 3791, 148 }
+	0xe7, 0x0d, 0x06,  // { 3901, 151 }
+	0x84, 0x0f,  // { 4021, 153 }
+	0xa3, 0x01,  // { 4031, 154 }
+	0xe3, 0x08,  // { 4101, 155 }
+	0xa3, 0x06,  // { 4151, 156 }
+	0xf7, 0x0d, 0x06,  // { 4262, 159 }
+	0x93, 0x01,  // { 4271, 160 }
+	0xd4, 0x09,  // { 4348, 162 }
+	0xd3, 0x10,  // { 4481, 163 }
+	0xc3, 0x20,  // { 4741, 164 }
+	0xc3, 0x0b,  // { 4833, 165 }
+	0xe3, 0x0e,  // { 4951, 166 }
+	0xe3, 0x3f,  // { 5461, 167 }
+	0xe3, 0x35,  // { 5891, 168 }
+	0xc3, 0x16,  // { 6071, 169 }
+	0xa3, 0x38,  // { 6521, 170 }
+	0x83, 0x14,  // { 6681, 171 }
+	0xc3, 0x25,  // { 6981, 172 }
+	0x83, 0x0f,  // { 7101, 173 }
+	0xa3, 0x24,  // { 7391, 174 }
+	0x83, 0x1e,  // { 7631, 175 }
+	0x83, 0x4b,  // { 8231, 176 }
+	0xe3, 0x17,  // { 8421, 177 }
+	0xc7, 0x25, 0xe3, 0x02,  // { 8721, -1 }
 };
 
 class WRL__0_Schedule_1 : public TrainRoute {
   public:
-	const std::vector<TimetableEntry>& getEntries() const override {
-		return timetable;
-	}
-
 	CRGB getColor() const override {
 		return CRGB(255, 143, 0);
 	}
@@ -2130,52 +2138,9 @@ class WRL__0_Schedule_1 : public TrainRoute {
 		return startTimes;
 	}
 
-  private:
-	static const inline std::vector<TimetableEntry> timetable = {  // First departure: 16:25:00
-		{ 1341, 104 },
-		//{ 1221, 106 },
-		{ 1821, 107 }, // Was: 1101
-		{ 2301, 109 },
-		{ 2321, 112 },
-		{ 2421, 117 },
-		{ 2581, 122 },
-		{ 2661, 123 },
-		{ 2681, 124 },
-		{ 2811, 125 },
-		{ 2901, 128 },
-		{ 3031, 129 },
-		{ 3181, 132 },
-		{ 3302, 136 },
-		{ 3501, 138 },
-		{ 3511, 139 },
-		{ 3521, 140 },
-		{ 3661, 144 },
-		{ 3791, 148 },
-		{ 3901, 151 },
-		{ 4021, 153 },
-		{ 4031, 154 },
-		{ 4101, 155 },
-		{ 4151, 156 },
-		{ 4262, 159 },
-		{ 4271, 160 },
-		{ 4348, 162 },
-		{ 4481, 163 },
-		{ 4741, 164 },
-		{ 4833, 165 },
-		{ 4951, 166 },
-		{ 5461, 167 },
-		{ 5891, 168 },
-		{ 6071, 169 },
-		{ 6521, 170 },
-		{ 6681, 171 },
-		{ 6981, 172 },
-		{ 7101, 173 },
-		{ 7391, 174 },
-		{ 7631, 175 },
-		{ 8231, 176 },
-		{ 8421, 177 },
-		{ 8721, -1 }
-	};
+	TimetableData getTimetable() const override {
+		return { WRL__0_Schedule_1_entries, sizeof(WRL__0_Schedule_1_entries), 42, 1341, 8721 };
+	}
 };
 
 // === Global List of Routes ===
@@ -4,8 +4,12 @@
 #include <Preferences.h>
 #include <WiFi.h>
 
-// Preferences is in main.cpp
+#include "log.h"
+#include "recordStore.h"
+
+// Preferences and RecordStore are in main.cpp
 extern Preferences preferences;
+extern RecordStore recordStore;
 
 ImprovWiFi improvSerial(&Serial);
 AsyncWebServer server(80);
@@ -28,23 +32,27 @@ savedWiFiNetwork savedWiFi[MAX_WIFI_NETWORKS];	// Array to hold saved WiFi netwo
 void setUpWebserver(AsyncWebServer &server);
 
 void onImprovWiFiErrorCb(ImprovTypes::Error err) {
-	Serial.printf("Improv WiFi Error: %d\n", err);
+	LOG_E("Improv WiFi Error: %d", err);
 	server.end();
 	server.begin();
 }
 
-// Save WiFi credentials to Preferences (NVS Flash Partition)
+// Save WiFi credentials to the record store
 void exportWiFi() {
-	preferences.begin("wifi");
-	preferences.putBytes("wifi", savedWiFi, sizeof(savedWiFi));
-	preferences.end();
+	recordStore.put(RECORD_WIFI, savedWiFi, sizeof(savedWiFi));
 }
 
-// Read WiFi credentials from Preferences (NVS Flash Partition)
+// Read WiFi credentials from the record store, or once from Preferences (NVS) where older firmware kept them
 void importWiFi() {
+	if (recordStore.get(RECORD_WIFI, savedWiFi, sizeof(savedWiFi))) {
+		return;
+	}
 	preferences.begin("wifi", true);
-	preferences.getBytes("wifi", savedWiFi, sizeof(savedWiFi));
+	size_t loaded = preferences.getBytes("wifi", savedWiFi, sizeof(savedWiFi));
 	preferences.end();
+	if (loaded == sizeof(savedWiFi)) {
+		exportWiFi();
+	}
 }
 
 void onImprovWiFiConnectedCb(const char *ssid, const char *password) {
@@ -144,7 +152,7 @@ void setUpWebserver(AsyncWebServer &server) {
 		response->addHeader(
 			"Cache-Control", "public,max-age=31536000");  // save this file to cache for 1 year (unless you refresh)
 		request->send(response);
-		Serial.println("Served Basic HTML Page");
+		LOG_D("Served Basic HTML Page");
 	});
 }
 
@@ -178,7 +186,7 @@ void manageWiFiConnection() {
 
 		if (strlen(savedWiFi[wifiNetworkIndex].ssid) != 0) {
 			// Attempt to connect to the current network
-			Serial.printf("Attempting to connect to saved network %i: %s\n", wifiNetworkIndex, savedWiFi[wifiNetworkIndex].ssid);
+			LOG_I("Attempting to connect to saved network %i: %s", wifiNetworkIndex, savedWiFi[wifiNetworkIndex].ssid);
 			WiFi.begin(savedWiFi[wifiNetworkIndex].ssid, savedWiFi[wifiNetworkIndex].password);
 			lastWiFiConnectAttempt = millis();
 		}
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <Arduino.h>
+#include <AsyncTCP.h>
+
+#include "feedClient.h"
+#include "log.h"
+
+/**
+ * @brief Non-blocking feed fetch on the AsyncTCP event task
+ *
+ * Same job as FeedClient, without holding up the caller: get() sends the request (or
+ * starts the connection) and returns, and the response is decoded by HttpResponse inside
+ * AsyncTCP's receive callback as the segments arrive, so the body reaches the sink without
+ * a task of its own or a socket buffer in between. The loop calls poll() once a pass to
+ * collect the result and enforce the deadline.
+ *
+ * The sink runs on the AsyncTCP task, so everything it writes must be left alone by the
+ * caller until poll() has returned a result. The kept-alive connection is reused for the
+ * next request to the same host, and a stale one is retried once on a fresh connection.
+ */
+class AsyncFeedClient {
+  public:
+	AsyncFeedClient() {
+		lock = xSemaphoreCreateRecursiveMutex();
+		client.onConnect([this](void*, AsyncClient*) { onConnect(); });
+		client.onData([this](void*, AsyncClient*, void* data, size_t length) { onData(static_cast<uint8_t*>(data), length); });
+		client.onDisconnect([this](void*, AsyncClient*) { onDisconnect(); });
+		client.onError([this](void*, AsyncClient*, int8_t error) { onError(error); });
+	}
+
+	/**
+	 * @brief Start fetching a URL, the result is collected with poll()
+	 *
+	 * @param url http://host[:port]/path
+	 * @param validators Sent as If-None-Match / If-Modified-Since, updated on a 200
+	 * @param sink Called with the decoded body as it arrives, on the AsyncTCP task
+	 * @param timeoutMs Deadline for the whole request
+	 */
+	void get(const char* url, FeedValidators& validators, BodySink sink, uint32_t timeoutMs = 5000) {
+		xSemaphoreTakeRecursive(lock, portMAX_DELAY);
+		this->sink = sink;
+		this->validators = &validators;
+		deadline = millis() + timeoutMs;
+		startMicros = micros();
+		connectMicros = 0;
+		firstByteMicros = 0;
+		totalMicros = 0;
+		active = true;
+		done = false;
+		retry = false;
+		bodyBytes = 0;
+		response.contentType[0] = '\0';
+
+		char newHost[FEED_HOST_LEN];
+		uint16_t newPort;
+		if (!parseFeedUrl(url, newHost, newPort, path)) {
+			finish(FEED_ERROR_URL);
+		} else {
+			reused = client.connected() && port == newPort && strcmp(host, newHost) == 0;
+			if (!reused) {
+				strncpy(host, newHost, sizeof(host));
+				port = newPort;
+			}
+			start();
+		}
+		xSemaphoreGiveRecursive(lock);
+	}
+
+	/// A request has been started and its result not yet collected
+	bool busy() const {
+		return active;
+	}
+
+	/**
+	 * @brief Check on the request in flight, never waits
+	 *
+	 * @return int FEED_PENDING until the request finishes, then (once) the HTTP status or a negative FEED_ERROR_* code
+	 */
+	int poll() {
+		if (!active || xSemaphoreTakeRecursive(lock, 0) != pdTRUE) {
+			return FEED_PENDING;  // Idle, or a segment is being decoded right now
+		}
+		if (retry) {
+			retry = false;
+			reused = false;
+			start();
+		}
+		if (!done && int32_t(deadline - millis()) <= 0) {
+			response.abort();
+			finish(FEED_ERROR_TIMEOUT);
+		}
+
+		int status = FEED_PENDING;
+		if (done) {
+			if (result < 0 || !response.keepAlive) {
+				close();
+			}
+			active = false;
+			status = result;
+		}
+		xSemaphoreGiveRecursive(lock);
+		return status;
+	}
+
+	/// Content-Type of the last response (without parameters)
+	const char* getContentType() const {
+		return response.contentType;
+	}
+
+	// Timing of the last request, in microseconds from get()
+	uint32_t connectMicros = 0;	   // Connection established (0 if reused)
+	uint32_t firstByteMicros = 0;  // Status line received
+	uint32_t totalMicros = 0;	   // Body complete
+	uint32_t bodyBytes = 0;		   // Decoded body size
+	bool reused = false;		   // Kept-alive connection was used
+
+  private:
+	AsyncClient client;
+	SemaphoreHandle_t lock;	 // Between the callbacks on the AsyncTCP task and the caller (recursive, close() calls back)
+	char host[FEED_HOST_LEN] = "";
+	uint16_t port = 0;
+	char path[FEED_PATH_LEN];
+	char request[FEED_BUFFER_LEN / 2];
+	HttpResponse response;
+	FeedValidators* validators = nullptr;
+	BodySink sink;
+	uint32_t deadline = 0;
+	uint32_t startMicros = 0;
+	int result = FEED_PENDING;
+	volatile bool active = false;  // Between get() and the poll() returning the result
+	bool done = false;			   // Result is set, callbacks ignore the connection from here on
+	bool retry = false;			   // Reused connection was stale, poll() reconnects
+	bool closing = false;		   // Our own close(), its disconnect callback is not a result
+
+	// Send on the open connection or open one, with the lock held
+	void start() {
+		response.begin(*validators, sink);
+		if (reused) {
+			send();
+			return;
+		}
+		close();
+		if (!client.connect(host, port)) {
+			finish(FEED_ERROR_CONNECT);
+		}
+	}
+
+	void close() {
+		closing = true;
+		client.close(true);
+		closing = false;
+	}
+
+	void send() {
+		int length = formatFeedRequest(request, sizeof(request), host, path, *validators);
+		if (length < 0 || client.write(request, length) != size_t(length)) {
+			finish(FEED_ERROR_PROTOCOL);
+		}
+	}
+
+	void finish(int status) {
+		result = status;
+		bodyBytes = response.bodyBytes;
+		totalMicros = micros() - startMicros;
+		done = true;
+	}
+
+	void onConnect() {
+		xSemaphoreTakeRecursive(lock, portMAX_DELAY);
+		if (active && !done) {
+			connectMicros = micros() - startMicros;
+			client.setNoDelay(true);
+			send();
+		}
+		xSemaphoreGiveRecursive(lock);
+	}
+
+	void onData(const uint8_t* data, size_t length) {
+		xSemaphoreTakeRecursive(lock, portMAX_DELAY);
+		if (active && !done) {
+			int status = response.feed(data, length);
+			if (firstByteMicros == 0 && response.started()) {
+				firstByteMicros = micros() - startMicros;
+			}
+			if (status != FEED_PENDING) {
+				finish(status);
+			}
+		}
+		xSemaphoreGiveRecursive(lock);
+	}
+
+	void onDisconnect() {
+		xSemaphoreTakeRecursive(lock, portMAX_DELAY);
+		if (active && !done && !closing && !retry) {
+			if (reused && !response.started()) {
+				retry = true;  // Server dropped the idle connection, reconnect from poll()
+			} else {
+				finish(response.finish());
+			}
+		}
+		xSemaphoreGiveRecursive(lock);
+	}
+
+	void onError(int8_t error) {
+		xSemaphoreTakeRecursive(lock, portMAX_DELAY);
+		if (active && !done && !closing && !retry) {
+			LOG_D("Feed connection error: %s", client.errorToString(error));
+			if (reused && !response.started()) {
+				retry = true;
+			} else {
+				response.abort();
+				finish(connectMicros || reused ? FEED_ERROR_PROTOCOL : FEED_ERROR_CONNECT);
+			}
+		}
+		xSemaphoreGiveRecursive(lock);
+	}
+};
@@ -3,8 +3,16 @@
 #include <LTR303.h>
 #include <Preferences.h>
 
-// Preferences is in main.cpp
+#include "ledOutput.h"
+#include "log.h"
+#include "recordStore.h"
+#include "settings.h"
+
+// Preferences, RecordStore, SettingsCache and LedOutput are in main.cpp
 extern Preferences preferences;
+extern RecordStore recordStore;
+extern SettingsCache settings;
+extern LedOutput ledOutput;
 
 LTR303 lightSensor;
 
@@ -25,16 +33,16 @@ class BrightnessManager {
 	void begin() {
 		Wire.begin(SDA_PIN, SCL_PIN, 50000);
 		lightSensor.begin(GAIN_48X, EXPOSURE_50ms, true, Wire);
-		loadBuckets(preferences);
+		loadBuckets();
 		setBrightness();
 	}
 
 	void increase() {
-		adjustBuckets(BRIGHTNESS_STEP / 255.0f);
+		adjustBuckets(settings.get().brightnessStep / 255.0f);
 	}
 
 	void decrease() {
-		adjustBuckets(-BRIGHTNESS_STEP / 255.0f);
+		adjustBuckets(-settings.get().brightnessStep / 255.0f);
 	}
 
 	void toggle() {
@@ -47,22 +55,21 @@ class BrightnessManager {
 		setBrightness();
 	}
 
-	void saveBuckets(Preferences &preferences) {
-		preferences.begin("brightness", false);
-		for (int i = 0; i < numBuckets; i++) {
-			preferences.putFloat(("lux" + String(i)).c_str(), buckets[i].luxMax);
-			preferences.putFloat(("bright" + String(i)).c_str(), buckets[i].brightnessMax);
-		}
-		preferences.end();
+	void saveBuckets() {
+		recordStore.put(RECORD_BRIGHTNESS_BUCKETS, buckets, sizeof(buckets));
 	}
 
-	void loadBuckets(Preferences &preferences) {
-		preferences.begin("brightness", true);
-		for (int i = 0; i < numBuckets; i++) {
-			buckets[i].luxMax = preferences.getFloat(("lux" + String(i)).c_str(), buckets[i].luxMax);
-			buckets[i].brightnessMax = preferences.getFloat(("bright" + String(i)).c_str(), buckets[i].brightnessMax);
+	// From the record store, or once from Preferences (NVS) where older firmware kept them
+	void loadBuckets() {
+		if (!recordStore.get(RECORD_BRIGHTNESS_BUCKETS, buckets, sizeof(buckets))) {
+			preferences.begin("brightness", true);
+			for (int i = 0; i < numBuckets; i++) {
+				buckets[i].luxMax = preferences.getFloat(("lux" + String(i)).c_str(), buckets[i].luxMax);
+				buckets[i].brightnessMax = preferences.getFloat(("bright" + String(i)).c_str(), buckets[i].brightnessMax);
+			}
+			preferences.end();
+			saveBuckets();
 		}
-		preferences.end();
 		printBuckets();
 	}
 
@@ -78,16 +85,21 @@ class BrightnessManager {
 	}
 
 	void setBrightness() {
-		float scaledBrightness = mapFloat(brightness, 0.0f, 1.0f, MIN_BRIGHTNESS / 255.0f, MAX_BRIGHTNESS / 255.0f);
+		const Settings& current = settings.get();
+		float scaledBrightness = mapFloat(brightness, 0.0f, 1.0f, current.minBrightness / 255.0f, current.maxBrightness / 255.0f);
 
-		// Apply gamma correction for perceived brightness
+		// Apply gamma correction for perceived brightness, kept at 16 bits so low levels stay distinct
 		float gamma = 2.2f;
-		uint8_t gammaBrightness = static_cast<uint8_t>(pow(scaledBrightness, gamma) * 255.0f);
+		uint16_t gain = static_cast<uint16_t>(pow(scaledBrightness, gamma) * 65535.0f);
 
 		// Update the LEDs
-		FastLED.setBrightness(powerOn ? gammaBrightness : 0);
+		ledOutput.setBrightness(powerOn ? gain : 0);
 	}
 
+	/// Smoothed ambient light in lux
+	float getLux() const {
+		return ambientLux;
+	}
 
   private:
 	float brightness = 0.0f;  // Current brightness level (0-1) -> MIN_BRIGHTNESS to MAX_BRIGHTNESS
@@ -100,14 +112,13 @@ class BrightnessManager {
 
 	void printBuckets() {
 		for (int i = 0; i < numBuckets; i++) {
-			Serial.printf("{%d: {lux: %.0f-%.0f, bright: %.2f-%.2f}},",
-						  i,
-						  getLuxForBucket(i - 1),
-						  getLuxForBucket(i),
-						  getBrightnessForBucket(i - 1),
-						  getBrightnessForBucket(i));
+			LOG_D("{%d: {lux: %.0f-%.0f, bright: %.2f-%.2f}}",
+				  i,
+				  getLuxForBucket(i - 1),
+				  getLuxForBucket(i),
+				  getBrightnessForBucket(i - 1),
+				  getBrightnessForBucket(i));
 		}
-		Serial.println();
 	}
 
 	// Adjusts the brightness max for the current lux bucket and the one below it (interpolated)
@@ -134,8 +145,9 @@ class BrightnessManager {
 		brightness = calculateBrightnessForAmbient(ambientLux, bucketIndex);
 		setBrightness();
 
-		saveBuckets(preferences);
+		saveBuckets();
 
+		LOG_RECORD_I(BrightnessRecord{ ledOutput.getBrightness(), powerOn, uint16_t(min(ambientLux, 65535.0f)) });
 		printBuckets();
 	}
 
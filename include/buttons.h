@@ -1,28 +1,71 @@
 #pragma once
 
 #include <Arduino.h>
+#include <esp_timer.h>
 #include <functional>
+#include <soc/gpio_reg.h>
 #include <vector>
 
+#include "log.h"
+#include "taskPlacement.h"
+
+#define BUTTON_RING_SIZE 32  // Edges buffered between the ISR and the task, must be a power of two
+
 /**
- * @brief Structure representing a button press event
- * 
- * This struct is used to pass button events through the FreeRTOS queue
- * from the ISR context to the button handling task.
+ * @brief A button edge captured in the ISR
+ */
+struct ButtonEdge {
+	uint32_t micros;  //< esp_timer time of the edge
+	uint8_t pin;	  //< GPIO pin number of the button
+	uint8_t level;	  //< Pin level after the edge
+};
+
+/**
+ * @brief Lock-free single producer (GPIO ISR), single consumer (button task) edge ring
+ *
+ * The ISR only writes head and the task only writes tail, so neither side needs a lock.
+ * All button pins share one GPIO interrupt on a single core, so there is only one producer.
  */
-struct ButtonEvent {
-	uint8_t pin;  //< GPIO pin number of the button that was pressed
+struct ButtonEdgeRing {
+	ButtonEdge edges[BUTTON_RING_SIZE];
+	volatile uint8_t head = 0;	// Next slot the ISR writes
+	volatile uint8_t tail = 0;	// Next slot the task reads
+	volatile uint32_t overflows = 0;
+
+	bool IRAM_ATTR push(const ButtonEdge& edge) {
+		uint8_t next = (head + 1) & (BUTTON_RING_SIZE - 1);
+		if (next == tail) {
+			overflows++;
+			return false;
+		}
+		edges[head] = edge;
+		__asm__ __volatile__("" ::: "memory");	// Entry is written before it is published
+		head = next;
+		return true;
+	}
+
+	bool pop(ButtonEdge& edge) {
+		if (tail == head) {
+			return false;
+		}
+		edge = edges[tail];
+		__asm__ __volatile__("" ::: "memory");	// Entry is read before the slot is released
+		tail = (tail + 1) & (BUTTON_RING_SIZE - 1);
+		return true;
+	}
 };
 
-// FreeRTOS queue handle for button events
-QueueHandle_t buttonQueue;
+// Shared by the GPIO ISR and the button task
+ButtonEdgeRing buttonEdges;
+TaskHandle_t buttonTaskHandle = nullptr;
+volatile uint32_t buttonMaxIsrCycles = 0;
 
 /**
  * @brief Button manager class for handling multiple button inputs with debouncing
  * 
  * This class provides a clean interface for managing multiple buttons with
- * interrupt-driven detection and debouncing. It uses FreeRTOS tasks and queues
- * to handle button events asynchronously.
+ * interrupt-driven detection and debouncing. The ISR only timestamps edges into a
+ * lock-free ring and wakes the button task, which debounces and runs the callbacks.
  */
 class ButtonManager {
   public:
@@ -34,6 +77,7 @@ class ButtonManager {
 	 * 
 	 * Holds all the necessary information for a single button including
 	 * its pin, callback function, and debouncing state variables.
+	 * The debouncing state is only touched by the button task.
 	 */
 	struct Button {
 		uint8_t pin;			  // GPIO pin number for this button
@@ -41,8 +85,7 @@ class ButtonManager {
 
 		// For debouncing
 		bool state;				 // Current state of the button (assumes idle state is HIGH with INPUT_PULLUP)
-		TickType_t fallingTick;	 // Tick count when button last transitioned to LOW
-		TickType_t risingTick;	 // Tick count when button last transitioned to HIGH
+		uint32_t fallingMicros;	 // Time the button last transitioned to LOW
 
 		/**
 		 * @brief Construct a new Button object
@@ -50,12 +93,10 @@ class ButtonManager {
 		 * @param p GPIO pin number
 		 * @param cb Callback function to execute on button press
 		 * @param st Initial state of the button (default: HIGH)
-		 * @param ft Initial falling tick time (default: 0)
-		 * @param rt Initial rising tick time (default: 0)
-		 * @param it Initial ISR time (default: 0)
+		 * @param fm Initial falling edge time (default: 0)
 		 */
-		Button(uint8_t p, ButtonCallback cb, bool st = HIGH, TickType_t ft = 0, TickType_t rt = 0)
-			: pin(p), callback(cb), state(st), fallingTick(ft), risingTick(rt) {}
+		Button(uint8_t p, ButtonCallback cb, bool st = HIGH, uint32_t fm = 0)
+			: pin(p), callback(cb), state(st), fallingMicros(fm) {}
 	};
 
 	/// Container for all registered buttons
@@ -71,7 +112,7 @@ class ButtonManager {
 	 * @param cb Callback function to execute when button is pressed
 	 */
 	void add(uint8_t pin, ButtonCallback cb) {
-		buttons.push_back({ pin, cb, HIGH, 0, 0 });
+		buttons.push_back({ pin, cb, HIGH, 0 });
 	}
 
 	/**
@@ -90,7 +131,7 @@ class ButtonManager {
 				return;
 			}
 		}
-		Serial.printf("Button on pin %d not found!\n", pin);
+		LOG_E("Button on pin %d not found!", pin);
 	}
 
 	/**
@@ -98,20 +139,14 @@ class ButtonManager {
 	 * 
 	 * Performs initial setup including:
 	 * 
-	 * - Creating the FreeRTOS queue for button events
+	 * - Starting the button handling task (the ISR wakes it)
 	 * 
 	 * - Configuring all registered buttons with INPUT_PULLUP
 	 * 
 	 * - Attaching interrupt handlers for each button
-	 * 
-	 * - Starting the button handling task
 	 */
 	void begin() {
-		buttonQueue = xQueueCreate(10, sizeof(ButtonEvent));
-		if (buttonQueue == NULL) {
-			Serial.println("Failed to create button queue!");
-			return;
-		}
+		createPlacedTask(TASK_BUTTONS, buttonTask, this, &buttonTaskHandle);
 
 		for (auto& btn : buttons) {
 			pinMode(btn.pin, INPUT_PULLUP);
@@ -121,69 +156,78 @@ class ButtonManager {
 							   CHANGE  // Trigger on both rising and falling edges
 			);
 		}
-
-		xTaskCreate(buttonTask, "ButtonTask", 2048, this, 1, NULL);
 	}
 
   private:
-	static const int buttonTaskPollingInterval = 50;  // ms
-
 	/**
 	 * @brief Interrupt service routine wrapper for button state changes
 	 * 
-	 * This static function is called when a button's state changes. It handles
-	 * debouncing by checking the time between falling and rising edges.
-	 * Valid button presses are sent to the button queue for processing by the task.
+	 * Reads the pin straight from the GPIO input register (digitalRead() is not
+	 * guaranteed to be in IRAM), timestamps the edge into the ring and wakes the
+	 * button task. Debouncing is left to the task so the ISR stays short.
 	 * 
 	 * @param arg Pointer to the Button object that triggered the interrupt
 	 */
 	static void IRAM_ATTR isrWrapper(void* arg) {
-		Button* button = static_cast<Button*>(arg);
-		TickType_t now = xTaskGetTickCountFromISR();
-
-		bool newState = digitalRead(button->pin);
-
-		if (newState != button->state) {
-			button->state = newState;
-
-			if (newState == LOW) {
-				button->fallingTick = now;
-			} else {
-				button->risingTick = now;
-				if ((button->risingTick - button->fallingTick) > pdMS_TO_TICKS(DEBOUNCE_MS)) {
-					ButtonEvent event = { button->pin };
-					BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-					xQueueSendFromISR(buttonQueue, &event, &xHigherPriorityTaskWoken);
-					if (xHigherPriorityTaskWoken) {
-						portYIELD_FROM_ISR();
-					}
-				}
-			}
+		const uint32_t startCycles = ESP.getCycleCount();
+		const Button* button = static_cast<const Button*>(arg);
+
+		ButtonEdge edge;
+		edge.micros = uint32_t(esp_timer_get_time());
+		edge.pin = button->pin;
+		edge.level = (REG_READ(GPIO_IN_REG) >> button->pin) & 1;
+		buttonEdges.push(edge);
+
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+		vTaskNotifyGiveFromISR(buttonTaskHandle, &xHigherPriorityTaskWoken);
+
+		uint32_t cycles = ESP.getCycleCount() - startCycles;
+		if (cycles > buttonMaxIsrCycles) {
+			buttonMaxIsrCycles = cycles;
+		}
+		if (xHigherPriorityTaskWoken) {
+			portYIELD_FROM_ISR();
 		}
 	}
 
 	/**
-	 * @brief FreeRTOS task for processing button events
+	 * @brief FreeRTOS task for processing button edges
 	 * 
-	 * This task runs periodically, waiting for button events from the queue.
-	 * When an event is received, it finds the corresponding button and executes its callback.
+	 * Sleeps until the ISR signals new edges, then debounces them in order. A press
+	 * is reported when the button is released after being held for longer than
+	 * DEBOUNCE_MS, and the corresponding callback is executed straight away.
 	 * 
 	 * @param pvParameters Pointer to the ButtonManager instance
 	 */
 	static void buttonTask(void* pvParameters) {
 		ButtonManager* manager = static_cast<ButtonManager*>(pvParameters);
-		ButtonEvent event;
+		ButtonEdge edge;
 
 		while (true) {
-			if (xQueueReceive(buttonQueue, &event, portMAX_DELAY)) {
+			ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+			while (buttonEdges.pop(edge)) {
 				for (auto& btn : manager->buttons) {
-					if (btn.pin == event.pin) {
-						btn.callback();
+					if (btn.pin == edge.pin) {
+						manager->handleEdge(btn, edge);
 						break;
 					}
 				}
 			}
-			vTaskDelay(pdMS_TO_TICKS(buttonTaskPollingInterval));
 		}
 	}
-};
\ No newline at end of file
+
+	void handleEdge(Button& button, const ButtonEdge& edge) {
+		if (edge.level == button.state) {
+			return;	 // Bounce shorter than the ISR latency, both edges read the same level
+		}
+		button.state = edge.level;
+
+		if (edge.level == LOW) {
+			button.fallingMicros = edge.micros;
+		} else if (edge.micros - button.fallingMicros > DEBOUNCE_MS * 1000UL) {
+			button.callback();
+			uint32_t latency = uint32_t(esp_timer_get_time()) - edge.micros;
+			LOG_RECORD_I(ButtonRecord{ button.pin, latency, buttonMaxIsrCycles, buttonEdges.overflows });
+		}
+	}
+};
@@ -0,0 +1,340 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include <atomic>
+
+#include "log.h"
+
+#if defined(LED_2_PIN)
+	#define COMPOSITOR_PIXELS (LED_1_PIXELS + LED_2_PIXELS)
+#else
+	#define COMPOSITOR_PIXELS LED_1_PIXELS
+#endif
+#define COMPOSITOR_MAX_OUTPUTS 2
+#define COMPOSITOR_MAX_SPANS 16  // Dirty spans kept per layer, the closest are merged beyond this
+
+/// Layers from the bottom up, each renderer paints its own and leaves the others alone
+enum CompositorLayer : uint8_t {
+	LAYER_BASE,		// Network outline, heatmap
+	LAYER_TRAINS,	// Realtime and timetable trains
+	LAYER_EFFECTS,	// Short animations over the trains
+	LAYER_OVERLAY,	// Status shown over everything
+	COMPOSITOR_LAYERS
+};
+
+/// How a layer's lit pixels combine with the layers below it (black is always transparent)
+enum BlendMode : uint8_t {
+	BLEND_OVER,	  // Lit pixels replace what is below
+	BLEND_ADD,	  // Lit pixels are added, saturating
+	BLEND_ALPHA,  // Lit pixels are mixed with what is below by the layer's opacity
+};
+
+/**
+ * @brief Combines ordered layers into the LED strands, recompositing only what changed
+ *
+ * Renderers write pixels into their layer with set(). A renderer that repaints its whole
+ * layer every time wraps the painting in beginLayer() / endLayer(), which blacks out only
+ * the pixels it did not paint again, so an unchanged train is not a change. Writes that
+ * change a pixel add it to that layer's dirty spans, and compose() rebuilds only the union
+ * of the dirty spans of the frame, so a train moving one block costs a couple of
+ * pixels rather than the whole frame. Pixels are numbered across the outputs in the order
+ * they were added (LED_1 then LED_2), the same as the block layout.
+ *
+ * Layers are kept at full 8-bit colour (3 bytes per pixel each); gamma and brightness are
+ * applied afterwards by LedOutput, so blending works on the colours as the feed gives them.
+ *
+ * Frames are presented, not written straight to the strands: compose() renders the dirty
+ * spans into a staging frame with a presentation time, and the LED output task calls
+ * present() before each show(), which copies those spans to the strands once the time has
+ * come. A renderer can so draw the next second ahead of time and have it appear on the
+ * second instead of after it. One frame waits at a time, compose() refuses another until
+ * it has been presented.
+ */
+class Compositor {
+  public:
+	/**
+	 * @brief Add an output strand, pixels continue from the previous strand
+	 *
+	 * @param pixels Strand's frame buffer (the one LedOutput sends)
+	 * @param count Pixels in the strand
+	 */
+	void add(CRGB* pixels, uint16_t count) {
+		if (numOutputs >= COMPOSITOR_MAX_OUTPUTS || totalPixels + count > COMPOSITOR_PIXELS) {
+			LOG_E("Compositor output of %u pixels does not fit", count);
+			return;
+		}
+		outputs[numOutputs++] = { pixels, totalPixels, count };
+		totalPixels += count;
+		invalidate();
+	}
+
+	/**
+	 * @brief Set how a layer is blended onto the layers below it
+	 *
+	 * @param layer Layer
+	 * @param mode Blend mode
+	 * @param opacity Mix for BLEND_ALPHA (255 = opaque)
+	 */
+	void setBlend(CompositorLayer layer, BlendMode mode, uint8_t opacity = 255) {
+		blends[layer] = { mode, opacity };
+		markDirty(layer, 0, totalPixels);
+	}
+
+	void set(CompositorLayer layer, uint16_t pixel, const CRGB& color) {
+		if (pixel >= totalPixels) {
+			return;
+		}
+		painted[layer][pixel / 32] |= 1UL << (pixel % 32);
+		if (layers[layer][pixel] != color) {
+			layers[layer][pixel] = color;
+			markDirty(layer, pixel, pixel + 1);
+		}
+	}
+
+	/// Start repainting a layer from scratch, pixels not set() before endLayer() are blacked out
+	void beginLayer(CompositorLayer layer) {
+		memset(painted[layer], 0, sizeof(painted[layer]));
+	}
+
+	void endLayer(CompositorLayer layer) {
+		for (uint16_t pixel = 0; pixel < totalPixels; pixel++) {
+			if (!(painted[layer][pixel / 32] & (1UL << (pixel % 32))) && layers[layer][pixel]) {
+				layers[layer][pixel] = CRGB::Black;
+				markDirty(layer, pixel, pixel + 1);
+			}
+		}
+	}
+
+	/// Black out a layer, only pixels that were lit become dirty
+	void clear(CompositorLayer layer) {
+		for (uint16_t pixel = 0; pixel < totalPixels; pixel++) {
+			if (layers[layer][pixel]) {
+				layers[layer][pixel] = CRGB::Black;
+				markDirty(layer, pixel, pixel + 1);
+			}
+		}
+	}
+
+	/// Recomposite everything at the next compose(), for when the outputs were written directly
+	void invalidate() {
+		markDirty(LAYER_BASE, 0, totalPixels);
+	}
+
+	/**
+	 * @brief Render the dirty spans of all layers into a frame for present()
+	 *
+	 * @param presentAt esp_timer time the frame is to be shown at (0 = as soon as possible)
+	 * @return int Pixels recomposited, -1 if the previous frame is still waiting (the changes are kept for later)
+	 */
+	int compose(int64_t presentAt) {
+		if (framePending()) {
+			return -1;
+		}
+
+		// Dirty spans of all layers sorted by start
+		Span spans[COMPOSITOR_LAYERS * COMPOSITOR_MAX_SPANS];
+		uint8_t numSpans = 0;
+		for (uint8_t layer = 0; layer < COMPOSITOR_LAYERS; layer++) {
+			for (uint8_t d = 0; d < numDirty[layer]; d++) {
+				const Span& span = dirty[layer][d];
+				uint8_t i = numSpans++;
+				for (; i > 0 && spans[i - 1].start > span.start; i--) {
+					spans[i] = spans[i - 1];
+				}
+				spans[i] = span;
+			}
+			numDirty[layer] = 0;
+		}
+
+		uint16_t composed = 0;
+		numPending = 0;
+		for (uint8_t i = 0; i < numSpans; i++) {
+			Span span = spans[i];
+			while (i + 1 < numSpans && spans[i + 1].start <= span.end) {  // Merge overlapping and touching spans
+				span.end = max(span.end, spans[++i].end);
+			}
+			for (uint16_t pixel = span.start; pixel < span.end; pixel++) {
+				staged[pixel] = blendPixel(pixel);
+			}
+			pending[numPending++] = span;
+			composed += span.end - span.start;
+		}
+
+		if (numPending > 0) {
+			presentationTime = presentAt;
+			pendingFrame = true;  // Last, the output task reads the frame once this is set
+		}
+		return composed;
+	}
+
+	/// A composed frame is waiting for its presentation time
+	bool framePending() const {
+		return pendingFrame;
+	}
+
+	/// esp_timer time the waiting frame is due at, INT64_MAX if none is waiting
+	int64_t dueTime() const {
+		return pendingFrame ? presentationTime : INT64_MAX;
+	}
+
+	/**
+	 * @brief Copy the waiting frame to the outputs if it is due, called by the LED output task before show()
+	 *
+	 * @param now esp_timer time
+	 * @return bool True if a frame was presented
+	 */
+	bool present(int64_t now) {
+		if (!pendingFrame || now < presentationTime) {
+			return false;
+		}
+		for (uint8_t i = 0; i < numPending; i++) {
+			for (uint8_t o = 0; o < numOutputs; o++) {
+				const Output& output = outputs[o];
+				uint16_t from = max(pending[i].start, output.first);
+				uint16_t to = min(pending[i].end, uint16_t(output.first + output.count));
+				if (from < to) {
+					memcpy(&output.pixels[from - output.first], &staged[from], (to - from) * sizeof(CRGB));
+				}
+			}
+		}
+		pendingFrame = false;  // Last, compose() may reuse the staging frame once this is clear
+		return true;
+	}
+
+  private:
+	struct Output {
+		CRGB* pixels;
+		uint16_t first;	 // Compositor pixel of the strand's first LED
+		uint16_t count;
+	};
+
+	struct Blend {
+		BlendMode mode;
+		uint8_t opacity;
+	};
+
+	struct Span {
+		uint16_t start;
+		uint16_t end;  // Exclusive
+	};
+
+	CRGB layers[COMPOSITOR_LAYERS][COMPOSITOR_PIXELS] = {};
+	CRGB staged[COMPOSITOR_PIXELS] = {};  // Composited frame, copied to the outputs by present()
+	uint32_t painted[COMPOSITOR_LAYERS][(COMPOSITOR_PIXELS + 31) / 32];	 // Pixels set() since beginLayer()
+	Blend blends[COMPOSITOR_LAYERS] = { { BLEND_OVER, 255 }, { BLEND_OVER, 255 }, { BLEND_ADD, 255 }, { BLEND_OVER, 255 } };
+	Span dirty[COMPOSITOR_LAYERS][COMPOSITOR_MAX_SPANS];  // Unordered, not overlapping or touching when added
+	uint8_t numDirty[COMPOSITOR_LAYERS] = {};
+	Output outputs[COMPOSITOR_MAX_OUTPUTS];
+	uint8_t numOutputs = 0;
+	uint16_t totalPixels = 0;
+	Span pending[COMPOSITOR_LAYERS * COMPOSITOR_MAX_SPANS];	 // Spans of the staging frame that changed
+	uint8_t numPending = 0;
+	int64_t presentationTime = 0;
+	std::atomic<bool> pendingFrame{ false };  // Hands the staging frame between the renderer and the LED output task
+
+	void markDirty(uint8_t layer, uint16_t start, uint16_t end) {
+		if (start >= end) {
+			return;
+		}
+		Span* spans = dirty[layer];
+		uint8_t& count = numDirty[layer];
+
+		// Absorb the spans this one overlaps or touches
+		for (uint8_t i = 0; i < count;) {
+			if (start <= spans[i].end && spans[i].start <= end) {
+				start = min(start, spans[i].start);
+				end = max(end, spans[i].end);
+				spans[i] = spans[--count];
+			} else {
+				i++;
+			}
+		}
+
+		if (count < COMPOSITOR_MAX_SPANS) {
+			spans[count++] = { start, end };
+			return;
+		}
+
+		// Full, grow the nearest span over the gap instead (compose() merges any new overlaps)
+		uint8_t nearest = 0;
+		uint16_t nearestGap = UINT16_MAX;
+		for (uint8_t i = 0; i < count; i++) {
+			uint16_t gap = (spans[i].end < start) ? start - spans[i].end : spans[i].start - end;
+			if (gap < nearestGap) {
+				nearest = i;
+				nearestGap = gap;
+			}
+		}
+		spans[nearest].start = min(spans[nearest].start, start);
+		spans[nearest].end = max(spans[nearest].end, end);
+	}
+
+	CRGB blendPixel(uint16_t pixel) const {
+		CRGB color = CRGB::Black;
+		for (uint8_t layer = 0; layer < COMPOSITOR_LAYERS; layer++) {
+			const CRGB& top = layers[layer][pixel];
+			if (!top) {
+				continue;  // Transparent
+			}
+			switch (blends[layer].mode) {
+				case BLEND_OVER: color = top; break;
+				case BLEND_ADD: color += top; break;
+				case BLEND_ALPHA: nblend(color, top, blends[layer].opacity); break;
+			}
+		}
+		return color;
+	}
+};
+
+#if defined(COMPOSITOR_BENCHMARK)
+/**
+ * @brief Log the cost of full versus incremental compositing, at boot before anything is drawn
+ *
+ * Paints a dim base layer, then moves 12 trains one pixel at a time over it, timing the
+ * incremental compose() and present() of each move and a full recomposite of the same
+ * frame. Leaves every layer clear. Runs before the LED output task is started.
+ */
+inline void benchmarkCompositor(Compositor& compositor, uint16_t pixels) {
+	const uint8_t trains = 12;
+	const uint8_t rounds = 16;
+	for (uint16_t pixel = 0; pixel < pixels; pixel++) {
+		compositor.set(LAYER_BASE, pixel, CRGB(8, 8, 8));
+	}
+	compositor.compose(0);
+	compositor.present(0);
+
+	uint32_t fullCycles = 0;
+	uint32_t incrementalCycles = 0;
+	uint32_t incrementalPixels = 0;
+	for (uint8_t round = 0; round < rounds; round++) {
+		for (uint8_t train = 0; train < trains; train++) {
+			uint16_t pixel = (train * pixels / trains + round) % pixels;
+			compositor.set(LAYER_TRAINS, pixel, CRGB::Black);
+			compositor.set(LAYER_TRAINS, (pixel + 1) % pixels, CRGB(255, 0, 0));
+		}
+
+		uint32_t start = ESP.getCycleCount();
+		incrementalPixels += compositor.compose(0);
+		compositor.present(0);
+		incrementalCycles += ESP.getCycleCount() - start;
+
+		compositor.invalidate();
+		start = ESP.getCycleCount();
+		compositor.compose(0);
+		compositor.present(0);
+		fullCycles += ESP.getCycleCount() - start;
+	}
+
+	LOG_I("Compositor: full frame %" PRIu32 " cycles, incremental %" PRIu32 " cycles (%" PRIu32 " pixels) per update",
+		  fullCycles / rounds,
+		  incrementalCycles / rounds,
+		  incrementalPixels / rounds);
+
+	for (uint8_t layer = 0; layer < COMPOSITOR_LAYERS; layer++) {
+		compositor.clear(CompositorLayer(layer));
+	}
+	compositor.compose(0);
+	compositor.present(0);
+}
+#endif
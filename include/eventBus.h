@@ -0,0 +1,162 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "log.h"
+
+#define EVENT_BUS_MAX_SUBSCRIBERS 8
+
+/// What happened, subscribers pick the types they want with EVENT_MASK()
+enum EventType : uint8_t {
+	EVENT_BLOCK,	   // A train moved between blocks (render path)
+	EVENT_FETCH,	   // A feed fetch finished (fetch path)
+	EVENT_BRIGHTNESS,  // LED gain changed (buttons, light sensor, power)
+	EVENT_MODE,		   // Display mode changed (mode button)
+	EVENT_TYPES
+};
+
+#define EVENT_MASK(type) (1UL << (type))
+#define EVENT_MASK_ALL ((1UL << EVENT_TYPES) - 1)
+
+/**
+ * @brief One event, copied by value into every subscriber's queue (12 bytes)
+ */
+struct Event {
+	uint32_t publishedMs;  // millis() when it was published
+	EventType type;
+	union {
+		struct {
+			uint16_t fromBlock;	 // 0 when the train appeared
+			uint16_t toBlock;
+			uint8_t colorId;  // Index into the merged colour table
+		} block;
+		struct {
+			int16_t status;	  // HTTP status or FEED_ERROR_*
+			uint8_t feed;	  // Index into feeds[]
+			uint16_t updates;  // Scheduled updates after the fetch
+		} fetch;
+		struct {
+			uint16_t gain;	// 0-65535, 0 when the LEDs are off
+		} brightness;
+		struct {
+			uint8_t mode;
+		} mode;
+	};
+};
+
+/**
+ * @brief A subscriber's bounded queue, see StaticEventQueue for the storage
+ *
+ * Events that arrive while the queue is full are dropped and counted, a slow consumer
+ * never holds up the publisher.
+ */
+class EventQueue {
+  public:
+	/**
+	 * @brief Take the oldest event
+	 *
+	 * @param event Receives the event
+	 * @param wait Ticks to block for one (0 = return straight away)
+	 * @return bool False if there was none
+	 */
+	bool receive(Event& event, TickType_t wait = 0) {
+		return xQueueReceive(queue, &event, wait) == pdTRUE;
+	}
+
+	uint32_t dropped = 0;  // Events lost to a full queue
+
+  protected:
+	friend class EventBus;
+	QueueHandle_t queue = nullptr;
+	uint32_t mask = 0;
+};
+
+/// EventQueue with its storage, declared statically by the subscriber
+template <size_t Depth>
+class StaticEventQueue : public EventQueue {
+  public:
+	StaticEventQueue() {
+		queue = xQueueCreateStatic(Depth, sizeof(Event), storage, &control);
+	}
+
+  private:
+	StaticQueue_t control;
+	uint8_t storage[Depth * sizeof(Event)];
+};
+
+/**
+ * @brief Publish/subscribe of block changes and state changes, without allocation
+ *
+ * Publishers call publish() where the change happens (applying transitions, finishing a
+ * fetch, setting the LED gain, changing mode) and carry on, each subscriber gets its own
+ * copy in its own FreeRTOS queue and drains it when it suits it, blocking on the queue if
+ * it has a task of its own. Nothing is published to types no one subscribed to, so an
+ * event costs one mask test per subscriber and a queue copy per interested one.
+ *
+ * Subscribe during setup(), before the publishers start. publish() may be called from any
+ * task, but not from an ISR.
+ */
+class EventBus {
+  public:
+	/**
+	 * @brief Deliver the given event types to a queue
+	 *
+	 * @param queue Subscriber's queue, must live forever
+	 * @param mask EVENT_MASK() of the types wanted, or'ed together
+	 */
+	void subscribe(EventQueue& queue, uint32_t mask) {
+		if (numSubscribers >= EVENT_BUS_MAX_SUBSCRIBERS || queue.queue == nullptr) {
+			LOG_E("Event bus subscriber not added");
+			return;
+		}
+		queue.mask = mask;
+		subscribers[numSubscribers++] = &queue;
+		subscribedMask |= mask;
+	}
+
+	void publish(Event event) {
+		if (!(subscribedMask & EVENT_MASK(event.type))) {
+			return;
+		}
+		event.publishedMs = millis();
+		for (uint8_t i = 0; i < numSubscribers; i++) {
+			EventQueue& queue = *subscribers[i];
+			if ((queue.mask & EVENT_MASK(event.type)) && xQueueSend(queue.queue, &event, 0) != pdTRUE) {
+				queue.dropped++;
+			}
+		}
+	}
+
+	void publishBlock(uint16_t fromBlock, uint16_t toBlock, uint8_t colorId) {
+		Event event{};
+		event.type = EVENT_BLOCK;
+		event.block = { fromBlock, toBlock, colorId };
+		publish(event);
+	}
+
+	void publishFetch(int status, uint8_t feed, uint16_t updates) {
+		Event event{};
+		event.type = EVENT_FETCH;
+		event.fetch = { int16_t(status), feed, updates };
+		publish(event);
+	}
+
+	void publishBrightness(uint16_t gain) {
+		Event event{};
+		event.type = EVENT_BRIGHTNESS;
+		event.brightness = { gain };
+		publish(event);
+	}
+
+	void publishMode(uint8_t mode) {
+		Event event{};
+		event.type = EVENT_MODE;
+		event.mode = { mode };
+		publish(event);
+	}
+
+  private:
+	EventQueue* subscribers[EVENT_BUS_MAX_SUBSCRIBERS];
+	uint8_t numSubscribers = 0;
+	uint32_t subscribedMask = 0;
+};
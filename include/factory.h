@@ -2,8 +2,11 @@
 #include <FastLED.h>
 #include <Preferences.h>
 #include <buttons.h>
+#include <log.h>
+#include <recordStore.h>
 
 extern Preferences preferences;
+extern RecordStore recordStore;
 
 extern ButtonManager buttons;
 
@@ -16,9 +19,9 @@ bool passed;
 
 void onPowerFactory() {
 	passed = true;
-	preferences.putBool("passed", passed);	// Toggle factory test mode pass/fail state
-	Serial.println("Factory test mode saved as passed");
-	preferences.end();
+	uint8_t value = passed;
+	recordStore.put(RECORD_FACTORY_PASSED, &value, sizeof(value));  // Toggle factory test mode pass/fail state
+	LOG_I("Factory test mode saved as passed");
 }
 
 void factorySetColor(CRGB color) {
@@ -27,7 +30,7 @@ void factorySetColor(CRGB color) {
 #if defined(LED_2_PIN)
 	fill_solid(leds2, LED_2_PIXELS, color);
 #endif
-	FastLED.show();
+	// Sent by the LED output task on its next frame
 }
 
 void waitForPowerButton(int timeout) {
@@ -38,13 +41,24 @@ void waitForPowerButton(int timeout) {
 }
 
 void factoryTestMode() {
-	preferences.begin("factory_test");
-	passed = preferences.getBool("passed", false);
+	uint8_t value;
+	if (recordStore.get(RECORD_FACTORY_PASSED, &value, sizeof(value))) {
+		passed = value;
+	} else {
+		preferences.begin("factory_test", true);  // Where older firmware kept it
+		passed = preferences.getBool("passed", false);
+		preferences.end();
+		if (passed) {
+			value = passed;
+			recordStore.put(RECORD_FACTORY_PASSED, &value, sizeof(value));
+		}
+	}
+
 	if (passed == false) {
 		buttons.setCallback(POWER_BUTTON, onPowerFactory);
-		Serial.println("Factory test mode enabled");
+		LOG_I("Factory test mode enabled");
 		uint8_t colorIndex = 0;
-		const CRGB testColors[] = { CRGB(128, 0, 0), CRGB(0, 128, 0), CRGB(0, 0, 128) };
+		const CRGB testColors[] = { CRGB(181, 0, 0), CRGB(0, 181, 0), CRGB(0, 0, 181) };	 // 128 on the wire after gamma
 
 		while (!passed) {
 			factorySetColor(testColors[colorIndex]);
@@ -55,7 +69,6 @@ void factoryTestMode() {
 		factorySetColor(CRGB::Black);
 
 	} else {
-		Serial.println("Factory test passed, skipping.");
-		preferences.end();
+		LOG_I("Factory test passed, skipping.");
 	}
 }
\ No newline at end of file
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+
+#include "httpResponse.h"
+
+#define FEED_HOST_LEN 64
+#define FEED_PATH_LEN 128
+#define FEED_BUFFER_LEN 1024	// Socket read buffer
+
+/**
+ * @brief Split an http:// URL into host, port and path
+ *
+ * @param url http://host[:port]/path
+ * @param host Receives the host, FEED_HOST_LEN bytes
+ * @param port Receives the port (80 if none)
+ * @param path Receives the path, FEED_PATH_LEN bytes
+ * @return bool False if the URL is not plain http or does not fit
+ */
+inline bool parseFeedUrl(const char* url, char* host, uint16_t& port, char* path) {
+	const char* prefix = "http://";
+	if (strncmp(url, prefix, strlen(prefix)) != 0) {
+		return false;
+	}
+	const char* hostStart = url + strlen(prefix);
+	const char* authorityEnd = hostStart + strcspn(hostStart, "/");
+	const char* pathStart = (*authorityEnd == '/') ? authorityEnd : "/";
+	const char* portStart = static_cast<const char*>(memchr(hostStart, ':', authorityEnd - hostStart));
+	const char* hostEnd = portStart ? portStart : authorityEnd;
+	size_t hostLength = hostEnd - hostStart;
+	if (hostLength == 0 || hostLength >= FEED_HOST_LEN || strlen(pathStart) >= FEED_PATH_LEN) {
+		return false;
+	}
+
+	memcpy(host, hostStart, hostLength);
+	host[hostLength] = '\0';
+	port = portStart ? atoi(portStart + 1) : 80;
+	strcpy(path, pathStart);
+	return true;
+}
+
+/**
+ * @brief Write the request line and headers of a keep-alive request
+ *
+ * @param buffer Destination
+ * @param size Space in buffer
+ * @param host Host header
+ * @param path Request path
+ * @param validators Sent as If-None-Match / If-Modified-Since
+ * @param contentType Content-Type of the body, nullptr for a GET
+ * @param bodyLength Body length in bytes (POST only)
+ * @return int Length of the request head, or -1 if it does not fit
+ */
+inline int formatFeedRequest(char* buffer,
+							 size_t size,
+							 const char* host,
+							 const char* path,
+							 const FeedValidators& validators,
+							 const char* contentType = nullptr,
+							 size_t bodyLength = 0) {
+	int length = snprintf(buffer,
+						  size,
+						  "%s %s HTTP/1.1\r\n"
+						  "Host: %s\r\n"
+						  "User-Agent: " FIRMWARE "/" FIRMWARE_VERSION "\r\n"
+						  "Accept-Encoding: gzip\r\n"
+						  "Connection: keep-alive\r\n",
+						  contentType ? "POST" : "GET",
+						  path,
+						  host);
+	if (contentType) {
+		length += snprintf(
+			buffer + length, size - length, "Content-Type: %s\r\nContent-Length: %u\r\n", contentType, unsigned(bodyLength));
+	}
+	if (validators.etag[0]) {
+		length += snprintf(buffer + length, size - length, "If-None-Match: %s\r\n", validators.etag);
+	}
+	if (validators.lastModified[0]) {
+		length += snprintf(buffer + length, size - length, "If-Modified-Since: %s\r\n", validators.lastModified);
+	}
+	length += snprintf(buffer + length, size - length, "\r\n");
+	return length < int(size) ? length : -1;
+}
+
+/**
+ * @brief Minimal HTTP/1.1 client for the LED-Rails feed
+ *
+ * Built for one job: fetch a small document from a plain http:// URL as fast and as
+ * cheaply as possible (and post the odd small upload over the same connection).
+ * Everything lives in fixed buffers inside the object, the socket is kept alive between
+ * requests to the same host, chunked and gzip bodies are decoded on the fly, and the
+ * whole request (connect, headers and body) runs against a single deadline. The body is
+ * streamed to a sink callback instead of being collected into a String.
+ *
+ * Redirects are not followed, a 3xx is returned to the caller like any other status.
+ */
+class FeedClient {
+  public:
+	/**
+	 * @brief Fetch a URL
+	 *
+	 * @param url http://host[:port]/path
+	 * @param validators Sent as If-None-Match / If-Modified-Since, updated on a 200
+	 * @param sink Called with the decoded body as it arrives
+	 * @param timeoutMs Deadline for the whole request
+	 * @return int HTTP status code (304 if not modified) or a negative FEED_ERROR_* code
+	 */
+	int get(const char* url, FeedValidators& validators, BodySink sink, uint32_t timeoutMs = 5000) {
+		requestBody = nullptr;
+		requestBodyLength = 0;
+		return exchange(url, validators, sink, timeoutMs);
+	}
+
+	/**
+	 * @brief Post a small body, reusing the kept-alive connection if it is to the same server
+	 *
+	 * Unlike get() it is not retried if the kept-alive connection turns out to be stale, as
+	 * the server may already have acted on it. The caller decides whether to send it again.
+	 *
+	 * @param url http://host[:port]/path
+	 * @param contentType Content-Type of the body
+	 * @param body Request body, sent as is
+	 * @param length Body length in bytes
+	 * @param timeoutMs Deadline for the whole request
+	 * @return int HTTP status code or a negative FEED_ERROR_* code, the response body is discarded
+	 */
+	int post(const char* url, const char* contentType, const uint8_t* body, size_t length, uint32_t timeoutMs = 5000) {
+		FeedValidators none;
+		requestBody = body;
+		requestBodyLength = length;
+		requestContentType = contentType;
+		int status = exchange(url, none, [](const uint8_t*, size_t) { return true; }, timeoutMs);
+		requestBody = nullptr;
+		return status;
+	}
+
+	/// Close the kept-alive connection
+	void stop() {
+		client.stop();
+	}
+
+	/// Content-Type of the last response (without parameters)
+	const char* getContentType() const {
+		return response.contentType;
+	}
+
+	// Timing of the last request, in microseconds from the start of get() or post()
+	uint32_t connectMicros = 0;	   // Connection established (0 if reused)
+	uint32_t firstByteMicros = 0;  // Status line received
+	uint32_t totalMicros = 0;	   // Body complete
+	uint32_t bodyBytes = 0;		   // Decoded body size
+	bool reused = false;		   // Kept-alive connection was used
+
+  private:
+	WiFiClient client;
+	char host[FEED_HOST_LEN] = "";
+	uint16_t port = 0;
+	char path[FEED_PATH_LEN];
+	uint8_t buffer[FEED_BUFFER_LEN];
+	HttpResponse response;
+	uint32_t deadline = 0;
+	uint32_t startMicros = 0;
+
+	// Body of the request in progress (post() only)
+	const uint8_t* requestBody = nullptr;
+	size_t requestBodyLength = 0;
+	const char* requestContentType = "";
+
+	int exchange(const char* url, FeedValidators& validators, BodySink sink, uint32_t timeoutMs) {
+		deadline = millis() + timeoutMs;
+		startMicros = micros();
+		connectMicros = 0;
+		firstByteMicros = 0;
+		bodyBytes = 0;
+		response.contentType[0] = '\0';
+
+		char newHost[FEED_HOST_LEN];
+		uint16_t newPort;
+		if (!parseFeedUrl(url, newHost, newPort, path)) {
+			return FEED_ERROR_URL;
+		}
+
+		// Reuse the kept-alive connection if it is to the same server, retry a GET once on a fresh one if it went stale.
+		// A POST is not retried, the server may have acted on it before the connection dropped.
+		reused = client.connected() && port == newPort && strcmp(host, newHost) == 0;
+		if (!reused) {
+			client.stop();
+			strncpy(host, newHost, sizeof(host));
+			port = newPort;
+		}
+
+		int status = request(validators, sink);
+		if (status == FEED_ERROR_PROTOCOL && reused && !response.started() && !requestBody) {
+			client.stop();
+			reused = false;
+			status = request(validators, sink);
+		}
+
+		if (status < 0 || !response.keepAlive) {
+			client.stop();
+		}
+		bodyBytes = response.bodyBytes;
+		totalMicros = micros() - startMicros;
+		return status;
+	}
+
+	int32_t remainingMs() const {
+		return int32_t(deadline - millis());
+	}
+
+	int request(FeedValidators& validators, BodySink& sink) {
+		response.begin(validators, sink);
+		if (!client.connected()) {
+			if (remainingMs() <= 0 || !client.connect(host, port, remainingMs())) {
+				return FEED_ERROR_CONNECT;
+			}
+			client.setNoDelay(true);
+			connectMicros = micros() - startMicros;
+		}
+
+		int length = formatFeedRequest(reinterpret_cast<char*>(buffer),
+									   sizeof(buffer),
+									   host,
+									   path,
+									   validators,
+									   requestBody ? requestContentType : nullptr,
+									   requestBodyLength);
+		if (length < 0 || client.write(buffer, length) != size_t(length)) {
+			return FEED_ERROR_PROTOCOL;
+		}
+		if (requestBody && client.write(requestBody, requestBodyLength) != requestBodyLength) {
+			return FEED_ERROR_PROTOCOL;
+		}
+
+		while (true) {
+			if (!waitForData()) {
+				if (remainingMs() <= 0) {
+					response.abort();
+					return FEED_ERROR_TIMEOUT;
+				}
+				return response.finish();  // Closed, the end of a close delimited body
+			}
+			int got = client.read(buffer, sizeof(buffer));
+			if (got <= 0) {
+				continue;
+			}
+
+			int result = response.feed(buffer, got);
+			if (firstByteMicros == 0 && response.started()) {
+				firstByteMicros = micros() - startMicros;
+			}
+			if (result != FEED_PENDING) {
+				return result;
+			}
+		}
+	}
+
+	// Wait for at least one byte, returns false on deadline or disconnect
+	bool waitForData() {
+		while (client.available() == 0) {
+			if (!client.connected() || remainingMs() <= 0) {
+				return false;
+			}
+			vTaskDelay(1);
+		}
+		return true;
+	}
+};
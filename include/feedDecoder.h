@@ -0,0 +1,201 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <FastLED.h>
+#include <vector>
+
+#include "feedSource.h"
+#include "log.h"
+#include "traversalLearner.h"
+
+#define FEED_MAX_DECODERS 8
+
+/// A decoded feed document, the same whatever format it arrived in
+struct FeedData {
+	String version;
+	time_t timestamp = 0;		 // Base timestamp, update offsets are relative to it
+	uint8_t updateInterval = 0;	 // Seconds until the next document, 0 if the document does not say
+	std::vector<CRGB> colors;
+	std::vector<uint16_t> routeKeys;  // TraversalLearner route key of each colour
+	std::vector<LedUpdate> updates;	  // colorId indexes colors
+};
+
+/// Parse state shared by the sniffer and the decoder of one document
+struct FeedContext {
+	const uint8_t* body;
+	size_t length;
+	JsonDocument json;	// Filled by the JSON sniffer so JSON decoders do not parse twice
+
+	FeedContext(const uint8_t* body, size_t length) : body(body), length(length) {}
+};
+
+/**
+ * @brief Decodes feed documents with the decoder registered for their format and version
+ *
+ * Each content type has a sniffer that reads just enough of the document to find its
+ * version (for JSON that is the one full parse, kept in the context for the decoder).
+ * The decoder registered for that content type and version then fills a FeedData. The
+ * decoder is chosen once per document, so the per-update loops are the decoder's own
+ * straight-line code with no dispatch.
+ *
+ * A decoder registered with a null version is the fallback for its content type, used
+ * (with a warning) for versions nothing else claims.
+ */
+class FeedDecoderRegistry {
+  public:
+	/// Reads the version of a document, false if it is not in this format
+	using Sniffer = bool (*)(FeedContext& context, String& version);
+	/// Fills data from a sniffed document, false if it is malformed
+	using Decoder = bool (*)(FeedContext& context, FeedData& data);
+
+	/**
+	 * @brief Register the sniffer for a content type, must come before its decoders
+	 *
+	 * @param contentType MIME type without parameters
+	 * @param sniffer Version reader
+	 */
+	void addFormat(const char* contentType, Sniffer sniffer) {
+		if (numFormats < FEED_MAX_DECODERS) {
+			formats[numFormats++] = { contentType, sniffer };
+		}
+	}
+
+	/**
+	 * @brief Register a decoder
+	 *
+	 * @param contentType MIME type without parameters
+	 * @param version Version it decodes, nullptr for any version
+	 * @param decoder Decoder
+	 */
+	void add(const char* contentType, const char* version, Decoder decoder) {
+		if (numDecoders < FEED_MAX_DECODERS) {
+			decoders[numDecoders++] = { contentType, version, decoder };
+		}
+	}
+
+	/**
+	 * @brief Decode a document
+	 *
+	 * @param contentType Content-Type of the response, may be empty (the format is then guessed)
+	 * @param body Document
+	 * @param length Document length
+	 * @param data Decoded document
+	 * @return true if a decoder accepted the document
+	 */
+	bool decode(const char* contentType, const uint8_t* body, size_t length, FeedData& data) {
+		FeedContext context(body, length);
+
+		const Format* format = findFormat(contentType);
+		if (format == nullptr && length > 0 && body[0] == '{') {
+			format = findFormat("application/json");  // Servers that send text/plain or nothing
+		}
+		if (format == nullptr) {
+			LOG_E("No feed decoder for content type \"%s\"", contentType);
+			return false;
+		}
+		if (!format->sniffer(context, data.version)) {
+			return false;
+		}
+
+		const Entry* fallback = nullptr;
+		for (uint8_t i = 0; i < numDecoders; i++) {
+			const Entry& entry = decoders[i];
+			if (strcmp(entry.contentType, format->contentType) != 0) {
+				continue;
+			}
+			if (entry.version == nullptr) {
+				fallback = fallback ? fallback : &entry;
+			} else if (data.version == entry.version) {
+				return entry.decoder(context, data);
+			}
+		}
+
+		if (fallback == nullptr) {
+			LOG_E("No feed decoder for %s version %s", format->contentType, data.version.c_str());
+			return false;
+		}
+		LOG_W("No feed decoder for version %s, using the %s fallback", data.version.c_str(), format->contentType);
+		return fallback->decoder(context, data);
+	}
+
+  private:
+	struct Format {
+		const char* contentType;
+		Sniffer sniffer;
+	};
+
+	struct Entry {
+		const char* contentType;
+		const char* version;
+		Decoder decoder;
+	};
+
+	Format formats[FEED_MAX_DECODERS];
+	Entry decoders[FEED_MAX_DECODERS];
+	uint8_t numFormats = 0;
+	uint8_t numDecoders = 0;
+
+	const Format* findFormat(const char* contentType) const {
+		for (uint8_t i = 0; i < numFormats; i++) {
+			if (strcasecmp(formats[i].contentType, contentType) == 0) {
+				return &formats[i];
+			}
+		}
+		return nullptr;
+	}
+};
+
+// --- JSON ---
+
+inline bool sniffJsonFeed(FeedContext& context, String& version) {
+	DeserializationError error = deserializeJson(context.json, context.body, context.length);
+	if (error) {
+		LOG_E("JSON parse error: %s", error.c_str());
+		return false;
+	}
+	version = context.json["version"] | "";
+	return true;
+}
+
+/**
+ * @brief Backend versions 100 and 110
+ *
+ * {"version": "110", "timestamp": 1700000000, "update": 30, "colors": {"<route>": [r, g, b], ...},
+ *  "updates": [{"b": [preBlock, postBlock], "c": colorId, "t": offset}, ...]}
+ */
+inline bool decodeJsonFeedV1(FeedContext& context, FeedData& data) {
+	JsonDocument& doc = context.json;
+	data.timestamp = doc["timestamp"] | 0;
+	data.updateInterval = doc["update"] | 0;
+	JsonObject colors = doc["colors"];
+	JsonArray updates = doc["updates"];
+
+	for (JsonPair kv : colors) {
+		JsonArray rgb = kv.value().as<JsonArray>();
+		data.colors.push_back(CRGB(rgb[0] | 0, rgb[1] | 0, rgb[2] | 0));
+		data.routeKeys.push_back(TraversalLearner::routeKey(kv.key().c_str()));
+	}
+
+	data.updates.reserve(updates.size());
+	for (JsonObject update : updates) {
+		JsonArray blocks = update["b"];
+		int offset = update["t"];
+
+		LedUpdate ledUpdate;
+		ledUpdate.preBlock = blocks[0];
+		ledUpdate.postBlock = blocks[1];
+		ledUpdate.timestamp = (offset > 0) ? data.timestamp + offset : 0;
+		ledUpdate.colorId = update["c"];
+		data.updates.push_back(ledUpdate);
+	}
+	return true;
+}
+
+/// Registry with the decoders for every backend version this firmware understands
+inline void registerFeedDecoders(FeedDecoderRegistry& registry) {
+	registry.addFormat("application/json", sniffJsonFeed);
+	registry.add("application/json", "100", decodeJsonFeedV1);
+	registry.add("application/json", "110", decodeJsonFeedV1);
+	registry.add("application/json", nullptr, decodeJsonFeedV1);  // Unknown versions: best effort
+}
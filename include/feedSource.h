@@ -0,0 +1,146 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include <algorithm>
+#include <vector>
+
+#include "feedClient.h"
+#include "log.h"
+
+#define FEED_MAX_MIRRORS 3
+#define FEED_MAX_COLORS 255	 // Merged colour ids must fit the renderer's uint8_t per block priority
+
+// --- Data structure for scheduled LED updates ---
+struct LedUpdate {
+	uint16_t preBlock;
+	uint16_t postBlock;
+	int colorId;
+	time_t timestamp;  // Timestamp for when the update should occur
+};
+
+/**
+ * @brief One realtime feed and everything fetched from it
+ *
+ * A feed is served by one or more mirrors (tried in turn on failure) and keeps its own
+ * fetch cadence, HTTP validators and colour table, so feeds from different operators
+ * never share state. Colour ids in updates are local to the feed until merged.
+ */
+struct FeedSource {
+	const char* name;
+	String mirrors[FEED_MAX_MIRRORS];
+	uint8_t numMirrors;
+	uint8_t priority;  // Higher priority feeds are drawn over lower ones on shared blocks
+
+	String overrides[FEED_MAX_MIRRORS];	 // Mirrors set at runtime (remote config), used instead when present
+	uint8_t numOverrides = 0;
+	uint8_t mirrorIndex = 0;
+	FeedValidators validators;	 // ETag / Last-Modified of the last document, per mirror
+	unsigned int sizeHint = 0;	 // Largest document seen, reserved up front to avoid reallocations
+	time_t nextFetchTime = 0;
+	uint8_t updateInterval = 30;  // Seconds, from the document's "update" field
+
+	std::vector<CRGB> colors;
+	std::vector<uint16_t> routeKeys;  // TraversalLearner route key of each colour
+	std::vector<LedUpdate> updates;	  // colorId indexes colors
+
+	FeedSource(const char* name, std::initializer_list<String> urls, uint8_t priority)
+		: name(name), numMirrors(0), priority(priority) {
+		for (const String& url : urls) {
+			if (numMirrors < FEED_MAX_MIRRORS) {
+				mirrors[numMirrors++] = url;
+			}
+		}
+	}
+
+	const String& url() const {
+		return numOverrides ? overrides[mirrorIndex % numOverrides] : mirrors[mirrorIndex % numMirrors];
+	}
+
+	/// Switch to the next mirror after a failed fetch
+	void failover() {
+		mirrorIndex = (mirrorIndex + 1) % (numOverrides ? numOverrides : numMirrors);
+		validators.clear();	 // Validators are per server
+	}
+
+	/**
+	 * @brief Replace the declared mirrors at runtime
+	 *
+	 * @param urls Mirror URLs
+	 * @param count Number of URLs, 0 goes back to the declared mirrors
+	 */
+	void overrideMirrors(const char* const* urls, uint8_t count) {
+		bool changed = count != numOverrides;
+		numOverrides = 0;
+		for (uint8_t i = 0; i < count && i < FEED_MAX_MIRRORS; i++) {
+			changed |= overrides[i] != urls[i];
+			overrides[numOverrides++] = urls[i];
+		}
+		if (changed) {
+			mirrorIndex = 0;
+			validators.clear();
+		}
+	}
+
+	bool isDue(time_t epoch) const {
+		return epoch > nextFetchTime;
+	}
+
+	/// No fresh data for a whole update interval
+	bool isLate(time_t epoch) const {
+		return epoch > nextFetchTime + updateInterval;
+	}
+};
+
+/**
+ * @brief Merge the colour tables and schedules of several feeds into one
+ *
+ * Feeds are appended in ascending priority (ties keep their declaration order), so every
+ * colour id of a higher priority feed is above those of lower ones. The renderer keeps the
+ * highest colour id per block, so the merged schedule draws with the same deterministic
+ * priority and the renderer does not need to know how many feeds there are.
+ *
+ * @param feeds Feeds to merge
+ * @param count Number of feeds
+ * @param colorTable Merged colours
+ * @param routeKeys Merged route keys, parallel to colorTable
+ * @param schedule Merged updates with global colour ids
+ */
+inline void mergeFeeds(const FeedSource* feeds,
+					   size_t count,
+					   std::vector<CRGB>& colorTable,
+					   std::vector<uint16_t>& routeKeys,
+					   std::vector<LedUpdate>& schedule) {
+	std::vector<const FeedSource*> order;
+	size_t totalUpdates = 0;
+	for (size_t i = 0; i < count; i++) {
+		order.push_back(&feeds[i]);
+		totalUpdates += feeds[i].updates.size();
+	}
+	std::stable_sort(order.begin(), order.end(), [](const FeedSource* a, const FeedSource* b) {
+		return a->priority < b->priority;
+	});
+
+	colorTable.clear();
+	routeKeys.clear();
+	schedule.clear();
+	schedule.reserve(totalUpdates);
+
+	for (const FeedSource* feed : order) {
+		const int offset = colorTable.size();
+		if (offset + feed->colors.size() > FEED_MAX_COLORS) {
+			LOG_W("Feed %s skipped: more than %d colours across all feeds", feed->name, FEED_MAX_COLORS);
+			continue;
+		}
+		colorTable.insert(colorTable.end(), feed->colors.begin(), feed->colors.end());
+		routeKeys.insert(routeKeys.end(), feed->routeKeys.begin(), feed->routeKeys.end());
+
+		for (LedUpdate update : feed->updates) {
+			if (update.colorId < 0 || update.colorId >= static_cast<int>(feed->colors.size())) {
+				continue;  // Would otherwise pick up another feed's colour
+			}
+			update.colorId += offset;
+			schedule.push_back(update);
+		}
+	}
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include <time.h>
+
+#if !defined(HEATMAP_WINDOW_MINUTES)
+	#define HEATMAP_WINDOW_MINUTES 60  // Trains in roughly the last hour, 0 = since local midnight
+#endif
+#define HEATMAP_VISIT 256  // Heat added per train entering a block (8 fractional bits for the decay)
+
+#if defined(LED_2_PIN)
+	#define HEATMAP_BLOCKS (LED_1_PIXELS + LED_2_PIXELS)
+#else
+	#define HEATMAP_BLOCKS LED_1_PIXELS
+#endif
+
+/**
+ * @brief Block occupancy over a time window, shown as a heat gradient
+ *
+ * Every train entering a block adds to that block's heat. With a window in minutes the
+ * heat decays exponentially (half-life of a quarter of the window, so trains older than
+ * the window have faded to under a tenth), with 0 it counts since local midnight.
+ *
+ * Decay is lazy: each block keeps its heat and the time it was last brought up to date,
+ * and is only decayed when a train enters it or the map is drawn, so a transition is
+ * O(1) and nothing runs per frame. A block is brought up to date at most once per
+ * sixteenth of a half-life, so with long windows the minutes in between are not rounded
+ * away. The whole map costs 8 bytes per LED.
+ */
+class Heatmap {
+  public:
+	/**
+	 * @brief Count a train entering a block, called for every transition the renderer applies
+	 *
+	 * @param block Block entered (the transition's post block)
+	 * @param timestamp Time of the transition
+	 */
+	void onTransition(uint16_t block, time_t timestamp) {
+		int index = blockIndex(block);
+		if (index < 0) {
+			return;
+		}
+		Cell& cell = cells[index];
+		bringUpToDate(cell, stamp(timestamp));
+		cell.heat = min(uint32_t(cell.heat) + HEATMAP_VISIT, uint32_t(UINT16_MAX));
+	}
+
+	/**
+	 * @brief Colour every block by its heat relative to the hottest block
+	 *
+	 * @param epoch Current time
+	 * @param setBlock Called with each block number and its colour
+	 */
+	template <typename SetBlock>
+	void draw(time_t epoch, SetBlock setBlock) {
+		uint32_t now = stamp(epoch);
+		uint16_t hottest = 0;
+		for (Cell& cell : cells) {
+			bringUpToDate(cell, now);
+			hottest = max(hottest, cell.heat);
+		}
+
+		for (uint16_t i = 0; i < HEATMAP_BLOCKS; i++) {
+			uint16_t block = (i < LED_1_PIXELS) ? 100 + i : 300 + (i - LED_1_PIXELS);
+			if (cells[i].heat == 0) {
+				setBlock(block, CRGB::Black);
+			} else {
+				uint8_t level = max(uint32_t(cells[i].heat) * 255 / hottest, uint32_t(1));
+				setBlock(block, ColorFromPalette(palette, level, 255, LINEARBLEND));
+			}
+		}
+	}
+
+  private:
+	struct Cell {
+		uint32_t stamp;	 // Minute (decaying window) or local day (since midnight) of the last update
+		uint16_t heat;	 // Trains * HEATMAP_VISIT, decayed up to stamp
+	};
+
+#if HEATMAP_WINDOW_MINUTES > 0
+	static constexpr uint32_t halfLife = HEATMAP_WINDOW_MINUTES >= 4 ? HEATMAP_WINDOW_MINUTES / 4 : 1;	// Minutes
+	static constexpr int32_t decayStep = (halfLife + 15) / 16;  // Minutes, at least a sixteenth of a halving
+#else
+	static constexpr int32_t decayStep = 1;	 // A day
+#endif
+
+	Cell cells[HEATMAP_BLOCKS] = {};
+	CRGBPalette16 palette = HeatColors_p;  // Black through red and yellow to white
+	time_t dayStart = 0;  // Local day last looked up, for the since-midnight window
+	time_t dayEnd = 0;
+	uint32_t day = 0;
+
+	static int blockIndex(uint16_t block) {
+		if (block >= 100 && block < 100 + LED_1_PIXELS) {
+			return block - 100;
+#if defined(LED_2_PIN)
+		} else if (block >= 300 && block < 300 + LED_2_PIXELS) {
+			return LED_1_PIXELS + (block - 300);
+#endif
+		}
+		return -1;
+	}
+
+	// Minutes since the epoch, or the local day number when counting since midnight
+	uint32_t stamp(time_t timestamp) {
+#if HEATMAP_WINDOW_MINUTES > 0
+		return uint32_t(timestamp / 60);
+#else
+		if (timestamp < dayStart || timestamp >= dayEnd) {	// Only when the day changes
+			struct tm local;
+			localtime_r(&timestamp, &local);
+			day = uint32_t(local.tm_year * 366 + local.tm_yday);
+			local.tm_hour = 0;
+			local.tm_min = 0;
+			local.tm_sec = 0;
+			dayStart = mktime(&local);
+			local.tm_mday += 1;
+			dayEnd = mktime(&local);
+		}
+		return day;
+#endif
+	}
+
+	static void bringUpToDate(Cell& cell, uint32_t now) {
+		int32_t elapsed = int32_t(now - cell.stamp);
+		if (cell.heat == 0) {
+			cell.stamp = now;
+			return;
+		}
+		if (elapsed < decayStep) {
+			return;	 // Decayed less than a step (the time is kept for the next one), or older than the last update
+		}
+		cell.stamp = now;
+
+#if HEATMAP_WINDOW_MINUTES > 0
+		// 2^(-i/16) in 0.16 fixed point, the fractional part of the decay is interpolated between these
+		static const uint16_t fractionalDecay[17] = { 65535, 62757, 60097, 57549, 55109, 52773, 50535, 48393, 46341,
+													  44376, 42495, 40693, 38968, 37316, 35734, 34219, 32768 };
+		uint32_t halvings = elapsed / halfLife;
+		if (halvings >= 16) {
+			cell.heat = 0;
+			return;
+		}
+		uint32_t sixteenths = elapsed % halfLife * 16;
+		uint32_t i = sixteenths / halfLife;
+		uint32_t decay = fractionalDecay[i] - (fractionalDecay[i] - fractionalDecay[i + 1]) * (sixteenths % halfLife) / halfLife;
+		cell.heat = (uint32_t(cell.heat >> halvings) * decay) >> 16;
+#else
+		cell.heat = 0;	// A new day
+#endif
+	}
+};
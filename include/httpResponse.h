@@ -0,0 +1,414 @@
+#pragma once
+
+#include <Arduino.h>
+#include <functional>
+
+#include "rom/miniz.h"
+
+#define FEED_LINE_LEN 256		// Longest status or header line kept (longer lines are truncated)
+#define FEED_VALIDATOR_LEN 64	// ETag / Last-Modified
+#define FEED_CONTENT_TYPE_LEN 48
+
+// Negative results, positive results are HTTP status codes (like HTTPClient)
+#define FEED_PENDING 0	// Response not complete yet
+#define FEED_ERROR_URL -1
+#define FEED_ERROR_CONNECT -2
+#define FEED_ERROR_TIMEOUT -3
+#define FEED_ERROR_PROTOCOL -4
+#define FEED_ERROR_SINK -5
+#define FEED_ERROR_INFLATE -6
+
+/// Receives decoded body bytes, return false to abort the transfer
+using BodySink = std::function<bool(const uint8_t* data, size_t length)>;
+
+/**
+ * @brief Conditional GET validators from the last 200 response of a resource
+ *
+ * Owned by the caller so each resource (feed, config, ...) keeps its own.
+ */
+struct FeedValidators {
+	char etag[FEED_VALIDATOR_LEN] = "";
+	char lastModified[FEED_VALIDATOR_LEN] = "";
+
+	void clear() {
+		etag[0] = '\0';
+		lastModified[0] = '\0';
+	}
+};
+
+/**
+ * @brief Streaming gzip (RFC 1952) decoder for HTTP bodies
+ *
+ * Takes the body in whatever pieces the socket delivers and passes the decompressed bytes
+ * on as they come out. The decompressor and its 32KiB window are only allocated between
+ * begin() and end(), so they cost nothing between requests.
+ */
+class GzipInflater {
+  public:
+	bool begin() {
+		inflator = static_cast<tinfl_decompressor*>(malloc(sizeof(tinfl_decompressor)));
+		window = static_cast<uint8_t*>(malloc(TINFL_LZ_DICT_SIZE));
+		if (inflator == nullptr || window == nullptr) {
+			end();
+			return false;
+		}
+		tinfl_init(inflator);
+		windowOffset = 0;
+		gzipHeaderState = 0;
+		gzipHeaderLeft = 10;
+		inflateDone = false;
+		return true;
+	}
+
+	void end() {
+		free(inflator);
+		free(window);
+		inflator = nullptr;
+		window = nullptr;
+	}
+
+	/**
+	 * @brief Decompress the next part of the body
+	 *
+	 * @param data Compressed bytes as received
+	 * @param length Number of bytes
+	 * @param sink Receives the decompressed bytes
+	 * @param bodyBytes Incremented by the number of decompressed bytes
+	 * @return int 0, or FEED_ERROR_INFLATE / FEED_ERROR_SINK
+	 */
+	int inflate(const uint8_t* data, size_t length, const BodySink& sink, uint32_t& bodyBytes) {
+		size_t used = skipGzipHeader(data, length);
+		data += used;
+		length -= used;
+
+		// Anything after the deflate stream is the CRC32/ISIZE trailer
+		while (!inflateDone) {
+			size_t inBytes = length;
+			size_t outBytes = TINFL_LZ_DICT_SIZE - windowOffset;
+			tinfl_status status = tinfl_decompress(
+				inflator, data, &inBytes, window, window + windowOffset, &outBytes, TINFL_FLAG_HAS_MORE_INPUT);
+			data += inBytes;
+			length -= inBytes;
+
+			if (outBytes > 0) {
+				bodyBytes += outBytes;
+				if (!sink(window + windowOffset, outBytes)) {
+					return FEED_ERROR_SINK;
+				}
+				windowOffset = (windowOffset + outBytes) & (TINFL_LZ_DICT_SIZE - 1);
+			}
+
+			if (status == TINFL_STATUS_DONE) {
+				inflateDone = true;
+			} else if (status < TINFL_STATUS_DONE) {
+				return FEED_ERROR_INFLATE;
+			} else if (status == TINFL_STATUS_NEEDS_MORE_INPUT && length == 0) {
+				break;	// Wait for the next read
+			}
+		}
+		return 0;
+	}
+
+  private:
+	tinfl_decompressor* inflator = nullptr;
+	uint8_t* window = nullptr;
+	size_t windowOffset = 0;
+	uint8_t gzipHeaderFlags = 0;
+	uint16_t gzipHeaderLeft = 0;
+	uint8_t gzipHeaderState = 0;
+	bool inflateDone = false;
+
+	// Skips the gzip member header (RFC 1952), returns the number of bytes consumed
+	size_t skipGzipHeader(const uint8_t* data, size_t length) {
+		enum { FIXED, EXTRA_LENGTH_LOW, EXTRA_LENGTH_HIGH, EXTRA, NAME, COMMENT, CRC, DONE };
+		size_t used = 0;
+		while (used < length && gzipHeaderState != DONE) {
+			// Optional fields that are not present take no bytes
+			if (gzipHeaderState == NAME && !(gzipHeaderFlags & 0x08)) {
+				gzipHeaderState = COMMENT;
+				continue;
+			}
+			if (gzipHeaderState == COMMENT && !(gzipHeaderFlags & 0x10)) {
+				gzipHeaderState = CRC;
+				gzipHeaderLeft = 2;
+				continue;
+			}
+			if (gzipHeaderState == CRC && !(gzipHeaderFlags & 0x02)) {
+				gzipHeaderState = DONE;
+				continue;
+			}
+
+			uint8_t c = data[used++];
+			switch (gzipHeaderState) {
+				case FIXED:
+					if (gzipHeaderLeft == 7) {
+						gzipHeaderFlags = c;  // FLG is the 4th byte
+					}
+					if (--gzipHeaderLeft == 0) {
+						gzipHeaderState = (gzipHeaderFlags & 0x04) ? EXTRA_LENGTH_LOW : NAME;
+					}
+					break;
+				case EXTRA_LENGTH_LOW:
+					gzipHeaderLeft = c;
+					gzipHeaderState = EXTRA_LENGTH_HIGH;
+					break;
+				case EXTRA_LENGTH_HIGH:
+					gzipHeaderLeft |= c << 8;
+					gzipHeaderState = gzipHeaderLeft ? EXTRA : NAME;
+					break;
+				case EXTRA:
+					if (--gzipHeaderLeft == 0) {
+						gzipHeaderState = NAME;
+					}
+					break;
+				case NAME:
+					if (c == 0) {
+						gzipHeaderState = COMMENT;
+					}
+					break;
+				case COMMENT:
+					if (c == 0) {
+						gzipHeaderState = CRC;
+						gzipHeaderLeft = 2;
+					}
+					break;
+				case CRC:
+					if (--gzipHeaderLeft == 0) {
+						gzipHeaderState = DONE;
+					}
+					break;
+			}
+		}
+		return used;
+	}
+};
+
+/**
+ * @brief Incremental HTTP/1.1 response decoder
+ *
+ * Fed whatever the socket delivered, in pieces of any size, so the same decoder serves the
+ * blocking FeedClient (which reads into a buffer) and the AsyncFeedClient (which is handed
+ * the received segments in a callback). Handles Content-Length, chunked and close delimited
+ * bodies with optional gzip, passing the body of a 200 to the sink as it is decoded and
+ * discarding any other body so the connection can be reused.
+ */
+class HttpResponse {
+  public:
+	/**
+	 * @brief Start decoding a new response
+	 *
+	 * @param validators Updated when a 200 is complete, must outlive the response
+	 * @param sink Receives the body of a 200, must outlive the response
+	 */
+	void begin(FeedValidators& validators, const BodySink& sink) {
+		inflater.end();
+		this->validators = &validators;
+		this->sink = &sink;
+		state = STATUS;
+		status = 0;
+		lineLength = 0;
+		contentLength = -1;
+		chunked = false;
+		gzip = false;
+		keepAlive = false;
+		etag[0] = '\0';
+		lastModified[0] = '\0';
+		contentType[0] = '\0';
+		bodyBytes = 0;
+	}
+
+	/**
+	 * @brief Decode the next bytes received
+	 *
+	 * @param data Bytes as received
+	 * @param length Number of bytes
+	 * @return int FEED_PENDING while the response is incomplete, then the HTTP status or a negative FEED_ERROR_* code
+	 */
+	int feed(const uint8_t* data, size_t length) {
+		int result = FEED_PENDING;
+		while (length > 0 && result == FEED_PENDING) {
+			if (state == BODY) {
+				size_t used = (remaining < 0) ? length : min(length, size_t(remaining));
+				result = deliver(data, used);
+				data += used;
+				length -= used;
+				if (remaining > 0) {
+					remaining -= used;
+				}
+				if (result == FEED_PENDING && remaining == 0) {
+					if (chunked) {
+						state = CHUNK_SIZE;
+					} else {
+						result = complete();
+					}
+				}
+			} else if (state == DONE) {
+				break;	// Nothing more is expected, there is no pipelining
+			} else {
+				uint8_t c = *data++;
+				length--;
+				if (c == '\n') {
+					line[lineLength] = '\0';
+					result = onLine();
+					lineLength = 0;
+				} else if (c != '\r' && lineLength < FEED_LINE_LEN - 1) {
+					line[lineLength++] = char(c);
+				}
+			}
+		}
+		if (result < 0) {
+			abort();
+		}
+		return result;
+	}
+
+	/**
+	 * @brief The server closed the connection
+	 *
+	 * @return int The HTTP status if that ended a close delimited body, otherwise FEED_ERROR_PROTOCOL
+	 */
+	int finish() {
+		if (state == BODY && remaining < 0) {
+			return complete();
+		}
+		abort();
+		return FEED_ERROR_PROTOCOL;
+	}
+
+	/// Give up on the response (timeout, disconnect) and free the decompressor
+	void abort() {
+		inflater.end();
+		state = DONE;
+	}
+
+	/// The status line has been received (still true after the response ends or is aborted)
+	bool started() const {
+		return status != 0;
+	}
+
+	int status = 0;
+	bool keepAlive = false;	 // Connection can be used for the next request
+	uint32_t bodyBytes = 0;	 // Decoded body size
+	char contentType[FEED_CONTENT_TYPE_LEN] = "";  // Without parameters
+
+  private:
+	enum State : uint8_t { STATUS, HEADERS, BODY, CHUNK_SIZE, TRAILERS, DONE };
+
+	State state = DONE;
+	char line[FEED_LINE_LEN];
+	uint16_t lineLength = 0;
+	int32_t contentLength = -1;
+	int32_t remaining = 0;	// Body or chunk bytes still to come, -1 until close
+	bool chunked = false;
+	bool gzip = false;
+	char etag[FEED_VALIDATOR_LEN] = "";
+	char lastModified[FEED_VALIDATOR_LEN] = "";
+	FeedValidators* validators = nullptr;
+	const BodySink* sink = nullptr;
+	GzipInflater inflater;
+
+	int onLine() {
+		switch (state) {
+			case STATUS:
+				if (sscanf(line, "HTTP/1.%*d %d", &status) != 1 || status < 100) {
+					return FEED_ERROR_PROTOCOL;
+				}
+				keepAlive = strncmp(line, "HTTP/1.1", 8) == 0;
+				state = HEADERS;
+				return 0;
+
+			case HEADERS:
+				if (lineLength == 0) {
+					return beginBody();
+				}
+				onHeader();
+				return 0;
+
+			case CHUNK_SIZE:
+				if (lineLength == 0) {
+					return 0;  // CRLF after the previous chunk
+				}
+				remaining = strtoul(line, nullptr, 16);
+				state = remaining ? BODY : TRAILERS;
+				return 0;
+
+			case TRAILERS:
+				return lineLength == 0 ? complete() : 0;
+
+			default:
+				return 0;
+		}
+	}
+
+	void onHeader() {
+		char* value = strchr(line, ':');
+		if (value == nullptr) {
+			return;
+		}
+		*value++ = '\0';
+		while (*value == ' ') {
+			value++;
+		}
+
+		if (strcasecmp(line, "Content-Length") == 0) {
+			contentLength = atol(value);
+		} else if (strcasecmp(line, "Transfer-Encoding") == 0) {
+			chunked = strcasestr(value, "chunked") != nullptr;
+		} else if (strcasecmp(line, "Content-Encoding") == 0) {
+			gzip = strcasestr(value, "gzip") != nullptr;
+		} else if (strcasecmp(line, "Connection") == 0) {
+			keepAlive = strcasecmp(value, "close") != 0;
+		} else if (strcasecmp(line, "Content-Type") == 0) {
+			strncpy(contentType, value, sizeof(contentType) - 1);
+			contentType[strcspn(contentType, "; ")] = '\0';
+		} else if (strcasecmp(line, "ETag") == 0) {
+			strncpy(etag, value, sizeof(etag) - 1);
+		} else if (strcasecmp(line, "Last-Modified") == 0) {
+			strncpy(lastModified, value, sizeof(lastModified) - 1);
+		}
+	}
+
+	int beginBody() {
+		if (status == 204 || status == 304 || (status >= 100 && status < 200)) {
+			return complete();
+		}
+		if (chunked) {
+			state = CHUNK_SIZE;
+		} else if (contentLength == 0) {
+			return complete();
+		} else {
+			state = BODY;
+			remaining = contentLength;
+			if (contentLength < 0) {
+				keepAlive = false;	// Body runs until the server closes the connection
+			}
+		}
+		if (gzip && !inflater.begin()) {
+			return FEED_ERROR_INFLATE;
+		}
+		return 0;
+	}
+
+	// Other statuses are read (and discarded) so the connection can be reused
+	int deliver(const uint8_t* data, size_t length) {
+		static const BodySink discard = [](const uint8_t*, size_t) {
+			return true;
+		};
+		const BodySink& target = (status == 200) ? *sink : discard;
+		if (!gzip) {
+			bodyBytes += length;
+			return target(data, length) ? 0 : FEED_ERROR_SINK;
+		}
+		return inflater.inflate(data, length, target, bodyBytes);
+	}
+
+	int complete() {
+		inflater.end();
+		state = DONE;
+		if (status == 200) {
+			strcpy(validators->etag, etag);
+			strcpy(validators->lastModified, lastModified);
+		}
+		return status;
+	}
+};
@@ -0,0 +1,317 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include <driver/rmt.h>
+#include <esp_heap_caps.h>
+
+#include "eventBus.h"
+#include "log.h"
+#include "powerManagement.h"
+
+// PowerManager and EventBus are in main.cpp
+extern PowerManager power;
+extern EventBus eventBus;
+
+// WS2811 bit timing in RMT ticks (80MHz APB / 2 = 25ns), FastLED's 320/320/640ns split rounded up to whole ticks
+#define LED_RMT_CLK_DIV 2
+#define LED_T1_TICKS 13
+#define LED_T2_TICKS 13
+#define LED_T3_TICKS 26
+#define LED_BIT_NANOS ((LED_T1_TICKS + LED_T2_TICKS + LED_T3_TICKS) * 25)
+#define LED_MAX_STRANDS 2
+#define LED_RMT_MEM_BLOCKS 4  // ESP32-C3: 4 x 48 item blocks shared by all channels
+#define LED_RMT_INTR_FLAGS ESP_INTR_FLAG_LEVEL3	 // Service refills ahead of the Wi-Fi MAC interrupt
+#define LED_GAMMA 2.0f							 // Applied to the 8-bit colours on the way to 16 bits
+#define LED_DITHER_BITS 4  // Sub-LSB levels from temporal dithering, the faintest level repeats every 2^bits frames
+
+/**
+ * @brief Non-blocking WS2811 output driver on the RMT peripheral
+ *
+ * Each strand owns two pre-encoded RMT item buffers. show() encodes the pixels into the
+ * idle buffer, waits for the previous frame to finish (normally already done), then starts
+ * every strand from the freshly encoded buffer and returns while the hardware transmits.
+ * The RMT end-of-transmit interrupt notifies the task that called show() once all strands
+ * are done, so the next frame's encoding overlaps the current transmit.
+ *
+ * The firmware keeps drawing 8-bit sRGB colours into CRGB buffers. The encoder expands each
+ * channel through a 16-bit gamma table and applies the 16-bit brightness gain at full
+ * precision, so dim colours keep their hue instead of collapsing to a few 8-bit levels.
+ * The 16-bit result is sent as 8 bits plus a per-channel sigma-delta dither: the quantisation
+ * error of each frame is carried into the next, so over 2^LED_DITHER_BITS frames the average
+ * output matches the 16-bit value to 1/2^LED_DITHER_BITS of an LSB.
+ *
+ * Wi-Fi interrupts can delay the RMT refill interrupt; if the hardware reaches the end of
+ * its memory before the refill it sends stale items and the frame runs long. To make that
+ * rare, every RMT memory block is given to the LED channels (the longest strand gets the
+ * most), and refills are plain copies from the pre-encoded buffer. An overrun of more than
+ * half a strand's memory is counted as an underrun and the frame is resent by repair().
+ */
+class LedOutput {
+  public:
+	/**
+	 * @brief Register a strand, must be called before begin()
+	 *
+	 * @param pin GPIO the strand data line is connected to
+	 * @param pixels Pixel buffer (GRB order is applied when encoding)
+	 * @param count Number of pixels in the strand
+	 */
+	void add(uint8_t pin, CRGB* pixels, uint16_t count) {
+		if (numStrands >= LED_MAX_STRANDS) {
+			LOG_E("No RMT channel left for LED pin %d!", pin);
+			return;
+		}
+		strands[numStrands] = { RMT_CHANNEL_0, 1, pin, pixels, count, 0, 0, { nullptr, nullptr }, nullptr };
+		numStrands++;
+	}
+
+	/**
+	 * @brief Install the RMT channels and allocate the encode buffers
+	 *
+	 * If it fails, show() and repair() must not be called.
+	 *
+	 * @return true if every strand is ready to transmit
+	 */
+	bool begin() {
+		assignMemoryBlocks();
+
+		for (uint16_t i = 0; i < 256; i++) {
+			gammaTable[i] = uint16_t(powf(i / 255.0f, LED_GAMMA) * 255.0f * 256.0f + 0.5f);	 // Max 0xFF00, never overflows the dither
+		}
+
+		for (uint8_t i = 0; i < numStrands; i++) {
+			Strand& strand = strands[i];
+
+			rmt_config_t config = RMT_DEFAULT_CONFIG_TX(gpio_num_t(strand.pin), strand.channel);
+			config.clk_div = LED_RMT_CLK_DIV;
+			config.mem_block_num = strand.memBlocks;
+
+			if (rmt_config(&config) != ESP_OK || rmt_driver_install(strand.channel, 0, LED_RMT_INTR_FLAGS) != ESP_OK) {
+				LOG_E("Failed to set up RMT channel %d for LED pin %d!", strand.channel, strand.pin);
+				return false;
+			}
+
+			for (uint8_t b = 0; b < 2; b++) {
+				strand.encoded[b] = static_cast<rmt_item32_t*>(
+					heap_caps_malloc(strand.count * 24 * sizeof(rmt_item32_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+				if (strand.encoded[b] == nullptr) {
+					LOG_E("Failed to allocate LED buffer for pin %d!", strand.pin);
+					return false;
+				}
+			}
+
+			// Spread the starting dither phases so neighbouring pixels at the same level do not blink in step
+			strand.residual = static_cast<uint8_t*>(heap_caps_malloc(strand.count * 3, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+			if (strand.residual == nullptr) {
+				LOG_E("Failed to allocate LED dither state for pin %d!", strand.pin);
+				return false;
+			}
+			for (uint16_t c = 0; c < strand.count * 3; c++) {
+				strand.residual[c] = (c * 7) & ((1 << LED_DITHER_BITS) - 1);
+			}
+
+			strand.wireMicros = uint32_t(strand.count) * 24 * LED_BIT_NANOS / 1000;
+			strand.slackMicros = uint32_t(strand.memBlocks) * SOC_RMT_MEM_WORDS_PER_CHANNEL / 2 * LED_BIT_NANOS / 1000;
+			LOG_D("LED pin %d on RMT channel %d with %d memory blocks", strand.pin, strand.channel, strand.memBlocks);
+		}
+
+		rmt_register_tx_end_callback(onTxEnd, this);
+		return true;
+	}
+
+	/**
+	 * @brief Encode the current pixels and start sending them
+	 *
+	 * Returns as soon as the transmit has started. Only one task may call show().
+	 */
+	void show() {
+		const uint8_t next = frontBuffer ^ 1;
+		const uint32_t startCycles = ESP.getCycleCount();
+		for (uint8_t i = 0; i < numStrands; i++) {
+			encode(strands[i], strands[i].encoded[next]);
+		}
+		maxEncodeCycles = max(maxEncodeCycles, ESP.getCycleCount() - startCycles);
+
+		// The previous frame must be off the wire before its channels can be reused
+		waitForCompletion(portMAX_DELAY);
+
+		frontBuffer = next;
+		retransmitsLeft = maxRetransmits;
+		transmit();
+	}
+
+	/**
+	 * @brief Resend the last frame if an underrun was detected while sending it
+	 *
+	 * Waits for the frame in flight to finish. Each frame is resent at most maxRetransmits times.
+	 *
+	 * @return true if the frame was resent
+	 */
+	bool repair() {
+		waitForCompletion(portMAX_DELAY);
+		if (!corrupted || retransmitsLeft == 0) {
+			return false;
+		}
+
+		retransmitsLeft--;
+		retransmits++;
+		transmit();
+		return true;
+	}
+
+	/**
+	 * @brief Block until the frame started by the last show() is fully sent
+	 *
+	 * @param timeout Ticks to wait for the completion notification
+	 * @return true if no transmit is in flight
+	 */
+	bool waitForCompletion(TickType_t timeout) {
+		while (pending > 0) {
+			if (ulTaskNotifyTake(pdTRUE, timeout) == 0) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool isBusy() const {
+		return pending > 0;
+	}
+
+	/**
+	 * @brief Set the output gain
+	 *
+	 * @param gain Linear brightness, 0 (off) to 65535 (full), applied to the gamma corrected colours
+	 */
+	void setBrightness(uint16_t gain) {
+		if (gain != brightness) {
+			brightness = gain;
+			eventBus.publishBrightness(gain);
+		}
+	}
+
+	uint16_t getBrightness() const {
+		return brightness;
+	}
+
+	// Transmit statistics, reset by the caller after reporting
+	uint32_t frames = 0;		// Frames fully sent (including retransmits)
+	uint32_t underruns = 0;		// Frames where a strand overran its wire time (stale items were sent)
+	uint32_t retransmits = 0;	// Frames resent because of an underrun
+	uint32_t maxTxMicros = 0;	// Longest start-to-completion time
+	uint32_t maxEncodeCycles = 0;  // Longest show() encode of all strands, in CPU cycles
+
+  private:
+	struct Strand {
+		rmt_channel_t channel;
+		uint8_t memBlocks;
+		uint8_t pin;
+		CRGB* pixels;
+		uint16_t count;
+		uint32_t wireMicros;   // Expected transmit time
+		uint32_t slackMicros;  // Overrun tolerated before counting an underrun (half the RMT memory)
+		rmt_item32_t* encoded[2];
+		uint8_t* residual;	// Sigma-delta error carried to the next frame, one per channel
+	};
+
+	static const uint8_t maxRetransmits = 1;
+
+	Strand strands[LED_MAX_STRANDS];
+	uint8_t numStrands = 0;
+	uint8_t frontBuffer = 0;  // Buffer currently (or last) on the wire
+	volatile uint8_t pending = 0;
+	volatile bool corrupted = false;  // An underrun was detected on the frame in flight
+	uint8_t retransmitsLeft = 0;
+	TaskHandle_t notifyTask = nullptr;
+	uint32_t txStartMicros = 0;
+	volatile uint16_t brightness = UINT16_MAX;	// Full until the brightness manager starts, like FastLED
+	uint16_t gammaTable[256];  // 8-bit colour to 16-bit linear (8.8 fixed point)
+
+	// A channel's memory runs into the following channels' blocks, so the strand with the
+	// most pixels takes the last channel and every block after the shorter strands' one each
+	void assignMemoryBlocks() {
+		uint8_t longest = 0;
+		for (uint8_t i = 1; i < numStrands; i++) {
+			if (strands[i].count > strands[longest].count) {
+				longest = i;
+			}
+		}
+
+		uint8_t channel = 0;
+		for (uint8_t i = 0; i < numStrands; i++) {
+			if (i != longest) {
+				strands[i].channel = rmt_channel_t(channel++);
+				strands[i].memBlocks = 1;
+			}
+		}
+		strands[longest].channel = rmt_channel_t(channel);
+		strands[longest].memBlocks = LED_RMT_MEM_BLOCKS - channel;
+	}
+
+	// Start every strand from the front buffer
+	void transmit() {
+		notifyTask = xTaskGetCurrentTaskHandle();
+		corrupted = false;
+		pending = numStrands;
+		power.acquireLed();
+		txStartMicros = micros();
+		for (uint8_t i = 0; i < numStrands; i++) {
+			rmt_write_items(strands[i].channel, strands[i].encoded[frontBuffer], strands[i].count * 24, false);
+		}
+	}
+
+	void encode(const Strand& strand, rmt_item32_t* out) {
+		const uint32_t gain = brightness;
+		const rmt_item32_t zero = { { { LED_T1_TICKS, 1, LED_T2_TICKS + LED_T3_TICKS, 0 } } };
+		const rmt_item32_t one = { { { LED_T1_TICKS + LED_T2_TICKS, 1, LED_T3_TICKS, 0 } } };
+		const uint32_t fractionMask = (1 << LED_DITHER_BITS) - 1;
+
+		uint8_t* residual = strand.residual;
+		for (uint16_t p = 0; p < strand.count; p++) {
+			const CRGB& pixel = strand.pixels[p];
+			const uint8_t grb[3] = { pixel.g, pixel.r, pixel.b };
+			for (uint8_t c = 0; c < 3; c++) {
+				// 16-bit linear value, reduced to 8.LED_DITHER_BITS fixed point, plus last frame's error
+				uint32_t level = (gammaTable[grb[c]] * gain) >> (24 - LED_DITHER_BITS);
+				uint32_t accumulated = level + *residual;
+				*residual++ = accumulated & fractionMask;
+
+				uint8_t value = accumulated >> LED_DITHER_BITS;
+				for (uint8_t bit = 0x80; bit; bit >>= 1) {
+					*out++ = (value & bit) ? one : zero;
+				}
+			}
+		}
+	}
+
+	static void IRAM_ATTR onTxEnd(rmt_channel_t channel, void* arg) {
+		LedOutput* output = static_cast<LedOutput*>(arg);
+		uint32_t txMicros = micros() - output->txStartMicros;
+
+		for (uint8_t i = 0; i < output->numStrands; i++) {
+			const Strand& strand = output->strands[i];
+			if (strand.channel == channel && txMicros > strand.wireMicros + strand.slackMicros) {
+				output->corrupted = true;
+			}
+		}
+
+		if (output->pending == 0 || --output->pending > 0) {
+			return;
+		}
+
+		output->frames++;
+		if (output->corrupted) {
+			output->underruns++;
+		}
+		if (txMicros > output->maxTxMicros) {
+			output->maxTxMicros = txMicros;
+		}
+		power.releaseLed();
+
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+		vTaskNotifyGiveFromISR(output->notifyTask, &xHigherPriorityTaskWoken);
+		if (xHigherPriorityTaskWoken) {
+			portYIELD_FROM_ISR();
+		}
+	}
+};
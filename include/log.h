@@ -0,0 +1,224 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <cinttypes>
+
+/**
+ * Logging facade with compile-time level filtering
+ *
+ * LOG_E/W/I/D(format, ...) print one line with a level prefix. Every level above LOG_LEVEL
+ * expands to nothing, so its format string and arguments cost no flash and no cycles.
+ *
+ * Hot-path messages are logged as records (the structs below) with LOG_RECORD_E/W/I/D.
+ * With LOG_BINARY defined a record is written as a small binary frame instead of text,
+ * decode it on the host with "Host Tools/log-decoder.py":
+ *
+ *   0x1E 0xA5 | id (1) | length (1) | packed record (length) | xor of id, length and record (1)
+ */
+
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+
+#if !defined(LOG_LEVEL)
+	#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+#define LOG_PRINT(prefix, format, ...) Serial.printf(prefix format "\n", ##__VA_ARGS__)
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+	#define LOG_E(format, ...) LOG_PRINT("[E] ", format, ##__VA_ARGS__)
+	#define LOG_RECORD_E(...) logRecord(__VA_ARGS__)
+#else
+	#define LOG_E(format, ...) \
+		do {                   \
+		} while (0)
+	#define LOG_RECORD_E(...) \
+		do {              \
+		} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+	#define LOG_W(format, ...) LOG_PRINT("[W] ", format, ##__VA_ARGS__)
+	#define LOG_RECORD_W(...) logRecord(__VA_ARGS__)
+#else
+	#define LOG_W(format, ...) \
+		do {                   \
+		} while (0)
+	#define LOG_RECORD_W(...) \
+		do {              \
+		} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+	#define LOG_I(format, ...) LOG_PRINT("[I] ", format, ##__VA_ARGS__)
+	#define LOG_RECORD_I(...) logRecord(__VA_ARGS__)
+#else
+	#define LOG_I(format, ...) \
+		do {                   \
+		} while (0)
+	#define LOG_RECORD_I(...) \
+		do {              \
+		} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+	#define LOG_D(format, ...) LOG_PRINT("[D] ", format, ##__VA_ARGS__)
+	#define LOG_RECORD_D(...) logRecord(__VA_ARGS__)
+#else
+	#define LOG_D(format, ...) \
+		do {                   \
+		} while (0)
+	#define LOG_RECORD_D(...) \
+		do {              \
+		} while (0)
+#endif
+
+// --- Records (ids and layouts must match Host Tools/log-decoder.py) ---
+
+/// Summary printed after every feed fetch
+struct __attribute__((packed)) FetchRecord {
+	static const uint8_t id = 1;
+	uint32_t epoch;			  // Time of the fetch
+	int16_t fetchDelay;		  // Seconds between the feed timestamp and the fetch
+	int8_t mcuTemperature;	  // °C
+	int8_t rssi;			  // dBm
+	uint16_t ledFrames;		  // LED frames sent since the last fetch
+	uint16_t ledUnderruns;	  // Frames corrupted by a late RMT refill
+	uint16_t ledRetransmits;  // Frames resent after an underrun
+	uint16_t ledMaxTxMicros;  // Longest frame transmit
+	uint32_t ledMaxEncodeCycles;  // Longest frame encode (gamma, gain and dither of every pixel)
+	uint32_t loopMaxMicros;		  // Longest loop pass (fetch, parse and draw included)
+	uint16_t blocksTouched;		  // Blocks the new schedule changed on the map (0 if unchanged)
+	uint32_t photonMaxMicros;	  // Longest delay from a frame's due time to its transmit starting
+	uint32_t photonMeanMicros;	  // Mean of that delay
+
+	void print() const {
+		time_t time = epoch;
+		struct tm timeinfo;
+		char clock[16];
+		localtime_r(&time, &timeinfo);
+		strftime(clock, sizeof(clock), "%H:%M:%S", &timeinfo);
+		LOG_PRINT("[I] ",
+				  "%s fetchDelay:%is MCU:%i°C WiFi:%idBm LED:%u frames, %u underruns, %u resent, max %uus, encode %" PRIu32
+				  " cycles, loop max %" PRIu32 "us, %u blocks touched, photon max %" PRIu32 "us mean %" PRIu32 "us",
+				  clock,
+				  fetchDelay,
+				  mcuTemperature,
+				  rssi,
+				  ledFrames,
+				  ledUnderruns,
+				  ledRetransmits,
+				  ledMaxTxMicros,
+				  ledMaxEncodeCycles,
+				  loopMaxMicros,
+				  blocksTouched,
+				  photonMaxMicros,
+				  photonMeanMicros);
+	}
+};
+
+/// HTTP timing of a feed fetch
+struct __attribute__((packed)) HttpRecord {
+	static const uint8_t id = 2;
+	int16_t status;	 // HTTP status or FEED_ERROR_*
+	uint8_t reused;	 // Kept-alive connection was used
+	uint32_t bodyBytes;
+	uint32_t connectMicros;
+	uint32_t firstByteMicros;
+	uint32_t totalMicros;
+	int32_t heapUsed;
+
+	void print() const {
+		LOG_PRINT("[I] ",
+				  "Fetch %d: %" PRIu32 " bytes, connect %" PRIu32 "us%s, first byte %" PRIu32 "us, total %" PRIu32
+				  "us, heap used %" PRId32 " bytes",
+				  status,
+				  bodyBytes,
+				  connectMicros,
+				  reused ? " (reused)" : "",
+				  firstByteMicros,
+				  totalMicros,
+				  heapUsed);
+	}
+};
+
+/// A feed update referenced a block that is not on either strand
+struct __attribute__((packed)) BlockRangeRecord {
+	static const uint8_t id = 3;
+	uint16_t block;
+
+	void print() const {
+		LOG_PRINT("[W] ", "Block %u is out of range for both strands.", block);
+	}
+};
+
+/// Brightness changed by the user (buttons) or by the light sensor buckets
+struct __attribute__((packed)) BrightnessRecord {
+	static const uint8_t id = 4;
+	uint16_t gain;	 // Value handed to LedOutput::setBrightness() (after gamma, 0-65535)
+	uint8_t powerOn;
+	uint16_t lux;		 // Smoothed ambient light (0 without a light sensor)
+
+	void print() const {
+		LOG_PRINT("[I] ", "Brightness set to %u/65535%s, %u lux", gain, powerOn ? "" : " (off)", lux);
+	}
+};
+
+/// A button press reached its callback
+struct __attribute__((packed)) ButtonRecord {
+	static const uint8_t id = 5;
+	uint8_t pin;
+	uint32_t latencyMicros;	 // Release edge in the ISR to callback done
+	uint32_t maxIsrCycles;	 // Longest button ISR since boot
+	uint32_t overflows;		 // Edges dropped because the ring was full
+
+	void print() const {
+		LOG_PRINT("[I] ",
+				  "Button %u: %" PRIu32 " us, ISR max %" PRIu32 " cycles, %" PRIu32 " edges dropped",
+				  pin,
+				  latencyMicros,
+				  maxIsrCycles,
+				  overflows);
+	}
+};
+
+/// Wake latency of a task placed like the LED output over the last minute (see SchedulingProbe)
+struct __attribute__((packed)) SchedulingRecord {
+	static const uint8_t id = 6;
+	uint8_t core;		 // Core the probe ran on
+	uint8_t dualCore;	 // Tasks pinned to the network and output cores, 0 = single-core layout
+	uint16_t wakes;
+	uint32_t maxMicros;	 // Timer firing to the probe running
+	uint32_t meanMicros;
+
+	void print() const {
+		LOG_PRINT("[I] ",
+				  "Scheduling core %u (%s layout): %u wakes, max %" PRIu32 " us, mean %" PRIu32 " us",
+				  core,
+				  dualCore ? "dual-core" : "single-core",
+				  wakes,
+				  maxMicros,
+				  meanMicros);
+	}
+};
+
+template <typename Record>
+void logRecord(const Record& record) {
+#if defined(LOG_BINARY)
+	uint8_t frame[sizeof(Record) + 5] = { 0x1E, 0xA5, Record::id, sizeof(Record) };
+	memcpy(frame + 4, &record, sizeof(Record));
+
+	uint8_t checksum = 0;
+	for (size_t i = 2; i < sizeof(Record) + 4; i++) {
+		checksum ^= frame[i];
+	}
+	frame[sizeof(Record) + 4] = checksum;
+	Serial.write(frame, sizeof(frame));
+#else
+	record.print();
+#endif
+}
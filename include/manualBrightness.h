@@ -2,28 +2,34 @@
 #include <FastLED.h>
 #include <Preferences.h>
 
-// Preferences is in main.cpp
+#include "ledOutput.h"
+#include "log.h"
+#include "recordStore.h"
+#include "settings.h"
+
+// Preferences, RecordStore, SettingsCache and LedOutput are in main.cpp
 extern Preferences preferences;
+extern RecordStore recordStore;
+extern SettingsCache settings;
+extern LedOutput ledOutput;
 
 class BrightnessManager {
   public:
 	BrightnessManager() {}
 
 	void begin() {
-		load(preferences);
+		load();
 		setBrightness();
 	}
 
 	// Increase adjustment for current ambient bucket
 	void increase() {
-		brightness += BRIGHTNESS_STEP;
-		brightness = constrain(brightness, MIN_BRIGHTNESS, MAX_BRIGHTNESS);
+		brightness += settings.get().brightnessStep;
 		setBrightness();
 	}
 
 	void decrease() {
-		brightness -= BRIGHTNESS_STEP;
-		brightness = constrain(brightness, MIN_BRIGHTNESS, MAX_BRIGHTNESS);
+		brightness -= settings.get().brightnessStep;
 		setBrightness();
 	}
 
@@ -32,16 +38,23 @@ class BrightnessManager {
 		setBrightness();
 	}
 
-	void save(Preferences &preferences) {
-		preferences.begin("brightness");
-		preferences.putInt("brightness", int(brightness));
-		preferences.end();
+	// A single append, and nothing at all when the level has not changed
+	void save() {
+		int32_t value = int32_t(brightness);
+		recordStore.put(RECORD_BRIGHTNESS, &value, sizeof(value));
 	}
 
-	void load(Preferences &preferences) {
-		preferences.begin("brightness");
+	// From the record store, or once from Preferences (NVS) where older firmware kept it
+	void load() {
+		int32_t value;
+		if (recordStore.get(RECORD_BRIGHTNESS, &value, sizeof(value))) {
+			brightness = float(value);
+			return;
+		}
+		preferences.begin("brightness", true);
 		brightness = float(preferences.getInt("brightness", brightness));
 		preferences.end();
+		save();
 	}
 
 	void update() {
@@ -49,18 +62,24 @@ class BrightnessManager {
 	}
 
 	void setBrightness() {
-		// Apply gamma correction for perceived brightness
+		brightness = constrain(brightness, settings.get().minBrightness, settings.get().maxBrightness);
+
+		// Apply gamma correction for perceived brightness, kept at 16 bits so low levels stay distinct
 		float gamma = 2.2f;
-		uint8_t gammaBrightness = static_cast<uint8_t>(pow((brightness / 255.0f), gamma) * 255.0f);
+		uint16_t gain = static_cast<uint16_t>(pow((brightness / 255.0f), gamma) * 65535.0f);
 
 		// Update the LEDs
-		FastLED.setBrightness(powerOn ? gammaBrightness : 0);
+		ledOutput.setBrightness(powerOn ? gain : 0);
 
-		Serial.printf("Brightness set to %0.0f/255\n", brightness);
+		LOG_RECORD_I(BrightnessRecord{ gain, powerOn, 0 });
 
-		save(preferences);
+		save();
 	}
 
+	/// No light sensor on this board
+	float getLux() const {
+		return 0.0f;
+	}
 
   private:
 	float brightness = MIN_BRIGHTNESS + BRIGHTNESS_STEP;  // Current brightness level (0-255)
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <esp_partition.h>
+#include <esp_rom_crc.h>
+
+#include "log.h"
+
+#define METRICS_PARTITION "spiffs"	// Unused by the firmware, see boards/default_4MB.csv
+#define METRICS_SECTORS 64			// 256 KiB ring, about three weeks at the usual 8-9 bytes a minute
+#define METRICS_SECTOR_SIZE 4096
+#define METRICS_PAGE_SIZE 256  // Flash program unit, samples are written a page at a time
+#define METRICS_PAGES (METRICS_SECTORS * METRICS_SECTOR_SIZE / METRICS_PAGE_SIZE)
+#define METRICS_FIELDS 7
+#define METRICS_VERSION 1
+
+/**
+ * @brief One minute of device health, the fields in the order they are encoded
+ */
+struct MetricsSample {
+	int32_t fetchMsMax;	  // Slowest feed request in the minute, 0 if none
+	int32_t fetches;	  // Feed requests made
+	int32_t failures;	  // Requests that did not return 200 or 304
+	int32_t rssi;		  // Wi-Fi signal at the end of the minute, dBm (0 if disconnected)
+	int32_t heapMin;	  // Lowest free heap seen, bytes
+	int32_t lux;		  // Ambient light (0 without a light sensor)
+	int32_t brightness;	  // LED gain handed to LedOutput (0-65535)
+};
+
+/**
+ * @brief Keeps a minute by minute history of device health in flash
+ *
+ * Samples are packed into 256 byte pages in RAM. The first sample of a page is stored as is
+ * and every later one as the change from the previous minute, each field a zigzag varint, so
+ * a quiet minute costs about a byte per field. A full page is written with one flash program
+ * (about every half hour) into a ring of METRICS_SECTORS sectors at the start of the spiffs
+ * partition; entering a sector erases it, dropping the oldest four KiB of history.
+ *
+ * Page layout: MetricsPageHeader then the varints. Consecutive samples are a minute apart,
+ * a gap (reboot, lost time) starts a new page. Pages are found again at boot by their epoch,
+ * a page cut short by a reset fails its CRC. The whole ring plus the page being filled is
+ * served at /metrics.bin; decode it with "Host Tools/metrics-decoder.py".
+ */
+class MetricsHistory {
+  public:
+	void begin() {
+		lock = xSemaphoreCreateMutex();
+		partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, METRICS_PARTITION);
+		if (partition == nullptr || partition->size < METRICS_SECTORS * METRICS_SECTOR_SIZE) {
+			LOG_E("No \"%s\" partition, metrics history disabled", METRICS_PARTITION);
+			partition = nullptr;
+			return;
+		}
+
+		// Continue after the newest intact page
+		uint32_t newest = 0;
+		for (uint16_t index = 0; index < METRICS_PAGES; index++) {
+			esp_partition_read(partition, index * METRICS_PAGE_SIZE, page, METRICS_PAGE_SIZE);
+			if (header.version == METRICS_VERSION && header.epoch > newest && header.length >= sizeof(MetricsPageHeader)
+				&& header.length <= METRICS_PAGE_SIZE && header.crc == pageCrc()) {
+				newest = header.epoch;
+				nextPage = (index + 1) % METRICS_PAGES;
+			}
+		}
+		// Skip pages a reset left half written, they cannot be programmed again until their sector is erased
+		while (nextPage * METRICS_PAGE_SIZE % METRICS_SECTOR_SIZE != 0 && !pageErased(nextPage)) {
+			nextPage = (nextPage + 1) % METRICS_PAGES;
+		}
+		startPage();
+		resetMinute();
+		LOG_I("Metrics history: %u KiB ring, writing page %u", METRICS_SECTORS * METRICS_SECTOR_SIZE / 1024, nextPage);
+	}
+
+	/**
+	 * @brief Count one feed request
+	 *
+	 * @param status HTTP status or FEED_ERROR_* code
+	 * @param totalMicros Request time
+	 */
+	void recordFetch(int status, uint32_t totalMicros) {
+		current.fetches++;
+		if (status != 200 && status != 304) {
+			current.failures++;
+		}
+		current.fetchMsMax = max(current.fetchMsMax, int32_t(totalMicros / 1000));
+	}
+
+	/**
+	 * @brief Sample the slow moving values and close the minute when it is over
+	 *
+	 * @param epoch Current time, nothing is recorded until it is set
+	 * @param lux Ambient light (0 without a light sensor)
+	 * @param brightness Current LED gain
+	 */
+	void update(time_t epoch, float lux, uint16_t brightness) {
+		if (partition == nullptr || epoch < 1700000000) {
+			return;
+		}
+		current.heapMin = min(current.heapMin, int32_t(ESP.getFreeHeap()));
+
+		uint32_t minute = epoch - epoch % 60;
+		if (minute == currentMinute) {
+			return;
+		}
+		if (currentMinute != 0) {
+			current.rssi = (WiFi.status() == WL_CONNECTED) ? WiFi.RSSI() : 0;
+			current.lux = int32_t(lux);
+			current.brightness = brightness;
+			append(currentMinute, current);
+		}
+		currentMinute = minute;
+		resetMinute();
+	}
+
+	/// Bytes served by read(), the whole ring and the page being filled
+	size_t size() const {
+		return partition ? METRICS_PAGES * METRICS_PAGE_SIZE + METRICS_PAGE_SIZE : 0;
+	}
+
+	/**
+	 * @brief Copy part of the download, oldest pages first (for a chunked web response)
+	 *
+	 * @param index Offset into the download
+	 * @param buffer Destination
+	 * @param maxLength Space in buffer
+	 * @return size_t Bytes copied, 0 at the end
+	 */
+	size_t read(size_t index, uint8_t* buffer, size_t maxLength) {
+		const size_t ringBytes = METRICS_PAGES * METRICS_PAGE_SIZE;
+		if (partition == nullptr || index >= size()) {
+			return 0;
+		}
+		xSemaphoreTake(lock, portMAX_DELAY);
+		size_t length;
+		if (index < ringBytes) {
+			// Start at the page about to be overwritten, the oldest
+			size_t offset = (nextPage * METRICS_PAGE_SIZE + index) % ringBytes;
+			length = min(maxLength, min(ringBytes - index, ringBytes - offset));
+			esp_partition_read(partition, offset, buffer, length);
+		} else {
+			size_t offset = index - ringBytes;
+			if (offset == 0) {
+				header.crc = pageCrc();
+			}
+			length = min(maxLength, size_t(METRICS_PAGE_SIZE) - offset);
+			memcpy(buffer, page + offset, length);
+		}
+		xSemaphoreGive(lock);
+		return length;
+	}
+
+  private:
+	struct __attribute__((packed)) MetricsPageHeader {
+		uint8_t version;  // METRICS_VERSION, 0xFF = erased
+		uint8_t count;	  // Samples in the page
+		uint16_t length;  // Bytes used including this header
+		uint32_t epoch;	  // Minute of the first sample
+		uint32_t crc;	  // Of the varints
+	};
+
+	const esp_partition_t* partition = nullptr;
+	SemaphoreHandle_t lock = nullptr;
+	uint16_t nextPage = 0;	// Ring page the next full page goes to
+	alignas(4) uint8_t page[METRICS_PAGE_SIZE];
+	MetricsPageHeader& header = *reinterpret_cast<MetricsPageHeader*>(page);
+	MetricsSample previous;
+	MetricsSample current;
+	uint32_t currentMinute = 0;
+
+	bool pageErased(uint16_t index) {
+		uint32_t word;
+		esp_partition_read(partition, index * METRICS_PAGE_SIZE, &word, sizeof(word));
+		return word == 0xFFFFFFFF;
+	}
+
+	uint32_t pageCrc() const {
+		return esp_rom_crc32_le(0, page + sizeof(MetricsPageHeader), header.length - sizeof(MetricsPageHeader));
+	}
+
+	void startPage() {
+		memset(page, 0xFF, sizeof(page));
+		header.version = METRICS_VERSION;
+		header.count = 0;
+		header.length = sizeof(MetricsPageHeader);
+	}
+
+	void resetMinute() {
+		current = {};
+		current.heapMin = INT32_MAX;
+	}
+
+	static size_t putVarint(uint8_t* out, int32_t value) {
+		uint32_t zigzag = (uint32_t(value) << 1) ^ uint32_t(value >> 31);
+		size_t length = 0;
+		while (zigzag >= 0x80) {
+			out[length++] = uint8_t(zigzag) | 0x80;
+			zigzag >>= 7;
+		}
+		out[length++] = uint8_t(zigzag);
+		return length;
+	}
+
+	void append(uint32_t minute, const MetricsSample& sample) {
+		xSemaphoreTake(lock, portMAX_DELAY);
+		bool contiguous = header.count > 0 && minute == header.epoch + header.count * 60u;
+		if (!contiguous || header.count == UINT8_MAX) {
+			flush();
+		}
+
+		uint8_t encoded[METRICS_FIELDS * 5];
+		size_t length = encode(encoded, sample, header.count > 0);
+		if (header.length + length > METRICS_PAGE_SIZE) {
+			flush();
+			length = encode(encoded, sample, false);
+		}
+		if (header.count == 0) {
+			header.epoch = minute;
+		}
+		memcpy(page + header.length, encoded, length);
+		header.length += length;
+		header.count++;
+		previous = sample;
+		xSemaphoreGive(lock);
+	}
+
+	size_t encode(uint8_t* out, const MetricsSample& sample, bool delta) const {
+		const int32_t* fields = &sample.fetchMsMax;
+		const int32_t* base = &previous.fetchMsMax;
+		size_t length = 0;
+		for (uint8_t i = 0; i < METRICS_FIELDS; i++) {
+			length += putVarint(out + length, delta ? fields[i] - base[i] : fields[i]);
+		}
+		return length;
+	}
+
+	// Writes the page being filled to the ring (if it has samples) and starts an empty one
+	void flush() {
+		if (header.count > 0) {
+			header.crc = pageCrc();
+			uint32_t offset = nextPage * METRICS_PAGE_SIZE;
+			if (offset % METRICS_SECTOR_SIZE == 0) {
+				esp_partition_erase_range(partition, offset, METRICS_SECTOR_SIZE);
+			}
+			esp_partition_write(partition, offset, page, METRICS_PAGE_SIZE);
+			LOG_D("Metrics page %u: %u minutes in %u bytes", nextPage, header.count, header.length);
+			nextPage = (nextPage + 1) % METRICS_PAGES;
+		}
+		startPage();
+	}
+};
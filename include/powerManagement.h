@@ -0,0 +1,97 @@
+#pragma once
+
+#include <Arduino.h>
+#include <esp_pm.h>
+
+#include "log.h"
+
+#if CONFIG_IDF_TARGET_ESP32C3
+	#include "esp32c3/pm.h"
+typedef esp_pm_config_esp32c3_t pmConfig_t;
+#elif CONFIG_IDF_TARGET_ESP32S3
+	#include "esp32s3/pm.h"
+typedef esp_pm_config_esp32s3_t pmConfig_t;
+#endif
+
+#if !defined(PM_MIN_CPU_MHZ)
+	#define PM_MIN_CPU_MHZ 40  // XTAL frequency, lowest the clock tree can run at without the PLL
+#endif
+
+/**
+ * @brief Dynamic frequency scaling with locks around timing-critical work
+ *
+ * When DYNAMIC_FREQUENCY_SCALING is defined the CPU idles at PM_MIN_CPU_MHZ and is
+ * raised to the board's f_cpu while any lock is held. Below 80 MHz the APB clock
+ * (which drives the RMT peripheral) follows the CPU clock, so the LED transmit must
+ * always run under a lock or the WS2811 bit timing stretches.
+ *
+ * Without the flag (or if the SDK was built without CONFIG_PM_ENABLE) every call is a
+ * no-op and the clock stays fixed, so the LED statistics can be compared between both.
+ */
+class PowerManager {
+  public:
+	/**
+	 * @brief Configure DFS and create the locks
+	 *
+	 * Must be called before the LED output task starts.
+	 */
+	void begin() {
+#if defined(DYNAMIC_FREQUENCY_SCALING)
+		pmConfig_t config = {
+			.max_freq_mhz = int(F_CPU / 1000000),
+			.min_freq_mhz = PM_MIN_CPU_MHZ,
+			.light_sleep_enable = false,
+		};
+
+		esp_err_t err = esp_pm_configure(&config);
+		if (err != ESP_OK) {
+			LOG_W("DFS unavailable (%s), running at a fixed %dMHz", esp_err_to_name(err), getCpuFrequencyMhz());
+			return;
+		}
+
+		if (esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "ledTx", &ledLock) != ESP_OK
+			|| esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "busy", &busyLock) != ESP_OK) {
+			LOG_E("Failed to create PM locks!");
+			return;
+		}
+
+		enabled = true;
+		LOG_I("DFS enabled: %d-%dMHz", config.min_freq_mhz, config.max_freq_mhz);
+#endif
+	}
+
+	/// Hold full clock speed (and an 80 MHz APB) for the duration of an LED transmit, safe to call from an ISR
+	void IRAM_ATTR acquireLed() {
+		if (enabled) {
+			esp_pm_lock_acquire(ledLock);
+		}
+	}
+
+	void IRAM_ATTR releaseLed() {
+		if (enabled) {
+			esp_pm_lock_release(ledLock);
+		}
+	}
+
+	/// Hold full clock speed while parsing feed data or rendering a frame
+	void acquireBusy() {
+		if (enabled) {
+			esp_pm_lock_acquire(busyLock);
+		}
+	}
+
+	void releaseBusy() {
+		if (enabled) {
+			esp_pm_lock_release(busyLock);
+		}
+	}
+
+	bool isEnabled() const {
+		return enabled;
+	}
+
+  private:
+	bool enabled = false;
+	esp_pm_lock_handle_t ledLock = nullptr;
+	esp_pm_lock_handle_t busyLock = nullptr;
+};
@@ -0,0 +1,436 @@
+#pragma once
+
+#include <Arduino.h>
+#include <esp_partition.h>
+#include <esp_rom_crc.h>
+
+#include "log.h"
+
+#define STORE_PARTITION "records"  // See boards/default_4MB.csv
+#define STORE_SECTOR_SIZE 4096	   // Flash erase unit
+#define STORE_MAX_SECTORS 16
+#define STORE_FREE_SECTORS 2		// Erased sectors update() keeps ready, one is always left for compaction
+#define STORE_MAGIC 0x3153524C		// "LRS1"
+#define STORE_COPY_CHUNK 256		// Bytes moved at a time when compacting
+
+/// Values kept in the record store, never reuse a retired key
+enum RecordKey : uint16_t {
+	RECORD_WIFI = 1,			  // savedWiFiNetwork[MAX_WIFI_NETWORKS]
+	RECORD_BRIGHTNESS_BUCKETS = 2,	// BrightnessBucket[3] (light sensor boards)
+	RECORD_BRIGHTNESS = 3,		  // int32_t (boards without a light sensor)
+	RECORD_FACTORY_PASSED = 4,	  // uint8_t
+	RECORD_BENCHMARK = 5,		  // Scratch for benchmarkRecordStore()
+	RECORD_KEYS
+};
+
+/**
+ * @brief Append-only key/value store for the settings that change at runtime
+ *
+ * Preferences (NVS) rewrites and commits its entry tables on every put, which takes
+ * milliseconds and wears the NVS pages for a one byte change. This store instead appends
+ * each new value as a record (key, length, CRC, data) to a log of 4 KiB sectors in its own
+ * partition, and keeps the location of the latest value of each key in RAM. A put is one
+ * flash program of the record, a get is one index lookup and a read, and a put of the value
+ * already stored writes nothing.
+ *
+ * Sectors are written in turn and carry a sequence number, so wear is spread over the whole
+ * partition. update() (from the main loop) compacts in the background: when fewer than
+ * STORE_FREE_SECTORS are erased it copies the still-current records out of the oldest sector
+ * and erases it. A put that finds no room, with the current values filling all but the
+ * sector kept for compaction, fails without writing. A record cut short by a reset fails its
+ * CRC and is skipped at boot. The format is tested on the host against a simulated NOR
+ * partition, see test/test_record_store.
+ *
+ * All methods may be called from any task.
+ */
+class RecordStore {
+  public:
+	void begin() {
+		lock = xSemaphoreCreateMutex();
+		partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, STORE_PARTITION);
+		if (partition == nullptr) {
+			LOG_E("No \"%s\" partition, runtime settings will not be saved", STORE_PARTITION);
+			return;
+		}
+		numSectors = min(uint32_t(partition->size / STORE_SECTOR_SIZE), uint32_t(STORE_MAX_SECTORS));
+
+		// Replay the sectors oldest first, later records of a key replace earlier ones
+		for (uint8_t s = 0; s < numSectors; s++) {
+			SectorHeader header;
+			esp_partition_read(partition, s * STORE_SECTOR_SIZE, &header, sizeof(header));
+			if (header.magic == STORE_MAGIC) {
+				sequences[s] = header.sequence;
+			} else if (header.magic != 0xFFFFFFFF || header.sequence != 0xFFFFFFFF) {
+				eraseSector(s);	 // Interrupted erase or foreign data
+			}
+		}
+		for (uint8_t n = 0; n < numSectors; n++) {
+			int8_t s = oldestSector(n == 0 ? 0 : sequences[head]);
+			if (s < 0) {
+				break;
+			}
+			head = s;
+			writeOffset = scanSector(s);
+		}
+
+		if (sequences[head] == 0) {
+			startSector(head);	// Empty store
+		}
+		uint8_t keys = 0;
+		for (uint16_t key = 0; key < RECORD_KEYS; key++) {
+			keys += offsets[key] != 0;
+		}
+		LOG_I("Record store: %u keys, %u of %u sectors free, sequence %" PRIu32 " (~%" PRIu32 " erases per sector)",
+			  keys,
+			  freeSectors(),
+			  numSectors,
+			  sequences[head],
+			  sequences[head] / numSectors);
+	}
+
+	/**
+	 * @brief Read the latest value of a key
+	 *
+	 * @param key Key
+	 * @param data Buffer for the value
+	 * @param length Size of the buffer, the value must be exactly this long
+	 * @return true if the key has a value of that length
+	 */
+	bool get(RecordKey key, void* data, size_t length) {
+		if (partition == nullptr || key >= RECORD_KEYS) {
+			return false;
+		}
+		xSemaphoreTake(lock, portMAX_DELAY);
+		bool found = offsets[key] != 0 && lengths[key] == length
+					 && esp_partition_read(partition, offsets[key] + sizeof(RecordHeader), data, length) == ESP_OK;
+		xSemaphoreGive(lock);
+		return found;
+	}
+
+	/**
+	 * @brief Store a new value for a key, nothing is written if it has not changed
+	 *
+	 * @param key Key
+	 * @param data Value
+	 * @param length Value length, at most a sector less the headers
+	 * @return true if the value is stored, false if it is too long or there is no room left for it
+	 */
+	bool put(RecordKey key, const void* data, size_t length) {
+		if (partition == nullptr || key >= RECORD_KEYS
+			|| length > STORE_SECTOR_SIZE - sizeof(SectorHeader) - sizeof(RecordHeader)) {
+			return false;
+		}
+		RecordHeader header = { uint16_t(key), uint16_t(length), 0 };
+		header.crc = recordCrc(header, data);
+
+		xSemaphoreTake(lock, portMAX_DELAY);
+		if (offsets[key] != 0 && lengths[key] == length) {
+			RecordHeader stored;
+			esp_partition_read(partition, offsets[key], &stored, sizeof(stored));
+			if (stored.crc == header.crc && sameData(offsets[key] + sizeof(RecordHeader), data, length)) {
+				xSemaphoreGive(lock);
+				return true;  // Unchanged
+			}
+		}
+
+		uint32_t start = micros();
+		uint32_t offset = reserve(sizeof(RecordHeader) + length);
+		if (offset == 0) {
+			xSemaphoreGive(lock);
+			LOG_E("Record store full, record %u (%zu bytes) not stored", key, length);
+			return false;
+		}
+		bool ok = esp_partition_write(partition, offset, &header, sizeof(header)) == ESP_OK
+				  && esp_partition_write(partition, offset + sizeof(RecordHeader), data, length) == ESP_OK;
+		if (ok) {
+			offsets[key] = offset;
+			lengths[key] = length;
+		}
+		uint32_t elapsed = micros() - start;
+		maxWriteMicros = max(maxWriteMicros, elapsed);
+		appendedBytes += sizeof(RecordHeader) + length;
+		xSemaphoreGive(lock);
+
+		LOG_D("Stored record %u (%zu bytes) in %" PRIu32 " us", key, length, elapsed);
+		return ok;
+	}
+
+	/// Background compaction, call from the main loop
+	void update() {
+		if (partition == nullptr || freeSectors() >= STORE_FREE_SECTORS) {
+			return;
+		}
+		xSemaphoreTake(lock, portMAX_DELAY);
+		if (freeSectors() < STORE_FREE_SECTORS) {
+			compactOldest();
+		}
+		xSemaphoreGive(lock);
+	}
+
+	// Statistics since boot
+	uint32_t maxWriteMicros = 0;
+	uint32_t appendedBytes = 0;
+	uint32_t erases = 0;
+
+  private:
+	struct SectorHeader {
+		uint32_t magic;
+		uint32_t sequence;	// Order the sectors were started in, 0 = erased
+	};
+
+	struct RecordHeader {
+		uint16_t key;  // 0xFFFF = erased, the end of the sector's records
+		uint16_t length;
+		uint32_t crc;  // Of the key, length and data, a record cut short fails it
+	};
+
+	const esp_partition_t* partition = nullptr;
+	SemaphoreHandle_t lock = nullptr;
+	uint8_t numSectors = 0;
+	uint32_t sequences[STORE_MAX_SECTORS] = {};
+	uint8_t head = 0;		   // Sector being appended to
+	uint32_t writeOffset = 0;  // Next record in the head sector, relative to the sector
+	uint32_t offsets[RECORD_KEYS] = {};	 // Partition offset of each key's latest record, 0 = none
+	uint16_t lengths[RECORD_KEYS] = {};
+
+	static uint32_t align(uint32_t length) {
+		return (length + 3) & ~3u;
+	}
+
+	static uint32_t recordCrc(const RecordHeader& header, const void* data) {
+		uint32_t crc = esp_rom_crc32_le(0, reinterpret_cast<const uint8_t*>(&header), 4);
+		return esp_rom_crc32_le(crc, static_cast<const uint8_t*>(data), header.length);
+	}
+
+	uint8_t freeSectors() const {
+		uint8_t count = 0;
+		for (uint8_t s = 0; s < numSectors; s++) {
+			count += sequences[s] == 0;
+		}
+		return count;
+	}
+
+	// Sector with the lowest sequence above after, -1 if none
+	int8_t oldestSector(uint32_t after) const {
+		int8_t oldest = -1;
+		for (uint8_t s = 0; s < numSectors; s++) {
+			if (sequences[s] > after && (oldest < 0 || sequences[s] < sequences[oldest])) {
+				oldest = s;
+			}
+		}
+		return oldest;
+	}
+
+	// Indexes a sector's valid records, returns where the next record would go
+	uint32_t scanSector(uint8_t s) {
+		uint32_t base = s * STORE_SECTOR_SIZE;
+		uint32_t offset = sizeof(SectorHeader);
+		uint8_t buffer[STORE_COPY_CHUNK];
+
+		while (offset + sizeof(RecordHeader) <= STORE_SECTOR_SIZE) {
+			RecordHeader header;
+			esp_partition_read(partition, base + offset, &header, sizeof(header));
+			if (header.key == 0xFFFF && header.length == 0xFFFF) {
+				return offset;	// End of the records
+			}
+			if (header.length > STORE_SECTOR_SIZE - offset - sizeof(RecordHeader)) {
+				return STORE_SECTOR_SIZE;  // Torn header, nothing more can go in this sector
+			}
+
+			uint32_t crc = esp_rom_crc32_le(0, reinterpret_cast<const uint8_t*>(&header), 4);
+			for (uint32_t done = 0; done < header.length; done += sizeof(buffer)) {
+				uint32_t chunk = min(uint32_t(header.length) - done, uint32_t(sizeof(buffer)));
+				esp_partition_read(partition, base + offset + sizeof(RecordHeader) + done, buffer, chunk);
+				crc = esp_rom_crc32_le(crc, buffer, chunk);
+			}
+			if (crc == header.crc && header.key < RECORD_KEYS) {
+				offsets[header.key] = base + offset;
+				lengths[header.key] = header.length;
+			}
+			offset += align(sizeof(RecordHeader) + header.length);
+		}
+		return STORE_SECTOR_SIZE;
+	}
+
+	bool sameData(uint32_t offset, const void* data, size_t length) {
+		uint8_t buffer[STORE_COPY_CHUNK];
+		for (size_t done = 0; done < length; done += sizeof(buffer)) {
+			size_t chunk = min(length - done, sizeof(buffer));
+			esp_partition_read(partition, offset + done, buffer, chunk);
+			if (memcmp(buffer, static_cast<const uint8_t*>(data) + done, chunk) != 0) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void eraseSector(uint8_t s) {
+		esp_partition_erase_range(partition, s * STORE_SECTOR_SIZE, STORE_SECTOR_SIZE);
+		sequences[s] = 0;
+		erases++;
+	}
+
+	void startSector(uint8_t s) {
+		uint32_t sequence = 0;
+		for (uint8_t i = 0; i < numSectors; i++) {
+			sequence = max(sequence, sequences[i]);
+		}
+		SectorHeader header = { STORE_MAGIC, sequence + 1 };
+		esp_partition_write(partition, s * STORE_SECTOR_SIZE, &header, sizeof(header));
+		sequences[s] = header.sequence;
+		head = s;
+		writeOffset = sizeof(SectorHeader);
+	}
+
+	// Partition offset for a record of length bytes, moving to a new sector if needed, 0 if there is no room.
+	// A put leaves the last erased sector to compaction, compaction itself may take it
+	uint32_t reserve(uint32_t length, bool compacting = false) {
+		if (!compacting) {
+			// Not kept up by update(), compact now. Its copies may start a new sector with room for the record
+			for (uint8_t i = 0; i < numSectors && !fits(length) && freeSectors() < STORE_FREE_SECTORS; i++) {
+				if (!compactOldest()) {
+					break;
+				}
+			}
+		}
+		if (!fits(length)) {
+			int8_t s = erasedSector();
+			if (s < 0 || (!compacting && freeSectors() < 2)) {
+				return 0;
+			}
+			startSector(s);
+		}
+		uint32_t offset = head * STORE_SECTOR_SIZE + writeOffset;
+		writeOffset += align(length);
+		return offset;
+	}
+
+	bool fits(uint32_t length) const {
+		return writeOffset + length <= STORE_SECTOR_SIZE;
+	}
+
+	// Next erased sector after the head, -1 if none
+	int8_t erasedSector() const {
+		for (uint8_t i = 1; i <= numSectors; i++) {
+			uint8_t s = (head + i) % numSectors;
+			if (sequences[s] == 0) {
+				return s;
+			}
+		}
+		return -1;
+	}
+
+	// Space the current records in a sector take, 0 if it holds none
+	uint32_t currentBytes(uint8_t s) const {
+		uint32_t bytes = 0;
+		for (uint16_t key = 0; key < RECORD_KEYS; key++) {
+			if (offsets[key] != 0 && offsets[key] / STORE_SECTOR_SIZE == s) {
+				bytes += align(sizeof(RecordHeader) + lengths[key]);
+			}
+		}
+		return bytes;
+	}
+
+	// Erases the sectors holding no current record, true if there were any
+	bool eraseStale() {
+		bool erased = false;
+		for (uint8_t s = 0; s < numSectors; s++) {
+			if (s != head && sequences[s] != 0 && currentBytes(s) == 0) {
+				eraseSector(s);
+				erased = true;
+			}
+		}
+		return erased;
+	}
+
+	// Moves the current records out of the oldest sector and erases it, false if no sector was erased
+	bool compactOldest() {
+		int8_t oldest = oldestSector(0);
+		if (oldest < 0 || oldest == head) {
+			return false;
+		}
+		if (freeSectors() == 0 && !fits(currentBytes(oldest))) {
+			// A compaction cut short by a reset used the last erased sector, make room without copying
+			return eraseStale();
+		}
+		uint32_t base = oldest * STORE_SECTOR_SIZE;
+		uint32_t start = micros();
+
+		for (uint16_t key = 0; key < RECORD_KEYS; key++) {
+			if (offsets[key] == 0 || offsets[key] < base || offsets[key] >= base + STORE_SECTOR_SIZE) {
+				continue;
+			}
+			uint32_t length = sizeof(RecordHeader) + lengths[key];
+			uint32_t from = offsets[key];
+			uint32_t to = reserve(length, true);  // Into the sector kept free for this
+			if (to == 0) {
+				LOG_E("Record store full, sector %d not compacted", oldest);
+				return false;  // The records copied so far are current where they are, the rest stay put
+			}
+			uint8_t buffer[STORE_COPY_CHUNK];
+			for (uint32_t done = 0; done < length; done += sizeof(buffer)) {
+				uint32_t chunk = min(length - done, uint32_t(sizeof(buffer)));
+				esp_partition_read(partition, from + done, buffer, chunk);
+				esp_partition_write(partition, to + done, buffer, chunk);
+			}
+			offsets[key] = to;
+			appendedBytes += length;
+		}
+
+		eraseSector(oldest);
+		LOG_D("Record store compacted sector %d in %" PRIu32 " us", oldest, micros() - start);
+		return true;
+	}
+};
+
+#if defined(RECORD_STORE_BENCHMARK)
+	#include <Preferences.h>
+	#include <nvs.h>
+
+/**
+ * @brief Log the write latency and flash used by the record store and by Preferences (NVS)
+ *
+ * Writes the same sequence of changing 24 byte values (the size of the brightness buckets)
+ * to both. Flash used is the bytes appended to the store against the free 32 byte NVS
+ * entries consumed, both only get an erase back once a whole 4 KiB sector or page is used.
+ */
+inline void benchmarkRecordStore(RecordStore& store, Preferences& preferences) {
+	const uint8_t writes = 32;
+	uint8_t value[24] = {};
+	nvs_stats_t before, after;
+	nvs_get_stats(nullptr, &before);
+
+	uint32_t storeMicros = 0, storeMax = 0, nvsMicros = 0, nvsMax = 0;
+	uint32_t storeBytes = store.appendedBytes;
+	preferences.begin("benchmark", false);
+	for (uint8_t i = 0; i < writes; i++) {
+		value[i % sizeof(value)]++;
+
+		uint32_t start = micros();
+		store.put(RECORD_BENCHMARK, value, sizeof(value));
+		uint32_t elapsed = micros() - start;
+		storeMicros += elapsed;
+		storeMax = max(storeMax, elapsed);
+
+		start = micros();
+		preferences.putBytes("value", value, sizeof(value));
+		elapsed = micros() - start;
+		nvsMicros += elapsed;
+		nvsMax = max(nvsMax, elapsed);
+	}
+	nvs_get_stats(nullptr, &after);
+	preferences.clear();
+	preferences.end();
+
+	LOG_I("Record store: %u us average, %u us max, %u bytes of flash for %u writes",
+		  storeMicros / writes,
+		  storeMax,
+		  store.appendedBytes - storeBytes,
+		  writes);
+	LOG_I("Preferences:  %u us average, %u us max, %u bytes of flash for %u writes",
+		  nvsMicros / writes,
+		  nvsMax,
+		  (before.free_entries - after.free_entries) * 32,	// Overwritten entries stay used until their page is erased
+		  writes);
+}
+#endif
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+#if !defined(FEED_CLIENT_BLOCKING)
+	#include "asyncFeedClient.h"
+#endif
+#include "feedClient.h"
+#include "log.h"
+#include "settings.h"
+
+// SettingsCache is in main.cpp
+extern SettingsCache settings;
+
+#define CONFIG_INTERVAL_MS (15 * 60 * 1000UL)
+#define CONFIG_MAX_BYTES 2048
+
+/**
+ * @brief Keeps the settings in step with a per-board config document
+ *
+ * The document at CONFIG_URL (only built when it is set, see platformio.ini) is fetched
+ * with a conditional GET every 15 minutes on the feed's client, between feed fetches so
+ * the connection is reused when it is on the feed's host, and costs a 304 when nothing
+ * changed. Every field is optional and checked; a document with any invalid field is
+ * ignored as a whole. Valid settings are staged, SettingsCache applies them at the next
+ * safe point and rolls them back if feed fetches start failing.
+ *
+ *   {"revision": 4, "updateInterval": 30, "mirrors": ["http://..."],
+ *    "brightness": {"min": 34, "max": 254, "step": 20}}
+ */
+class RemoteConfig {
+  public:
+#if defined(FEED_CLIENT_BLOCKING)
+	/**
+	 * @brief Check for a new config document if it is time to, waits for the response
+	 *
+	 * @param client Client to fetch with, pass the feed's so its connection is reused
+	 */
+	void update(FeedClient& client) {
+		if (!due()) {
+			return;
+		}
+		lastCheck = millis();
+		json = String();
+		finish(client.get(CONFIG_URL, validators, [this](const uint8_t* data, size_t length) { return collect(data, length); }));
+	}
+#else
+	/**
+	 * @brief Start a check when it is time to and the client is idle, or collect the one in flight, never waits
+	 *
+	 * @param client Client to fetch with, pass the feed's so its connection is reused (and start no feed
+	 * fetch on it while it is busy())
+	 */
+	void update(AsyncFeedClient& client) {
+		if (checking) {
+			int httpCode = client.poll();
+			if (httpCode != FEED_PENDING) {
+				checking = false;
+				finish(httpCode);
+			}
+			return;
+		}
+		if (!due() || client.busy()) {
+			return;
+		}
+		lastCheck = millis();
+		json = String();
+		checking = true;
+		client.get(CONFIG_URL, validators, [this](const uint8_t* data, size_t length) { return collect(data, length); });
+	}
+#endif
+
+  private:
+	FeedValidators validators;
+	uint32_t lastCheck = 0;
+	String json;	// Body of the check in flight, written by the client's sink
+	bool checking = false;	// The check is in flight on the AsyncFeedClient
+
+	bool due() const {
+		return lastCheck == 0 || millis() - lastCheck >= CONFIG_INTERVAL_MS;
+	}
+
+	bool collect(const uint8_t* data, size_t length) {
+		return json.length() + length <= CONFIG_MAX_BYTES && json.concat(data, length);
+	}
+
+	// Stages the fetched document if it is new and valid
+	void finish(int httpCode) {
+		Settings candidate;
+		if (httpCode == 200 && parse(json, candidate)) {
+			settings.stage(candidate);
+		} else if (httpCode != 200 && httpCode != 304) {
+			LOG_D("Config fetch returned: %i", httpCode);
+		}
+		json = String();
+	}
+
+	// Builds the candidate from the current settings and the document, false if it is unusable
+	bool parse(const String& document, Settings& candidate) {
+		JsonDocument doc;
+		DeserializationError error = deserializeJson(doc, document);
+		if (error) {
+			LOG_W("Config parse error: %s", error.c_str());
+			return false;
+		}
+
+		candidate = settings.get();
+		uint32_t revision = doc["revision"] | 0;
+		if (revision == 0 || revision == candidate.revision || revision == settings.getRejectedRevision()) {
+			return false;  // Unversioned, already active or already rolled back
+		}
+		candidate.revision = revision;
+
+		if (!doc["updateInterval"].isNull()) {
+			int interval = doc["updateInterval"] | 0;
+			if (interval < 5 || interval > 255) {
+				return invalid("updateInterval", revision);
+			}
+			candidate.updateInterval = interval;
+		}
+
+		JsonObject brightness = doc["brightness"];
+		if (!brightness.isNull()) {
+			int minimum = brightness["min"] | int(candidate.minBrightness);
+			int maximum = brightness["max"] | int(candidate.maxBrightness);
+			int step = brightness["step"] | int(candidate.brightnessStep);
+			if (minimum < 1 || maximum > 255 || minimum >= maximum || step < 1 || step > maximum - minimum) {
+				return invalid("brightness", revision);
+			}
+			candidate.minBrightness = minimum;
+			candidate.maxBrightness = maximum;
+			candidate.brightnessStep = step;
+		}
+
+		if (!doc["mirrors"].isNull()) {
+			JsonArray mirrors = doc["mirrors"];
+			if (mirrors.size() > SETTINGS_MAX_MIRRORS) {
+				return invalid("mirrors", revision);
+			}
+			candidate.numMirrors = 0;  // An empty list restores the built in mirrors
+			for (const char* url : mirrors) {
+				if (url == nullptr || strncmp(url, "http://", 7) != 0 || strlen(url) >= SETTINGS_URL_LEN) {
+					return invalid("mirrors", revision);
+				}
+				strcpy(candidate.mirrors[candidate.numMirrors++], url);
+			}
+		}
+
+		return true;
+	}
+
+	bool invalid(const char* field, uint32_t revision) {
+		LOG_W("Config revision %" PRIu32 " ignored: invalid %s", revision, field);
+		return false;
+	}
+};
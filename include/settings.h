@@ -0,0 +1,132 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Preferences.h>
+
+#include "log.h"
+
+// Preferences is in main.cpp
+extern Preferences preferences;
+
+#define SETTINGS_LAYOUT 1  // Bump when Settings changes so stale saved copies are ignored
+#define SETTINGS_MAX_MIRRORS 3
+#define SETTINGS_URL_LEN 96
+#define SETTINGS_PROBATION_FETCHES 6  // Feed fetches a new config must survive before it is saved
+#define SETTINGS_PROBATION_FAILURES 3  // Failed fetches within probation that roll it back
+
+/// Values that can be changed without a firmware release (see remoteConfig.h)
+struct Settings {
+	uint16_t layout = SETTINGS_LAYOUT;
+	uint32_t revision = 0;		  // Remote config revision these came from, 0 = built in
+	uint8_t updateInterval = 30;  // Fetch interval in seconds when a feed does not give one
+	uint8_t minBrightness = MIN_BRIGHTNESS;
+	uint8_t maxBrightness = MAX_BRIGHTNESS;
+	uint8_t brightnessStep = BRIGHTNESS_STEP;
+	uint8_t numMirrors = 0;	 // Mirrors of the city's feed, 0 = the built in ones
+	char mirrors[SETTINGS_MAX_MIRRORS][SETTINGS_URL_LEN] = {};
+};
+
+/**
+ * @brief The one place the firmware reads its tunable settings from
+ *
+ * New settings are staged (by the remote config sync) and only become active when the main
+ * loop calls applyStaged() at a point where nothing is using them, so a change is always
+ * seen as a whole. A new config is on probation for the next few feed fetches: if too many
+ * of them fail it is rolled back to the previous settings, otherwise it is saved and used
+ * again after a reboot. A reboot during probation also falls back to the saved settings.
+ */
+class SettingsCache {
+  public:
+	void begin() {
+		Settings saved;
+		preferences.begin("settings", true);
+		size_t loaded = preferences.getBytes("active", &saved, sizeof(saved));
+		rejectedRevision = preferences.getULong("rejected", 0);
+		preferences.end();
+
+		if (loaded == sizeof(saved) && saved.layout == SETTINGS_LAYOUT) {
+			active = saved;
+		}
+		LOG_I("Settings revision %" PRIu32, active.revision);
+	}
+
+	const Settings& get() const {
+		return active;
+	}
+
+	/// Revision that was rolled back, it will not be staged again
+	uint32_t getRejectedRevision() const {
+		return rejectedRevision;
+	}
+
+	/// Queue settings to be applied at the next safe point
+	void stage(const Settings& settings) {
+		staged = settings;
+		hasStaged = true;
+	}
+
+	/**
+	 * @brief Make the staged settings active, call only where nothing is reading them
+	 *
+	 * @return true if the settings changed
+	 */
+	bool applyStaged() {
+		if (!hasStaged) {
+			return false;
+		}
+		hasStaged = false;
+		previous = active;
+		active = staged;
+		probationFetches = SETTINGS_PROBATION_FETCHES;
+		probationFailures = 0;
+		LOG_I("Settings revision %" PRIu32 " applied (was %" PRIu32 ")", active.revision, previous.revision);
+		return true;
+	}
+
+	/**
+	 * @brief Report a feed fetch, decides whether settings on probation are kept
+	 *
+	 * @param ok The fetch returned data (or not modified)
+	 * @return true if the settings were rolled back and changed
+	 */
+	bool reportFetch(bool ok) {
+		if (probationFetches == 0) {
+			return false;
+		}
+		probationFetches--;
+		probationFailures += !ok;
+
+		if (probationFailures >= SETTINGS_PROBATION_FAILURES) {
+			LOG_W("Settings revision %" PRIu32 " rolled back to %" PRIu32 " after %u failed fetches",
+				  active.revision,
+				  previous.revision,
+				  probationFailures);
+			rejectedRevision = active.revision;
+			active = previous;
+			probationFetches = 0;
+			save();
+			return true;
+		}
+
+		if (probationFetches == 0) {
+			save();
+		}
+		return false;
+	}
+
+  private:
+	Settings active;
+	Settings previous;	// Restored if the active settings fail probation
+	Settings staged;
+	bool hasStaged = false;
+	uint8_t probationFetches = 0;
+	uint8_t probationFailures = 0;
+	uint32_t rejectedRevision = 0;
+
+	void save() {
+		preferences.begin("settings", false);
+		preferences.putBytes("active", &active, sizeof(active));
+		preferences.putULong("rejected", rejectedRevision);
+		preferences.end();
+	}
+};
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <Arduino.h>
+#include <esp_timer.h>
+
+#include "log.h"
+
+// Board traits: the core count comes from the chip's SDK config. A dual-core board can be
+// built with -DTASK_PLACEMENT_SHARED to lay the tasks out as on a single core (for comparison)
+#if CONFIG_FREERTOS_UNICORE || portNUM_PROCESSORS == 1 || defined(TASK_PLACEMENT_SHARED)
+	#define TASK_PLACEMENT_DUAL_CORE 0
+#else
+	#define TASK_PLACEMENT_DUAL_CORE 1
+#endif
+
+#if TASK_PLACEMENT_DUAL_CORE
+	#define NETWORK_CORE 0	// Wi-Fi and lwIP are pinned here by the SDK, loop() (fetch, parse, draw) and AsyncTCP join them
+	#define OUTPUT_CORE 1	// LED output alone, with the RMT interrupt it installs
+	#if ARDUINO_RUNNING_CORE != NETWORK_CORE
+		#warning "loop() shares the LED output core, add -DARDUINO_RUNNING_CORE=0 to the board's extra_flags"
+	#endif
+	#if !defined(CONFIG_ASYNC_TCP_RUNNING_CORE) || CONFIG_ASYNC_TCP_RUNNING_CORE != NETWORK_CORE
+		#warning "AsyncTCP may run on the LED output core, add -DCONFIG_ASYNC_TCP_RUNNING_CORE=0 to the board's extra_flags"
+	#endif
+#else
+	#define NETWORK_CORE tskNO_AFFINITY
+	#define OUTPUT_CORE tskNO_AFFINITY
+#endif
+
+/// The firmware's own tasks, see taskPlacements for where each one goes
+enum TaskRole : uint8_t {
+	TASK_LED_OUTPUT,
+	TASK_BUTTONS,
+	TASK_STATUS_LED,
+	TASK_IMPROV_SERIAL,
+	TASK_ROLES
+};
+
+struct TaskPlacement {
+	const char* name;
+	uint32_t stackSize;
+	UBaseType_t priority;  // loop() runs at 1, Wi-Fi, lwIP and esp_timer far above all of these
+	BaseType_t core;
+};
+
+// Everything but the LED output stays off its core, so only the RMT interrupt and the
+// output's own work can delay a frame
+const TaskPlacement taskPlacements[TASK_ROLES] = {
+	{ "LED Output", 2048, 2, OUTPUT_CORE },
+	{ "ButtonTask", 2048, 1, NETWORK_CORE },
+	{ "Status LED Manager", 1024, 1, NETWORK_CORE },
+	{ "Improv Serial Task", 4096, 2, NETWORK_CORE },
+};
+
+/**
+ * @brief Create one of the firmware's tasks where the board's layout puts it
+ *
+ * Pinned on dual-core chips, left to the scheduler on single-core ones (the same as
+ * xTaskCreate()).
+ *
+ * @param role Which task
+ * @param function Task body
+ * @param parameter Passed to the task body
+ * @param handle Receives the task handle, may be nullptr
+ * @return bool False if the task could not be created
+ */
+inline bool createPlacedTask(TaskRole role, TaskFunction_t function, void* parameter = nullptr,
+							 TaskHandle_t* handle = nullptr) {
+	const TaskPlacement& placement = taskPlacements[role];
+	BaseType_t created = xTaskCreatePinnedToCore(
+		function, placement.name, placement.stackSize, parameter, placement.priority, handle, placement.core);
+	if (created != pdPASS) {
+		LOG_E("Failed to create task %s", placement.name);
+		return false;
+	}
+	return true;
+}
+
+#if defined(SCHEDULING_BENCHMARK)
+	#define SCHEDULING_PROBE_PERIOD_US 10000  // The LED output's frame interval
+
+/**
+ * @brief Measure how late a task placed like the LED output runs after it is woken
+ *
+ * A periodic esp_timer notifies a probe task on the LED output's core and priority, and
+ * the probe takes the time from the timer firing to it running. The worst and mean wake
+ * latency are logged as a SchedulingRecord once a minute, under the real load of Wi-Fi,
+ * fetching and drawing. Build with and without -DTASK_PLACEMENT_SHARED to compare layouts.
+ */
+class SchedulingProbe {
+  public:
+	void begin() {
+		const TaskPlacement& placement = taskPlacements[TASK_LED_OUTPUT];
+		xTaskCreatePinnedToCore(probeTask, "Scheduling Probe", 2048, this, placement.priority, &task, placement.core);
+		esp_timer_create_args_t args = {};
+		args.callback = onTimer;
+		args.arg = this;
+		args.name = "scheduling probe";
+		esp_timer_create(&args, &timer);
+		esp_timer_start_periodic(timer, SCHEDULING_PROBE_PERIOD_US);
+	}
+
+  private:
+	TaskHandle_t task = nullptr;
+	esp_timer_handle_t timer = nullptr;
+	volatile int64_t firedAt = 0;
+
+	static void onTimer(void* arg) {
+		SchedulingProbe* probe = static_cast<SchedulingProbe*>(arg);
+		probe->firedAt = esp_timer_get_time();
+		xTaskNotifyGive(probe->task);
+	}
+
+	static void probeTask(void* arg) {
+		SchedulingProbe* probe = static_cast<SchedulingProbe*>(arg);
+		uint32_t maxMicros = 0, totalMicros = 0, wakes = 0;
+		int64_t reportAt = esp_timer_get_time() + 60000000;
+		while (true) {
+			ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+			int64_t now = esp_timer_get_time();
+			uint32_t latency = now - probe->firedAt;
+			maxMicros = max(maxMicros, latency);
+			totalMicros += latency;
+			wakes++;
+
+			if (now >= reportAt) {
+				LOG_RECORD_I(SchedulingRecord{ uint8_t(xPortGetCoreID()),
+												TASK_PLACEMENT_DUAL_CORE,
+												uint16_t(min(wakes, uint32_t(UINT16_MAX))),
+												maxMicros,
+												totalMicros / wakes });
+				maxMicros = totalMicros = wakes = 0;
+				reportAt = now + 60000000;
+			}
+		}
+	}
+};
+#endif
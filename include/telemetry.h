@@ -0,0 +1,250 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <WiFi.h>
+#include <esp_system.h>
+
+#include "feedClient.h"
+#include "log.h"
+
+// Preferences is in main.cpp
+extern Preferences preferences;
+
+#if !defined(TELEMETRY_DAILY_BYTES)
+	#define TELEMETRY_DAILY_BYTES 8192	// Upload budget per UTC day, request headers included
+#endif
+#define TELEMETRY_PERIOD_MS (60 * 60 * 1000UL)		  // One aggregated sample per hour
+#define TELEMETRY_UPLOAD_MS (6 * 60 * 60 * 1000UL)	  // Samples are uploaded in batches of (about) six
+#define TELEMETRY_SAMPLES 24						  // Samples kept while uploads fail (a day)
+#define TELEMETRY_HEADER_OVERHEAD 256				  // Approximate request and response header bytes
+#define TELEMETRY_VERSION 1
+
+/// Health of one period, aggregated in RAM
+struct __attribute__((packed)) TelemetrySample {
+	uint32_t epoch;			 // End of the period
+	uint16_t fetches;		 // Feed requests made
+	uint16_t fetchFailures;	 // Requests that did not return 200 or 304
+	uint16_t fetchMsAvg;	 // Mean request time of successful fetches
+	uint16_t fetchMsMax;
+	uint16_t heapMinKb;		 // Lowest free heap seen in the period
+	uint16_t fpsX10;		 // LED frames per second x10
+	uint16_t ledUnderruns;
+	uint16_t luxMin;		 // Ambient light range (0 without a light sensor)
+	uint16_t luxMax;
+	int8_t rssiMin;			 // Weakest Wi-Fi signal, dBm
+	int8_t temperatureMax;	 // Hottest MCU reading, °C
+};
+
+/// Sent once in front of the samples of each batch
+struct __attribute__((packed)) TelemetryHeader {
+	uint8_t version;
+	uint8_t mac[6];
+	char city[4];
+	char firmware[8];
+	uint16_t bootCount;
+	uint8_t resetReason;  // esp_reset_reason_t of the current boot
+	uint32_t uptimeS;
+	uint16_t droppedSamples;  // Overwritten before they could be uploaded
+	uint8_t sampleCount;
+};
+
+/**
+ * @brief Aggregates device health in RAM and uploads it in small binary batches
+ *
+ * The main loop reports each fetch and calls update() every pass; once an hour the running
+ * totals are closed into a TelemetrySample (24 bytes). Every six hours the pending samples
+ * are posted to TELEMETRY_URL as one application/octet-stream body, right after a feed
+ * fetch so the feed's kept-alive connection is reused when both live on the same server.
+ *
+ * Uploads stop for the rest of the day once TELEMETRY_DAILY_BYTES would be exceeded, and
+ * samples that could not be sent are kept (up to a day's worth) for the next batch.
+ * Decode or collect batches on the host with "Host Tools/telemetry-collector.py".
+ */
+class Telemetry {
+  public:
+	void begin() {
+		preferences.begin("telemetry", false);
+		bootCount = preferences.getUShort("boots", 0) + 1;
+		preferences.putUShort("boots", bootCount);
+		preferences.end();
+
+		resetReason = esp_reset_reason();
+		periodStart = millis();
+		lastUpload = millis();
+		reset();
+		LOG_I("Telemetry to %s, boot %u, reset reason %d", TELEMETRY_URL, bootCount, resetReason);
+	}
+
+	/**
+	 * @brief Count one feed request (and sample the MCU temperature)
+	 *
+	 * @param status HTTP status or FEED_ERROR_* code
+	 * @param totalMicros Request time
+	 */
+	void recordFetch(int status, uint32_t totalMicros) {
+		fetches++;
+		temperatureMax = max<int8_t>(temperatureMax, temperatureRead());
+		if (status != 200 && status != 304) {
+			fetchFailures++;
+			return;
+		}
+		uint32_t ms = totalMicros / 1000;
+		fetchMsSum += ms;
+		fetchMsCount++;
+		fetchMsMax = max(fetchMsMax, ms);
+	}
+
+	/// Count LED frames sent since the last call
+	void recordFrames(uint32_t frames, uint32_t underruns) {
+		ledFrames += frames;
+		ledUnderruns += underruns;
+	}
+
+	/**
+	 * @brief Sample the slow moving values and close the period when it is over
+	 *
+	 * @param epoch Current time
+	 * @param lux Ambient light (0 without a light sensor)
+	 */
+	void update(time_t epoch, float lux) {
+		heapMin = min(heapMin, ESP.getFreeHeap());
+		luxMin = min(luxMin, lux);
+		luxMax = max(luxMax, lux);
+		if (WiFi.status() == WL_CONNECTED) {
+			rssiMin = min<int8_t>(rssiMin, WiFi.RSSI());
+		}
+
+		uint32_t elapsed = millis() - periodStart;
+		if (elapsed < TELEMETRY_PERIOD_MS) {
+			return;
+		}
+
+		TelemetrySample& sample = samples[(firstSample + sampleCount) % TELEMETRY_SAMPLES];
+		if (sampleCount == TELEMETRY_SAMPLES) {
+			firstSample = (firstSample + 1) % TELEMETRY_SAMPLES;  // Overwrite the oldest
+			droppedSamples++;
+		} else {
+			sampleCount++;
+		}
+
+		sample = {
+			uint32_t(epoch),
+			saturate16(fetches),
+			saturate16(fetchFailures),
+			saturate16(fetchMsCount ? fetchMsSum / fetchMsCount : 0),
+			saturate16(fetchMsMax),
+			saturate16(heapMin / 1024),
+			saturate16(uint64_t(ledFrames) * 10000 / elapsed),
+			saturate16(ledUnderruns),
+			saturate16(uint32_t(luxMin)),
+			saturate16(uint32_t(luxMax)),
+			rssiMin,
+			temperatureMax,
+		};
+
+		periodStart = millis();
+		reset();
+	}
+
+	/**
+	 * @brief Upload the pending samples if a batch is due and the daily budget allows it
+	 *
+	 * @param client Client to post with, pass the feed's so its connection is reused
+	 * @param epoch Current time (for the daily budget)
+	 * @return true if a batch was accepted by the collector
+	 */
+	bool upload(FeedClient& client, time_t epoch) {
+		if (sampleCount == 0 || millis() - lastUpload < TELEMETRY_UPLOAD_MS) {
+			return false;
+		}
+
+		uint32_t day = epoch / 86400;
+		if (day != budgetDay) {
+			budgetDay = day;
+			bytesToday = 0;
+		}
+
+		size_t length = sizeof(TelemetryHeader) + sampleCount * sizeof(TelemetrySample);
+		if (bytesToday + length + TELEMETRY_HEADER_OVERHEAD > TELEMETRY_DAILY_BYTES) {
+			return false;  // Try again tomorrow, the samples are kept
+		}
+
+		uint8_t batch[sizeof(TelemetryHeader) + sizeof(samples)];
+		TelemetryHeader header = { TELEMETRY_VERSION };
+		WiFi.macAddress(header.mac);
+		strncpy(header.city, CITY_CODE, sizeof(header.city));
+		strncpy(header.firmware, FIRMWARE_VERSION, sizeof(header.firmware));
+		header.bootCount = bootCount;
+		header.resetReason = uint8_t(resetReason);
+		header.uptimeS = millis() / 1000;
+		header.droppedSamples = droppedSamples;
+		header.sampleCount = sampleCount;
+		memcpy(batch, &header, sizeof(header));
+		for (uint8_t i = 0; i < sampleCount; i++) {
+			memcpy(batch + sizeof(header) + i * sizeof(TelemetrySample),
+				   &samples[(firstSample + i) % TELEMETRY_SAMPLES],
+				   sizeof(TelemetrySample));
+		}
+
+		lastUpload = millis();
+		bytesToday += length + TELEMETRY_HEADER_OVERHEAD;
+		int status = client.post(TELEMETRY_URL, "application/octet-stream", batch, length);
+		if (status < 200 || status >= 300) {
+			LOG_W("Telemetry upload returned: %i", status);
+			return false;
+		}
+
+		LOG_D("Telemetry uploaded %u samples (%zu bytes, %" PRIu32 " today)", sampleCount, length, bytesToday);
+		firstSample = 0;
+		sampleCount = 0;
+		droppedSamples = 0;
+		return true;
+	}
+
+  private:
+	TelemetrySample samples[TELEMETRY_SAMPLES];
+	uint8_t firstSample = 0;
+	uint8_t sampleCount = 0;
+	uint16_t droppedSamples = 0;
+
+	uint16_t bootCount = 0;
+	esp_reset_reason_t resetReason = ESP_RST_UNKNOWN;
+	uint32_t periodStart = 0;
+	uint32_t lastUpload = 0;
+	uint32_t budgetDay = 0;
+	uint32_t bytesToday = 0;
+
+	// Running totals of the current period
+	uint32_t fetches;
+	uint32_t fetchFailures;
+	uint32_t fetchMsSum;
+	uint32_t fetchMsCount;
+	uint32_t fetchMsMax;
+	uint32_t heapMin;
+	uint32_t ledFrames;
+	uint32_t ledUnderruns;
+	float luxMin;
+	float luxMax;
+	int8_t rssiMin;
+	int8_t temperatureMax;
+
+	void reset() {
+		fetches = 0;
+		fetchFailures = 0;
+		fetchMsSum = 0;
+		fetchMsCount = 0;
+		fetchMsMax = 0;
+		heapMin = UINT32_MAX;
+		ledFrames = 0;
+		ledUnderruns = 0;
+		luxMin = INFINITY;
+		luxMax = 0.0f;
+		rssiMin = 0;
+		temperatureMax = INT8_MIN;
+	}
+
+	static uint16_t saturate16(uint64_t value) {
+		return value > UINT16_MAX ? UINT16_MAX : uint16_t(value);
+	}
+};
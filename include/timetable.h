@@ -3,22 +3,85 @@
 #include <FastLED.h>
 #include <vector>
 
+#include "log.h"
+#include "trackGraph.h"
+#include "traversalLearner.h"
+
+#define TIMETABLE_PACED_STEPS 16  // Longest path paced by learned traversal times, longer ones move at an even pace
+
 /**
  * @brief Structure representing a timetable entry
  * 
  * Each entry defines when a train enters a specific block along its route.
  */
 struct TimetableEntry {
-	int16_t offsetSeconds;	// Offset in seconds from route start time (-32768 to 32767)
-	int16_t blockNumber;	// Block number (0-32767, with -1 reserved for "no block")
+	int32_t offsetSeconds = 0;	// Offset in seconds from route start time
+	int32_t blockNumber = 0;	// Block number, with -1 reserved for "no block"
+};
+
+/**
+ * @brief A route's timetable entries as stored in flash
+ * 
+ * Each entry is stored as its change from the entry before it (the first from { 0, 0 }):
+ * one varint of the zigzag offset change shifted left by 3, with the block change + 2 in
+ * the low bits when it is -2 to 2 (nearly always), or 7 there and a zigzag varint of the
+ * block change after it. Entries a minute or so and a block apart take one or two bytes,
+ * with no limit on offsets or block numbers. Generated by createHeaderFile.py.
+ */
+struct TimetableData {
+	const uint8_t* bytes;  // Encoded entries
+	uint16_t length;	   // Bytes of encoded entries
+	uint16_t count;		   // Entries
+	int32_t firstOffset;   // Offset of the first entry
+	int32_t lastOffset;	   // Offset of the last entry
+};
+
+/**
+ * @brief Decodes a route's timetable entries one at a time, in order
+ */
+class TimetableCursor {
+  public:
+	explicit TimetableCursor(const TimetableData& data) : position(data.bytes), end(data.bytes + data.length) {}
 
 	/**
-	 * @brief Construct a new TimetableEntry object
+	 * @brief Decode the next entry
 	 * 
-	 * @param seconds Offset in seconds from route start time
-	 * @param block Block number for this entry
+	 * @param entry Receives the entry
+	 * @return true if there was one
 	 */
-	constexpr TimetableEntry(int16_t seconds, int16_t block) : offsetSeconds(seconds), blockNumber(block) {}
+	bool next(TimetableEntry& entry) {
+		if (position >= end) {
+			return false;
+		}
+		uint32_t head = readVarint();
+		current.offsetSeconds += unzigzag(head >> 3);
+		current.blockNumber += (head & 7) == 7 ? unzigzag(readVarint()) : int32_t(head & 7) - 2;
+		entry = current;
+		return true;
+	}
+
+  private:
+	const uint8_t* position;
+	const uint8_t* end;
+	TimetableEntry current;
+
+	uint32_t readVarint() {
+		uint32_t value = 0;
+		uint8_t shift = 0;
+		while (position < end) {
+			uint8_t byte = *position++;
+			value |= uint32_t(byte & 0x7F) << shift;
+			if (!(byte & 0x80)) {
+				break;
+			}
+			shift += 7;
+		}
+		return value;
+	}
+
+	static int32_t unzigzag(uint32_t value) {
+		return int32_t(value >> 1) ^ -int32_t(value & 1);
+	}
 };
 
 /**
@@ -32,11 +95,11 @@ class TrainRoute {
 	virtual ~TrainRoute() = default;
 
 	/**
-	 * @brief Get the timetable entries for this route
+	 * @brief Get the encoded timetable entries for this route
 	 * 
-	 * @return const reference to vector of timetable entries
+	 * @return TimetableData Entries in flash, read them with a TimetableCursor
 	 */
-	virtual const std::vector<TimetableEntry>& getEntries() const = 0;
+	virtual TimetableData getTimetable() const = 0;
 
 	/**
 	 * @brief Get the color used to display this route
@@ -55,23 +118,51 @@ class TrainRoute {
 	/**
 	 * @brief Get the current block number based on elapsed time
 	 * 
+	 * Between two entries whose blocks are not neighbours (blocks the timetable leaves out),
+	 * the train moves along the track between them instead of jumping. It stays in each block
+	 * for its share of the learned traversal times of the path, or at an even pace until
+	 * any of them have been learned.
+	 * 
 	 * @param elapsedSeconds Seconds elapsed since route start time
+	 * @param learned Traversal times learned from the realtime feed, nullptr for an even pace
 	 * @return uint16_t Current block number
 	 */
-	uint16_t getCurrentBlock(int32_t elapsedSeconds) const {
-		const auto& entries = getEntries();
-		if (entries.empty())
+	uint16_t getCurrentBlock(int32_t elapsedSeconds, const TraversalLearner* learned = nullptr) const {
+		TimetableCursor cursor(getTimetable());
+		TimetableEntry entry;
+		if (!cursor.next(entry))
 			return 0;
 
-		// Find the last entry whose offsetSeconds <= elapsedSeconds
-		for (int i = static_cast<int>(entries.size()) - 1; i >= 0; --i) {
-			if (entries[i].offsetSeconds <= elapsedSeconds) {
-				return entries[i].blockNumber;
+		// Find the last entry whose offsetSeconds <= elapsedSeconds and the one after it
+		// (or the first entry's block if we're before it)
+		TimetableEntry current = entry;
+		TimetableEntry following;
+		bool started = false;
+		bool hasFollowing = false;
+		do {
+			if (entry.offsetSeconds <= elapsedSeconds) {
+				current = entry;
+				started = true;
+				hasFollowing = false;
+			} else if (started && !hasFollowing) {
+				following = entry;
+				hasFollowing = true;
 			}
-		}
+		} while (cursor.next(entry));
 
-		// If we're before the first entry, return the first entry's block
-		return entries[0].blockNumber;
+		if (hasFollowing && current.blockNumber >= 0 && following.blockNumber >= 0) {
+			const TrackGraph& graph = getTrackGraph();
+			uint16_t steps = graph.distance(current.blockNumber, following.blockNumber);
+			if (steps > 1) {
+				int32_t duration = following.offsetSeconds - current.offsetSeconds;
+				int32_t elapsed = elapsedSeconds - current.offsetSeconds;
+				if (learned != nullptr && steps <= TIMETABLE_PACED_STEPS) {
+					return pacedBlock(current.blockNumber, following.blockNumber, steps, elapsed, duration, *learned);
+				}
+				return graph.walk(current.blockNumber, following.blockNumber, elapsed * steps / duration);
+			}
+		}
+		return current.blockNumber;
 	}
 
 	/**
@@ -80,10 +171,52 @@ class TrainRoute {
 	 * @return uint16_t Total size in bytes
 	 */
 	uint16_t getSize() const {
-		uint16_t timetableBytes = sizeof(TimetableEntry) * getEntries().size();
+		uint16_t timetableBytes = getTimetable().length;
 		uint16_t startTimesBytes = sizeof(uint32_t) * getStartTimes().size();
 		return timetableBytes + startTimesBytes;
 	}
+
+  private:
+	// Block on the path from one block to another after elapsed of duration seconds, each block taking its share of the
+	// learned times (blocks not learned yet take the mean of those that are)
+	static uint16_t pacedBlock(uint16_t from, uint16_t to, uint16_t steps, int32_t elapsed, int32_t duration,
+							   const TraversalLearner& learned) {
+		const TrackGraph& graph = getTrackGraph();
+		uint16_t path[TIMETABLE_PACED_STEPS];
+		uint16_t seconds[TIMETABLE_PACED_STEPS];
+		uint32_t learnedTotal = 0;
+		uint16_t learnedBlocks = 0;
+		uint16_t block = from;
+		for (uint16_t step = 0; step < steps; step++) {
+			path[step] = block;
+			if (learned.estimate(block, seconds[step])) {
+				learnedTotal += seconds[step];
+				learnedBlocks++;
+			} else {
+				seconds[step] = 0;
+			}
+			block = graph.nextBlock(block, to);
+		}
+		if (learnedBlocks == 0) {
+			return graph.walk(from, to, elapsed * steps / duration);
+		}
+
+		uint32_t total = 0;
+		for (uint16_t step = 0; step < steps; step++) {
+			if (seconds[step] == 0) {
+				seconds[step] = learnedTotal / learnedBlocks;
+			}
+			total += seconds[step];
+		}
+		uint32_t position = uint32_t(elapsed) * total / duration;
+		for (uint16_t step = 0; step < steps; step++) {
+			if (position < seconds[step]) {
+				return path[step];
+			}
+			position -= seconds[step];
+		}
+		return path[steps - 1];
+	}
 };
 
 /**
@@ -109,9 +242,10 @@ class TrainInstance {
 	 * @brief Get the current block number for this train
 	 * 
 	 * @param currentSecondsSinceMidnight Current time in seconds since midnight
+	 * @param learned Traversal times learned from the realtime feed, nullptr for an even pace
 	 * @return uint16_t Current block number
 	 */
-	uint16_t getCurrentBlock(uint32_t currentSecondsSinceMidnight) const {
+	uint16_t getCurrentBlock(uint32_t currentSecondsSinceMidnight, const TraversalLearner* learned = nullptr) const {
 		// Calculate elapsed time since train start as signed seconds.
 		// This allows timetable offsets to be negative (entries before start)
 		int32_t elapsedSeconds;
@@ -124,7 +258,7 @@ class TrainInstance {
 		}
 
 		// Use elapsed seconds to find current block
-		return route->getCurrentBlock(elapsedSeconds);
+		return route->getCurrentBlock(elapsedSeconds, learned);
 	}
 
 	/**
@@ -139,12 +273,12 @@ class TrainInstance {
 	 */
 	bool isVisible(uint32_t currentSecondsSinceMidnight) const {
 		// Get the first and last entry offsets
-		const auto& entries = route->getEntries();
-		if (entries.empty())
+		TimetableData timetable = route->getTimetable();
+		if (timetable.count == 0)
 			return false;
 
-		int32_t firstOffset = entries.front().offsetSeconds;
-		int32_t lastOffset = entries.back().offsetSeconds;
+		int32_t firstOffset = timetable.firstOffset;
+		int32_t lastOffset = timetable.lastOffset;
 
 		// Compute elapsed seconds as signed value (wrap across midnight)
 		int32_t elapsedSeconds;
@@ -209,10 +343,19 @@ inline std::vector<TrainInstance> createTrainsForRoute(const TrainRoute* route)
  */
 inline void printTimetableSize(const std::vector<const TrainRoute*>& routes) {
 	uint32_t bytes = 0;
+	uint32_t entryBytes = 0;
+	uint32_t entries = 0;
 	for (const auto& route : routes) {
 		bytes += route->getSize();
+		entryBytes += route->getTimetable().length;
+		entries += route->getTimetable().count;
 	}
-	Serial.printf("Loaded %d routes, ~%0.2f KiB\n", routes.size(), bytes / 1024.0);
+	LOG_I("Loaded %u routes, ~%0.2f KiB (%" PRIu32 " entries in %" PRIu32 " bytes, %0.2fx smaller than 4 bytes each)",
+		  unsigned(routes.size()),
+		  bytes / 1024.0,
+		  entries,
+		  entryBytes,
+		  entryBytes ? entries * 4.0 / entryBytes : 0.0);
 }
 
 #if defined(WLG_V1_0_0)
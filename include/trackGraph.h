@@ -0,0 +1,107 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Which blocks join which on a board's track, and the shortest path between any two
+ *
+ * Generated into flash by createHeaderFile.py from the block sequences of the timetable
+ * routes: consecutive blocks of a route are joined, less the shortcuts of routes that skip
+ * blocks (blocks are numbered along the line, so an edge is dropped when the blocks numbered
+ * between its ends already join them).
+ *
+ * Each block's row of the next-hop table holds, for every other block, which of its
+ * neighbours is the first step of a shortest path (a nibble, 0xF if there is none). A step
+ * is so O(1) and a whole path O(its length), without searching at runtime. Boards without a
+ * generated graph get an empty one, on which every move is a single step.
+ */
+class TrackGraph {
+  public:
+	/// Empty graph, every move is a single step
+	TrackGraph() = default;
+
+	TrackGraph(const uint8_t* nodes, uint16_t firstBlock, uint16_t blockRange, const uint16_t* blocks, uint8_t numNodes,
+			   const uint16_t* edgeStart, const uint8_t* neighbours, const uint8_t* nextHops)
+		: nodes(nodes),
+		  firstBlock(firstBlock),
+		  blockRange(blockRange),
+		  blocks(blocks),
+		  numNodes(numNodes),
+		  edgeStart(edgeStart),
+		  neighbours(neighbours),
+		  nextHops(nextHops) {}
+
+	/**
+	 * @brief First block on the way from one block to another
+	 *
+	 * @param from Block the train is in
+	 * @param to Block it is going to
+	 * @return uint16_t The next block, to itself if they are neighbours or either is not on the graph
+	 */
+	uint16_t nextBlock(uint16_t from, uint16_t to) const {
+		int fromNode = node(from);
+		int toNode = node(to);
+		if (fromNode < 0 || toNode < 0 || fromNode == toNode) {
+			return to;
+		}
+		uint8_t hop = (nextHops[fromNode * ((numNodes + 1) / 2) + toNode / 2] >> (toNode % 2 * 4)) & 0xF;
+		if (hop >= edgeStart[fromNode + 1] - edgeStart[fromNode]) {
+			return to;	// Not connected
+		}
+		return blocks[neighbours[edgeStart[fromNode] + hop]];
+	}
+
+	/**
+	 * @brief Steps on the shortest path between two blocks
+	 *
+	 * @return uint16_t 0 for the same block, 1 for neighbours or blocks not on the graph
+	 */
+	uint16_t distance(uint16_t from, uint16_t to) const {
+		uint16_t steps = 0;
+		while (from != to && steps < 255) {
+			from = nextBlock(from, to);
+			steps++;
+		}
+		return steps;
+	}
+
+	/**
+	 * @brief Block a number of steps along the shortest path between two blocks
+	 *
+	 * @param from Start of the path
+	 * @param to End of the path, returned if the path is shorter than steps
+	 * @param steps Steps from the start
+	 */
+	uint16_t walk(uint16_t from, uint16_t to, uint16_t steps) const {
+		while (steps-- > 0 && from != to) {
+			from = nextBlock(from, to);
+		}
+		return from;
+	}
+
+  private:
+	const uint8_t* nodes = nullptr;	 // Node of each block from firstBlock, 0xFF = not on the graph
+	uint16_t firstBlock = 0;
+	uint16_t blockRange = 0;
+	const uint16_t* blocks = nullptr;  // Block of each node
+	uint8_t numNodes = 0;
+	const uint16_t* edgeStart = nullptr;  // Per node, where its neighbours start
+	const uint8_t* neighbours = nullptr;
+	const uint8_t* nextHops = nullptr;
+
+	int node(uint16_t block) const {
+		if (block < firstBlock || block >= firstBlock + blockRange || nodes[block - firstBlock] == 0xFF) {
+			return -1;
+		}
+		return nodes[block - firstBlock];
+	}
+};
+
+#if defined(WLG_V1_0_0)
+	#include "WLG_V1_0_0_TrackGraph.h"
+#else
+inline const TrackGraph& getTrackGraph() {
+	static const TrackGraph graph;
+	return graph;
+}
+#endif
@@ -0,0 +1,289 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include <algorithm>
+#include <vector>
+
+#include "feedSource.h"
+#include "log.h"
+#include "trackGraph.h"
+
+#if defined(LED_2_PIN)
+	#define TRAIN_LAYER_PIXELS (LED_1_PIXELS + LED_2_PIXELS)
+#else
+	#define TRAIN_LAYER_PIXELS LED_1_PIXELS
+#endif
+
+#define TRAIN_SWEEP_MAX_STEPS 8	 // Longer moves are drawn as a jump (a train appearing, or a glitch in the feed)
+
+/**
+ * @brief Keeps the trains layer in step with the schedule, redrawing only the blocks that change
+ *
+ * A block shows the highest colour id of the trains in it: the post block of every update
+ * whose time has passed and the pre block of every update still to come (see mergeFeeds()
+ * for the priority order). Instead of working that out for the whole map every second:
+ *
+ * - load() takes a new schedule after a fetch, works out every block once and diffs it with
+ *   what is on the map (colour id and colour, merged ids can move between fetches), marking
+ *   only the blocks that differ.
+ * - draw() marks the pre and post blocks of the updates whose time has come since the last
+ *   draw (found through a by-time index with a cursor), works those out again from the
+ *   updates that touch them (a per-block index) and repaints only the marked blocks.
+ * - forEachArrival() hands each update out once when its time comes, through a second
+ *   cursor on the same index, so the consumers of transitions never rescan the schedule.
+ *
+ * An update whose blocks are not neighbours on the track graph (the feed skipped the blocks
+ * between them) sweeps the train along the path between them, a block a second, arriving in
+ * the post block at the update's time. The intermediate blocks are indexed like the pre and
+ * post blocks, with a step in the by-time index for each block of the sweep.
+ *
+ * Blocks are numbered as compositor pixels (LED_1 then LED_2). The schedule (up to 65535
+ * updates) and colour table passed to load() must stay unchanged until the next load().
+ */
+class TrainLayer {
+  public:
+	TrainLayer() {
+		std::fill_n(targets, TRAIN_LAYER_PIXELS, int16_t(-1));
+	}
+
+	/**
+	 * @brief Take a new schedule and mark the blocks it changes
+	 *
+	 * @param updates Merged schedule
+	 * @param colors Merged colour table
+	 * @param epoch Current time
+	 * @return uint16_t Blocks touched by the new schedule
+	 */
+	uint16_t load(const std::vector<LedUpdate>& updates, const std::vector<CRGB>& colors, time_t epoch) {
+		schedule = &updates;
+		previousColors.swap(colorTable);
+		colorTable = colors;
+		indexUpdates();
+		arrivalCursor = firstStepAfter(arrivedUntil);  // Updates of the new schedule up to then count as handed out
+		return evaluateAll(epoch);
+	}
+
+	/**
+	 * @brief Call fn with each update that took effect since the last call, in time order
+	 *
+	 * Works whatever is being drawn, and hands each update out once: not again after the
+	 * clock goes back, nor after load() if it was at or before the time already reached.
+	 *
+	 * @param epoch Current time
+	 * @param fn Called with each LedUpdate whose time is up to epoch
+	 */
+	template <typename Fn>
+	void forEachArrival(time_t epoch, Fn fn) {
+		for (; arrivalCursor < byTime.size() && byTime[arrivalCursor].time <= epoch; arrivalCursor++) {
+			const LedUpdate& update = (*schedule)[byTime[arrivalCursor].update];
+			if (byTime[arrivalCursor].time == update.timestamp) {  // The last step of a sweep is the arrival
+				fn(update);
+			}
+		}
+		arrivedUntil = max(arrivedUntil, epoch);
+	}
+
+	/**
+	 * @brief Bring the blocks up to date for the current time and repaint the ones that changed
+	 *
+	 * @param epoch Current time
+	 * @param setPixel Called with each changed block (as a compositor pixel) and its new colour
+	 * @return uint16_t Blocks repainted
+	 */
+	template <typename SetPixel>
+	uint16_t draw(time_t epoch, SetPixel setPixel) {
+		if (schedule != nullptr) {
+			if (epoch < evaluatedAt) {
+				previousColors = colorTable;
+				evaluateAll(epoch);	 // Clock went back, start over
+			}
+			for (; cursor < byTime.size() && byTime[cursor].time <= epoch; cursor++) {
+				forEachPathPixel(byTime[cursor].update, [&](int pixel) { reevaluate(pixel, epoch); });
+			}
+			evaluatedAt = epoch;
+		}
+
+		uint16_t repainted = 0;
+		for (uint16_t word = 0; word < (TRAIN_LAYER_PIXELS + 31) / 32; word++) {
+			while (dirty[word]) {
+				uint8_t bit = __builtin_ctz(dirty[word]);
+				dirty[word] &= dirty[word] - 1;
+				uint16_t pixel = word * 32 + bit;
+				setPixel(pixel, targets[pixel] >= 0 ? color(targets[pixel]) : CRGB(CRGB::Black));
+				repainted++;
+			}
+		}
+		return repainted;
+	}
+
+	/// Repaint every block at the next draw(), for when something else drew over the layer
+	void invalidate() {
+		for (uint16_t pixel = 0; pixel < TRAIN_LAYER_PIXELS; pixel++) {
+			markDirty(pixel);
+		}
+	}
+
+  private:
+	struct Step {
+		time_t time;	  // When the train moves
+		uint16_t update;  // Schedule index
+	};
+
+	const std::vector<LedUpdate>* schedule = nullptr;
+	std::vector<CRGB> colorTable;
+	std::vector<CRGB> previousColors;	  // Colour table the blocks on the map were drawn with
+	std::vector<Step> byTime;			  // Every move of every update (one, or one per block of a sweep) in time order
+	std::vector<uint8_t> sweepSteps;	  // Per update, blocks from pre to post block (1 = no sweep)
+	std::vector<uint32_t> blockStart;	  // Per pixel, where its updates start in blockUpdates
+	std::vector<uint16_t> blockUpdates;	  // Schedule indices of the updates with the pixel on their path
+	size_t cursor = 0;					  // First byTime entry still in the future
+	time_t evaluatedAt = 0;
+	size_t arrivalCursor = 0;			  // First byTime entry forEachArrival() has not handed out
+	time_t arrivedUntil = 0;			  // Updates up to this time have been handed out
+	int16_t targets[TRAIN_LAYER_PIXELS];  // Colour id each block shows, -1 = none
+	uint32_t dirty[(TRAIN_LAYER_PIXELS + 31) / 32] = {};
+
+	// Works out every block for the time given and marks the ones that differ from the map, returns how many
+	uint16_t evaluateAll(time_t epoch) {
+		const std::vector<LedUpdate>& updates = *schedule;
+		int16_t winners[TRAIN_LAYER_PIXELS];
+		std::fill_n(winners, TRAIN_LAYER_PIXELS, int16_t(-1));
+		for (size_t i = 0; i < updates.size(); i++) {
+			int pixel = trainPixel(i, epoch);
+			if (pixel >= 0 && updates[i].colorId > winners[pixel]) {
+				winners[pixel] = updates[i].colorId;
+			}
+		}
+
+		uint16_t touched = 0;
+		for (uint16_t pixel = 0; pixel < TRAIN_LAYER_PIXELS; pixel++) {
+			int16_t winner = winners[pixel];
+			bool recoloured = winner >= 0 && (winner >= int(previousColors.size()) || color(winner) != previousColors[winner]);
+			if (winner != targets[pixel] || recoloured) {
+				targets[pixel] = winner;
+				markDirty(pixel);
+				touched++;
+			}
+		}
+		evaluatedAt = epoch;
+		cursor = firstStepAfter(epoch);
+		return touched;
+	}
+
+	size_t firstStepAfter(time_t time) const {
+		return std::upper_bound(
+				   byTime.begin(), byTime.end(), time, [](time_t now, const Step& step) { return now < step.time; })
+			   - byTime.begin();
+	}
+
+	static int blockPixel(uint16_t block) {
+		if (block >= 100 && block < 100 + LED_1_PIXELS) {
+			return block - 100;
+#if defined(LED_2_PIN)
+		} else if (block >= 300 && block < 300 + LED_2_PIXELS) {
+			return LED_1_PIXELS + (block - 300);
+#endif
+		}
+		return -1;
+	}
+
+	CRGB color(int16_t colorId) const {
+		return colorId < int(colorTable.size()) ? colorTable[colorId] : CRGB(CRGB::Black);
+	}
+
+	void markDirty(uint16_t pixel) {
+		dirty[pixel / 32] |= 1UL << (pixel % 32);
+	}
+
+	// Builds the by-time and per-block indices of the schedule (counting sort by pixel)
+	void indexUpdates() {
+		const std::vector<LedUpdate>& updates = *schedule;
+		const TrackGraph& graph = getTrackGraph();
+		sweepSteps.resize(updates.size());
+		byTime.clear();
+		for (size_t i = 0; i < updates.size(); i++) {
+			uint16_t steps = graph.distance(updates[i].preBlock, updates[i].postBlock);
+			sweepSteps[i] = (steps > 1 && steps <= TRAIN_SWEEP_MAX_STEPS) ? steps : 1;
+			for (uint8_t step = 0; step < sweepSteps[i]; step++) {
+				byTime.push_back({ updates[i].timestamp - (sweepSteps[i] - 1 - step), uint16_t(i) });
+			}
+		}
+		std::sort(byTime.begin(), byTime.end(), [](const Step& a, const Step& b) { return a.time < b.time; });
+
+		blockStart.assign(TRAIN_LAYER_PIXELS + 1, 0);
+		for (const LedUpdate& update : updates) {
+			checkRange(update.preBlock);
+			if (update.postBlock != update.preBlock) {
+				checkRange(update.postBlock);
+			}
+		}
+		for (size_t i = 0; i < updates.size(); i++) {
+			forEachPathPixel(i, [&](int pixel) { blockStart[pixel + 1]++; });
+		}
+		for (uint16_t pixel = 0; pixel < TRAIN_LAYER_PIXELS; pixel++) {
+			blockStart[pixel + 1] += blockStart[pixel];
+		}
+		blockUpdates.resize(blockStart[TRAIN_LAYER_PIXELS]);
+		std::vector<uint32_t> next(blockStart.begin(), blockStart.end() - 1);
+		for (size_t i = 0; i < updates.size(); i++) {
+			forEachPathPixel(i, [&](int pixel) { blockUpdates[next[pixel]++] = i; });
+		}
+	}
+
+	// Calls fn with each distinct pixel from the update's pre block to its post block
+	template <typename Fn>
+	void forEachPathPixel(size_t index, Fn fn) const {
+		const LedUpdate& update = (*schedule)[index];
+		int pre = blockPixel(update.preBlock);
+		if (pre >= 0) {
+			fn(pre);
+		}
+		uint16_t block = update.preBlock;
+		for (uint8_t step = 1; step <= sweepSteps[index]; step++) {
+			block = step == sweepSteps[index] ? update.postBlock : getTrackGraph().nextBlock(block, update.postBlock);
+			int pixel = blockPixel(block);
+			if (pixel >= 0 && pixel != pre) {
+				fn(pixel);
+			}
+		}
+	}
+
+	// Pixel the update's train is in at the given time, -1 if none
+	int trainPixel(size_t index, time_t epoch) const {
+		const LedUpdate& update = (*schedule)[index];
+		if (epoch >= update.timestamp) {
+			return blockPixel(update.postBlock);
+		}
+		time_t sweepStart = update.timestamp - (sweepSteps[index] - 1);
+		if (epoch < sweepStart) {
+			return blockPixel(update.preBlock);
+		}
+		return blockPixel(getTrackGraph().walk(update.preBlock, update.postBlock, epoch - sweepStart + 1));
+	}
+
+	void checkRange(uint16_t block) {
+		if (blockPixel(block) < 0 && block != 0) {	// Block 0 is used for trains appearing and disappearing
+			LOG_RECORD_W(BlockRangeRecord{ block });
+		}
+	}
+
+	// Works out one block again from the updates that touch it
+	void reevaluate(int pixel, time_t epoch) {
+		if (pixel < 0) {
+			return;
+		}
+		const std::vector<LedUpdate>& updates = *schedule;
+		int16_t winner = -1;
+		for (uint32_t i = blockStart[pixel]; i < blockStart[pixel + 1]; i++) {
+			uint16_t index = blockUpdates[i];
+			if (updates[index].colorId > winner && trainPixel(index, epoch) == pixel) {
+				winner = updates[index].colorId;
+			}
+		}
+		if (winner != targets[pixel]) {
+			targets[pixel] = winner;
+			markDirty(pixel);
+		}
+	}
+};
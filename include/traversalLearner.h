@@ -0,0 +1,283 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <Preferences.h>
+#include <vector>
+
+#include "log.h"
+
+// Preferences is in main.cpp
+extern Preferences preferences;
+
+#define TRAVERSAL_BLOCKS 512	   // Block numbers tracked (same range as the realtime renderer)
+#define TRAVERSAL_SKETCHES 256	   // (route, block) pairs kept, must be a power of two
+#define TRAVERSAL_PROBES 8		   // Slots searched before evicting the least observed pair
+#define TRAVERSAL_MIN_SECONDS 2	   // Shorter traversals are feed corrections, not trains
+#define TRAVERSAL_MAX_SECONDS 1800  // Longer traversals are layovers or lost trains
+
+/**
+ * @brief Learns how long trains take to cross each block from the realtime feed
+ *
+ * Every pre->post transition the realtime renderer applies is fed to onTransition().
+ * A transition into a block stamps it with the time and route, the transition out of it
+ * by the same route gives one traversal time for that (route, block) pair.
+ *
+ * Each pair keeps a streaming median estimate in a fixed 256 entry table (2 KiB), so
+ * memory use does not grow with the network or the number of days observed. Each block's
+ * estimate over all routes is kept alongside (1 KiB). The table is saved to Preferences
+ * periodically and restored on boot, so the estimates keep improving across restarts. The timetable modes use them to pace trains through the
+ * blocks their timetables leave out (see TrainRoute::getCurrentBlock()).
+ *
+ * Everything but toJson() is called from the main loop, which is also the only writer;
+ * toJson() takes the lock the writers hold, so the web server can call it from its task.
+ */
+class TraversalLearner {
+  public:
+	/**
+	 * @brief Stable key for a route name from the feed's colour table
+	 *
+	 * @param name Route name (the key of the feed's colors object)
+	 * @return uint16_t Key, never 0 (0 marks an empty slot)
+	 */
+	static uint16_t routeKey(const char* name) {
+		uint32_t hash = 2166136261u;  // FNV-1a
+		while (*name) {
+			hash = (hash ^ uint8_t(*name++)) * 16777619u;
+		}
+		uint16_t key = uint16_t(hash ^ (hash >> 16));
+		return key ? key : 1;
+	}
+
+	void begin() {
+		lock = xSemaphoreCreateMutex();
+		preferences.begin("traversal", true);
+		size_t loaded = preferences.getBytes("sketches", sketches, sizeof(sketches));
+		preferences.end();
+		if (loaded != sizeof(sketches)) {
+			memset(sketches, 0, sizeof(sketches));
+		}
+		for (const Sketch& sketch : sketches) {
+			if (sketch.route != 0) {
+				refreshBlock(sketch.block);
+			}
+		}
+		LOG_I("Loaded %u learned block traversal times", size());
+	}
+
+	/**
+	 * @brief Record a transition applied by the renderer
+	 *
+	 * @param route Route key of the train (see routeKey())
+	 * @param preBlock Block the train left
+	 * @param postBlock Block the train entered
+	 * @param timestamp Time of the transition
+	 */
+	void onTransition(uint16_t route, uint16_t preBlock, uint16_t postBlock, time_t timestamp) {
+		if (preBlock != 0 && preBlock < TRAVERSAL_BLOCKS && preBlock != postBlock) {
+			BlockEntry& entry = entries[preBlock];
+			if (entry.route == route && entry.time != 0 && timestamp > time_t(entry.time)) {
+				xSemaphoreTake(lock, portMAX_DELAY);
+				addSample(route, preBlock, uint32_t(timestamp - entry.time));
+				xSemaphoreGive(lock);
+			}
+			entry.route = 0;
+		}
+
+		if (postBlock != 0 && postBlock < TRAVERSAL_BLOCKS) {
+			entries[postBlock] = { uint32_t(timestamp), route };
+		}
+	}
+
+	/**
+	 * @brief Look up the learned traversal time of a block
+	 *
+	 * @param route Route key
+	 * @param block Block number
+	 * @param seconds Median traversal time if known
+	 * @return true if the pair has been observed at least minSamples times
+	 */
+	bool estimate(uint16_t route, uint16_t block, uint16_t& seconds) const {
+		const Sketch* sketch = find(route, block);
+		if (sketch == nullptr || sketch->count < minSamples) {
+			return false;
+		}
+		seconds = sketch->median;
+		return true;
+	}
+
+	/**
+	 * @brief Look up the learned traversal time of a block over every route crossing it
+	 *
+	 * Kept up to date as samples arrive, so it costs one lookup (the timetable modes call it
+	 * for every block of every visible train on each draw).
+	 *
+	 * @param block Block number
+	 * @param seconds Mean of the route medians, weighted by their samples, if known
+	 * @return true if any route has been observed crossing it at least minSamples times
+	 */
+	bool estimate(uint16_t block, uint16_t& seconds) const {
+		if (block >= TRAVERSAL_BLOCKS || blockSeconds[block] == 0) {
+			return false;
+		}
+		seconds = blockSeconds[block];
+		return true;
+	}
+
+	/**
+	 * @brief Set the route keys of the current feed colours, for toJson()
+	 *
+	 * @param keys Route key of each merged colour, in order
+	 */
+	void setRoutes(const std::vector<uint16_t>& keys) {
+		xSemaphoreTake(lock, portMAX_DELAY);
+		routes = keys;
+		xSemaphoreGive(lock);
+	}
+
+	/// Save the table if it changed and the save interval has passed
+	void update() {
+		if (dirty && millis() - lastSave > saveInterval) {
+			preferences.begin("traversal", false);
+			preferences.putBytes("sketches", sketches, sizeof(sketches));
+			preferences.end();
+			dirty = false;
+			lastSave = millis();
+			LOG_D("Saved %u learned block traversal times", size());
+		}
+	}
+
+	/// Number of (route, block) pairs with an estimate
+	uint16_t size() const {
+		uint16_t used = 0;
+		for (const Sketch& sketch : sketches) {
+			used += (sketch.route != 0);
+		}
+		return used;
+	}
+
+	/**
+	 * @brief Export the estimates, may be called from any task
+	 *
+	 * As {"routes": ["<route key>", ...], "blocks": {"<route key>": {"<block>": [median seconds, samples], ...}, ...}},
+	 * the routes in feed colour order (see setRoutes()).
+	 */
+	void toJson(JsonDocument& doc) const {
+		xSemaphoreTake(lock, portMAX_DELAY);
+		char key[8];
+		for (size_t i = 0; i < routes.size(); i++) {
+			snprintf(key, sizeof(key), "%04x", routes[i]);
+			doc["routes"][i] = key;
+		}
+		JsonObject blocks = doc["blocks"].to<JsonObject>();
+		for (const Sketch& sketch : sketches) {
+			if (sketch.route != 0) {
+				char block[8];
+				snprintf(key, sizeof(key), "%04x", sketch.route);
+				snprintf(block, sizeof(block), "%u", sketch.block);
+				JsonArray estimate = blocks[key][block].to<JsonArray>();
+				estimate.add(sketch.median);
+				estimate.add(sketch.count);
+			}
+		}
+		xSemaphoreGive(lock);
+	}
+
+  private:
+	struct BlockEntry {
+		uint32_t time;	 // When the current train entered the block
+		uint16_t route;	 // Its route key, 0 if the block is empty
+	};
+
+	struct Sketch {
+		uint16_t route;	  // 0 = empty slot
+		uint16_t block;
+		uint16_t median;  // Streaming median of the traversal time in seconds
+		uint16_t count;	  // Samples seen (saturating)
+	};
+
+	static const uint16_t minSamples = 3;
+	static const uint32_t saveInterval = 30 * 60 * 1000;  // ms
+
+	SemaphoreHandle_t lock = nullptr;  // Held while the sketches or routes change, and by toJson()
+	BlockEntry entries[TRAVERSAL_BLOCKS] = {};
+	Sketch sketches[TRAVERSAL_SKETCHES] = {};
+	uint16_t blockSeconds[TRAVERSAL_BLOCKS] = {};  // estimate() of each block, 0 = unknown
+	std::vector<uint16_t> routes;
+	bool dirty = false;
+	uint32_t lastSave = 0;
+
+	static uint16_t slotFor(uint16_t route, uint16_t block) {
+		return (route ^ (block * 40503u)) & (TRAVERSAL_SKETCHES - 1);
+	}
+
+	const Sketch* find(uint16_t route, uint16_t block) const {
+		uint16_t slot = slotFor(route, block);
+		for (uint8_t probe = 0; probe < TRAVERSAL_PROBES; probe++) {
+			const Sketch& sketch = sketches[(slot + probe) & (TRAVERSAL_SKETCHES - 1)];
+			if (sketch.route == route && sketch.block == block) {
+				return &sketch;
+			}
+		}
+		return nullptr;
+	}
+
+	void addSample(uint16_t route, uint16_t block, uint32_t seconds) {
+		if (seconds < TRAVERSAL_MIN_SECONDS || seconds > TRAVERSAL_MAX_SECONDS) {
+			return;
+		}
+
+		// Find the pair, or the slot to put it in (an empty one, else the least observed)
+		uint16_t slot = slotFor(route, block);
+		Sketch* target = nullptr;
+		for (uint8_t probe = 0; probe < TRAVERSAL_PROBES; probe++) {
+			Sketch& sketch = sketches[(slot + probe) & (TRAVERSAL_SKETCHES - 1)];
+			if (sketch.route == route && sketch.block == block) {
+				target = &sketch;
+				break;
+			}
+			if (sketch.route == 0) {
+				target = &sketch;  // Slots are never freed, so the pair cannot be further along
+				break;
+			}
+			if (target == nullptr || sketch.count < target->count) {
+				target = &sketch;
+			}
+		}
+
+		if (target->route != route || target->block != block) {
+			uint16_t evicted = target->route ? target->block : 0;
+			*target = { route, block, uint16_t(seconds), 0 };
+			if (evicted != 0 && evicted != block) {
+				refreshBlock(evicted);
+			}
+		}
+
+		// Sign driven median tracking: moves at most ~6% towards each sample, so single
+		// outliers barely shift it while a real timetable change is followed within a day
+		int32_t step = max<int32_t>(1, target->median / 16);
+		int32_t delta = constrain(int32_t(seconds) - int32_t(target->median), -step, step);
+		target->median = uint16_t(target->median + delta);
+		if (target->count < UINT16_MAX) {
+			target->count++;
+		}
+		refreshBlock(block);
+		dirty = true;
+	}
+
+	// Recompute a block's estimate over every route crossing it, once per sample rather than per lookup
+	void refreshBlock(uint16_t block) {
+		if (block >= TRAVERSAL_BLOCKS) {
+			return;
+		}
+		uint32_t total = 0;
+		uint32_t samples = 0;
+		for (const Sketch& sketch : sketches) {
+			if (sketch.route != 0 && sketch.block == block && sketch.count >= minSamples) {
+				total += uint32_t(sketch.median) * sketch.count;
+				samples += sketch.count;
+			}
+		}
+		blockSeconds[block] = samples ? total / samples : 0;  // Medians are at least TRAVERSAL_MIN_SECONDS
+	}
+};
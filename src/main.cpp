@@ -1,10 +1,10 @@
 #include <Arduino.h>
 #include <ArduinoJson.h>
 #include <FastLED.h>
-#include <HTTPClient.h>
 #include <Preferences.h>
 #include <WiFi.h>
 #include <esp_sntp.h>
+#include <esp_timer.h>
 #include <time.h>
 #include <vector>
 
@@ -17,6 +17,10 @@
 #if defined(TIMETABLE_MODE)
 	#include "timetable.h"
 #endif
+#if defined(MODE_BUTTON)
+	#define HEATMAP_MODE 1	// Only reachable with the mode button, boards without one leave it out
+	#include "heatmap.h"
+#endif
 
 #if defined(LIGHT_SENSOR)
 	#include "autoBrightness.h"
@@ -24,37 +28,119 @@
 	#include "manualBrightness.h"
 #endif
 
+#if !defined(FEED_CLIENT_BLOCKING)
+	#include "asyncFeedClient.h"
+#endif
 #include "buttons.h"
+#include "compositor.h"
+#include "eventBus.h"
+#include "feedClient.h"
+#include "feedDecoder.h"
+#include "feedSource.h"
+#include "ledOutput.h"
+#include "log.h"
+#include "metricsHistory.h"
+#include "powerManagement.h"
+#include "recordStore.h"
+#include "settings.h"
+#include "taskPlacement.h"
+#include "trainLayer.h"
+#include "traversalLearner.h"
+
+#if defined(CONFIG_URL)
+	#include "remoteConfig.h"
+#endif
+#if defined(TELEMETRY_URL)
+	#include "telemetry.h"
+#endif
 
 Preferences preferences;
+EventBus eventBus;
+RecordStore recordStore;
+SettingsCache settings;
+#if defined(CONFIG_URL)
+RemoteConfig remoteConfig;
+#endif
 BrightnessManager brightness;
 ButtonManager buttons;
+PowerManager power;
+LedOutput ledOutput;
+Compositor compositor;
+TraversalLearner traversal;
+#if defined(HEATMAP_MODE)
+Heatmap heatmap;
+#endif
+TrainLayer trainLayer;
+MetricsHistory metrics;
+AsyncEventSource webEvents("/events");	// Live bus events for the web UI
+StaticEventQueue<32> webEventQueue;
+#if defined(TELEMETRY_URL)
+Telemetry telemetry;
+#endif
+#if defined(SCHEDULING_BENCHMARK)
+SchedulingProbe schedulingProbe;
+#endif
 
-// Array of server URLs for failover
-String serverURLs[] = {
-	String("http://keastudios.co.nz/") + CITY_CODE + "-ltm/" + BACKEND_VERSION + ".json",
-	String("http://dirksonline.net/") + CITY_CODE + "-ltm/" + BACKEND_VERSION + ".json",
-	// String("http://192.168.86.31:3000/") + CITY_CODE + "-ltm/" + BACKEND_VERSION + ".json",	 // For local server for testing
+// Realtime feeds drawn on the map, each with its own mirrors for failover (see feedSource.h)
+FeedSource feeds[] = {
+	FeedSource("ltm",
+			   {
+				   String("http://keastudios.co.nz/") + CITY_CODE + "-ltm/" + BACKEND_VERSION + ".json",
+				   String("http://dirksonline.net/") + CITY_CODE + "-ltm/" + BACKEND_VERSION + ".json",
+				   // String("http://192.168.86.31:3000/") + CITY_CODE + "-ltm/" + BACKEND_VERSION + ".json",	 // For local server for testing
+			   },
+			   0),
+#if defined(OVERLAY_FEED_URL)
+	FeedSource("overlay", { OVERLAY_FEED_URL }, 1),	 // Second operator or test overlay, drawn over the main feed
+#endif
 };
-const int numServers = sizeof(serverURLs) / sizeof(serverURLs[0]);
-int currentServerIndex = 0;
+const size_t numFeeds = sizeof(feeds) / sizeof(feeds[0]);
+
+FeedClient feedClient;	// Blocking, for the rare telemetry uploads
+#if defined(FEED_CLIENT_BLOCKING)
+FeedClient& feedFetcher = feedClient;
+#else
+AsyncFeedClient feedFetcher;  // Feeds are fetched in the background while the loop keeps running
+#endif
+FeedDecoderRegistry feedDecoders;
+FeedSource* fetchingFeed = nullptr;	 // Feed whose fetch is in flight
+String feedPayload;					 // Its body, written by the feed client's sink until the fetch completes
+uint32_t fetchHeapBefore = 0;
+int fetchResult = 0;				 // Result of a blocking fetch
+uint32_t loopMaxMicros = 0;			 // Longest loop pass since the last fetch summary
 
 const char* ntpServers[] = { "nz.pool.ntp.org", "pool.msltime.measurement.govt.nz", "pool.ntp.org" };
 const char* time_zone = "NZST-12NZDT,M9.5.0,M4.1.0/3";
 
-time_t lastMapDrawTime = 0;	  // Tracks the last time the map was drawn
-time_t nextFetchTime = 0;	  // Tracks when the next update should occur
-uint32_t modeStartTime = 0;	  // Tracks when the current mode started (for fast forward mode timing)
-uint8_t fetchOffset = 0;	  // Random time ms to fetch (reduces server load)
-uint8_t updateInterval = 30;  // Default update interval in seconds
+time_t lastMapDrawTime = 0;	 // Tracks the last time the map was drawn (the second the frame is for)
+uint32_t modeStartTime = 0;	 // Tracks when the current mode started (for fast forward mode timing)
+uint8_t fetchOffset = 0;	 // Random time ms to fetch (reduces server load)
 
+// Modes the mode button cycles through
+enum Mode {
+	REALTIME,
+#if defined(HEATMAP_MODE)
+	HEATMAP,
+#endif
 #if defined(TIMETABLE_MODE)
-enum Mode { REALTIME, ONE_X_TIMETABLE, FAST_FORWARD_TIMETABLE };
+	ONE_X_TIMETABLE,
+	FAST_FORWARD_TIMETABLE,
+#endif
+	NUM_MODES
+};
+const char* modeNames[] = {
+	"REALTIME",
+#if defined(HEATMAP_MODE)
+	"HEATMAP",
+#endif
+#if defined(TIMETABLE_MODE)
+	"1x TIMETABLE",
+	"FAST FORWARD TIMETABLE",
+#endif
+};
 Mode mode = REALTIME;
+#if defined(TIMETABLE_MODE)
 const auto& routes = getAllRoutes();
-#else
-enum Mode { REALTIME };
-Mode mode = REALTIME;
 #endif
 
 // Pins and pixel counts defined in the board file (./boards/)
@@ -63,18 +149,20 @@ CRGB leds1[LED_1_PIXELS];
 CRGB leds2[LED_2_PIXELS];
 #endif
 
-CRGB black = CRGB::Black;
+// Colours and schedule of all feeds merged by mergeFeeds(), this is all the renderer looks at
 std::vector<CRGB> colorTable;
-
-// --- Data structure for scheduled LED updates ---
-struct LedUpdate {
-	uint16_t preBlock;
-	uint16_t postBlock;
-	int colorId;
-	time_t timestamp;  // Timestamp for when the update should occur
-};
-
+std::vector<uint16_t> colorRouteKeys;	// Route key of each colorTable entry (see TraversalLearner::routeKey)
 std::vector<LedUpdate> ledUpdateSchedule;
+uint16_t blocksTouched = 0;	 // Blocks the last new schedule changed on the map
+
+#if defined(RENDER_REACTIVE)
+const time_t renderLookahead = 0;  // Draw each second once it has started
+#else
+const time_t renderLookahead = 1;  // Draw the next second ahead of time and present it on the second
+#endif
+uint32_t photonMaxMicros = 0;	 // Longest delay from a frame's due time to its transmit starting, since the last fetch summary
+uint32_t photonTotalMicros = 0;	 // Sum of those delays, for the mean
+uint16_t photonFrames = 0;		 // Frames with a due time presented
 
 enum statusLedCommand {
 	LED_OFF = 0,
@@ -94,36 +182,45 @@ typedef struct {
 } statusLed;
 
 TaskHandle_t statusLedTaskHandle;
-TaskHandle_t fastLEDDitheringTaskHandle;
-
-void fastLEDDitheringTask(void* pvParameters) {
-	const TickType_t delay = pdMS_TO_TICKS(20);	 // 50fps = 20ms interval
-	while (true) {
-		FastLED.show();
-		vTaskDelay(delay);
+TaskHandle_t ledOutputTaskHandle;
+
+void ledOutputTask(void* pvParameters) {
+	const TickType_t delay = pdMS_TO_TICKS(10);	 // 100fps = 10ms interval, fast enough to hide the temporal dither
+	const int64_t delayMicros = int64_t(delay) * portTICK_PERIOD_MS * 1000;
+	if (!ledOutput.begin()) {  // From here, so the RMT interrupt is on the output core
+		LOG_E("LED output not started, the map stays dark");
+		while (true) {
+			vTaskDelay(portMAX_DELAY);	// show() and repair() would send from buffers that were never allocated
+		}
 	}
-}
-
-const char* getLocalTime(time_t epoch) {
-	struct tm timeinfo;
-	static char buffer[64];
-	struct timeval tv;
+	TickType_t lastWake = xTaskGetTickCount();
+	while (true) {
+		int64_t due = compositor.dueTime();
+		bool presented = compositor.present(esp_timer_get_time());	// Swap in the next frame if its time has come
+		ledOutput.show();											// Returns once the transmit has started
+		if (presented && due > 0) {
+			uint32_t latency = max(esp_timer_get_time() - due, int64_t(0));
+			photonMaxMicros = max(photonMaxMicros, latency);
+			photonTotalMicros += latency;
+			photonFrames++;
+		}
+		ledOutput.repair();	 // Sleeps until the frame is sent, resends it if it was corrupted
 
-	// Convert epoch to local time
-	if (!localtime_r(&epoch, &timeinfo)) {
-		return "No time available";
-	}
-	gettimeofday(&tv, nullptr);
-	int ms = tv.tv_usec / 1000;
-	if (strftime(buffer, sizeof(buffer), "%H:%M:%S", &timeinfo)) {
-		snprintf(buffer + strlen(buffer), sizeof(buffer) - strlen(buffer), ".%03d", ms);
-		return buffer;
+		// Wake on the next frame's due time rather than the tick after it: sleep the whole ticks, spin the rest
+		int64_t wait = compositor.dueTime() - esp_timer_get_time();
+		if (wait > 0 && wait < delayMicros) {
+			vTaskDelay(wait / 1000 / portTICK_PERIOD_MS);
+			while (esp_timer_get_time() < compositor.dueTime()) {
+			}
+			lastWake = xTaskGetTickCount();
+		} else {
+			vTaskDelayUntil(&lastWake, delay);
+		}
 	}
-	return "Format error";
 }
 
 void timeavailable(struct timeval* t) {
-	Serial.println("NTP Synced");
+	LOG_I("NTP Synced");
 }
 
 void setCharlieplexedLED(uint8_t pin, statusLedCommand state) {
@@ -230,9 +327,9 @@ const char* getSystemInfo() {
 		sizeof(buffer),
 		"\n%s\n"
 		"%s-Rev%d\n"
-		"%d Core @ %dMHz\n"
-		"%dMiB Flash @ %dMHz in %s Mode\n"
-		"RAM Heap: %dkiB\n"
+		"%d Core @ %" PRIu32 "MHz\n"
+		"%" PRIu32 "MiB Flash @ %" PRIu32 "MHz in %s Mode\n"
+		"RAM Heap: %" PRIu32 "kiB\n"
 		"IDF SDK: %s\n",
 		ARDUINO_BOARD,
 		ESP.getChipModel(),
@@ -248,114 +345,148 @@ const char* getSystemInfo() {
 	return buffer;
 }
 
-String downloadJSON() {
-	HTTPClient http;
-	String payload;
-
-	String url = serverURLs[currentServerIndex];
-	http.setConnectTimeout(1000);  // Set timeout to 1 second per attempt
-	http.setFollowRedirects(HTTPC_FORCE_FOLLOW_REDIRECTS);
-
-	http.begin(url);
+// The feed client has a request in flight (a feed, or a config check between feeds)
+bool feedFetcherBusy() {
+#if defined(FEED_CLIENT_BLOCKING)
+	return false;
+#else
+	return feedFetcher.busy();
+#endif
+}
 
-	int httpCode = http.GET();
-	if (httpCode == HTTP_CODE_OK) {
-		payload = http.getString();
-		http.end();
-		if (payload.length() == 0) {
-			Serial.printf("Fetch from %s returned too little data (%d bytes)\n", url.c_str(), payload.length());
-		} else {
-			return payload;
-		}
-	} else {
-		Serial.printf("Fetch from %s returned: %i\n", url.c_str(), httpCode);
-		http.end();
-		currentServerIndex++;  // Try the next server on the next attempt
-		currentServerIndex = currentServerIndex % numServers;
+// Starts fetching a feed from its current mirror into feedPayload, completed by pollFetch()
+void startFetch(FeedSource& feed, time_t epoch) {
+	if (feed.isLate(epoch)) {
+		setStatusLedState(WIFI_LED_PIN, LED_ON_GREEN, SERVER_LED_PIN, LED_BLINK_GREEN_FAST);
 	}
 
-	return String();
+	fetchHeapBefore = ESP.getFreeHeap();
+	feedPayload = String();
+	feedPayload.reserve(feed.sizeHint);
+	BodySink sink = [](const uint8_t* data, size_t length) {
+		return feedPayload.concat(data, length);
+	};
+	fetchingFeed = &feed;
+#if defined(FEED_CLIENT_BLOCKING)
+	fetchResult = feedFetcher.get(feed.url().c_str(), feed.validators, sink);
+#else
+	feedFetcher.get(feed.url().c_str(), feed.validators, sink);
+#endif
 }
 
-void setBlockColorRGB(uint16_t block, CRGB color) {
+// Finishes the fetch in flight, returns the HTTP status (304 if unchanged) or FEED_PENDING while it is still running
+int finishDownload(FeedSource& feed) {
+#if defined(FEED_CLIENT_BLOCKING)
+	int httpCode = fetchResult;
+#else
+	int httpCode = feedFetcher.poll();
+	if (httpCode == FEED_PENDING) {
+		return FEED_PENDING;
+	}
+#endif
+	const String& url = feed.url();
+
+	LOG_RECORD_I(HttpRecord{ int16_t(httpCode),
+							 feedFetcher.reused,
+							 feedFetcher.bodyBytes,
+							 feedFetcher.connectMicros,
+							 feedFetcher.firstByteMicros,
+							 feedFetcher.totalMicros,
+							 int32_t(fetchHeapBefore) - int32_t(ESP.getFreeHeap()) });
+
+	if (httpCode == 200 && feedPayload.length() == 0) {
+		LOG_W("Fetch from %s returned too little data (%d bytes)", url.c_str(), feedPayload.length());
+	} else if (httpCode == 200) {
+		feed.sizeHint = max(feed.sizeHint, feedPayload.length());
+	} else if (httpCode != 304) {
+		LOG_W("Fetch from %s returned: %i", url.c_str(), httpCode);
+		feed.failover();  // Try the next mirror on the next attempt
+	}
 
-	// Apply gamma correction (γ = 2.0)
-	auto gammaCorrect = [](float value) -> uint8_t {
-		return static_cast<uint8_t>(pow(value / 255.0f, 2.0) * 255.0f);
-	};
+	return httpCode;
+}
 
-	color.r = gammaCorrect(color.r);
-	color.g = gammaCorrect(color.g);
-	color.b = gammaCorrect(color.b);
+void setBlockColorRGB(CompositorLayer layer, uint16_t block, CRGB color) {
+	// Gamma correction (γ = 2.0) is applied at 16 bits by the LED output
 
-	// Set the color on the appropriate strand based on the block number
+	// Set the color on the appropriate strand based on the block number (compositor pixels run LED_1 then LED_2)
 	if (block >= 100 && block < 100 + LED_1_PIXELS) {
-		leds1[block - 100] = color;
+		compositor.set(layer, block - 100, color);
 #if defined(LED_2_PIN)
 	} else if (block >= 300 && block < 300 + LED_2_PIXELS) {
-		leds2[block - 300] = color;
+		compositor.set(layer, LED_1_PIXELS + (block - 300), color);
 #endif
 	} else if (block != 0) {  // Ignore block 0 (used for trains appearing and disappearing)
-		Serial.printf("Block %d is out of range for both strands.\n", block);
+		LOG_RECORD_W(BlockRangeRecord{ block });
 	}
 }
 
-void setBlockColorId(uint8_t* blockColorIds, uint16_t block, int colorId) {
-	if (colorId < blockColorIds[block]) {
-		return;	 // Do not update if the new color is lower priority
-	}
-
-	blockColorIds[block] = colorId;	 // Update the color ID for the block
-
-	// Get the actual color from the color table, defaulting to black if out of range
-	CRGB color = (colorId >= 0 && colorId < static_cast<int>(colorTable.size())) ? colorTable[colorId] : black;
+// esp_timer time of the start of a wall clock second, in the past or the future
+int64_t presentationTime(time_t epoch) {
+	struct timeval now;
+	gettimeofday(&now, nullptr);
+	return esp_timer_get_time() + (int64_t(epoch) - now.tv_sec) * 1000000 - now.tv_usec;
+}
 
-	setBlockColorRGB(block, color);
+// Renders the changed parts of the layers into a frame the LED output task shows at presentAt (0 = straight away)
+void composeFrame(int64_t presentAt) {
+	compositor.compose(presentAt);
 }
 
-void clearLEDs() {
-	// Clear both strands
-#if defined(LED_2_PIN)
-	fill_solid(leds2, LED_2_PIXELS, black);
+// Passes the transitions that happened since the last call to the traversal learner, heatmap and event bus
+void applyTransitions(time_t epoch) {
+	trainLayer.forEachArrival(epoch, [](const LedUpdate& update) {
+#if defined(HEATMAP_MODE)
+		heatmap.onTransition(update.postBlock, update.timestamp);
 #endif
-	fill_solid(leds1, LED_1_PIXELS, black);
+		if (update.colorId >= 0 && update.colorId < static_cast<int>(colorRouteKeys.size())) {
+			traversal.onTransition(colorRouteKeys[update.colorId], update.preBlock, update.postBlock, update.timestamp);
+		}
+		eventBus.publishBlock(update.preBlock, update.postBlock, uint8_t(update.colorId));
+	});
 }
 
+// Redraws only the blocks the last fetch or the trains moving since the last draw changed
 void drawRealtimeMap(time_t epoch) {
-	vTaskSuspend(fastLEDDitheringTaskHandle);
-	clearLEDs();
-
-	uint8_t blockColorIds[512] = { 0 };	 // Initialize all elements to 0
-
-	// Draw the map based on the current LED update schedule
-	for (const auto& update : ledUpdateSchedule) {
-		if (epoch >= update.timestamp) {
-			setBlockColorId(blockColorIds, update.postBlock, update.colorId);
-		} else {
-			setBlockColorId(blockColorIds, update.preBlock, update.colorId);
-		}
-	}
+	power.acquireBusy();
+	compositor.clear(LAYER_BASE);  // Heatmap
+	trainLayer.draw(epoch, [](uint16_t pixel, CRGB color) { compositor.set(LAYER_TRAINS, pixel, color); });
+	composeFrame(presentationTime(epoch));
+	power.releaseBusy();
+}
 
-	vTaskResume(fastLEDDitheringTaskHandle);
+#if defined(HEATMAP_MODE)
+void drawHeatmap(time_t epoch) {
+	power.acquireBusy();
+	compositor.clear(LAYER_TRAINS);
+	trainLayer.invalidate();  // Repaint the trains when realtime mode is back
+	heatmap.draw(epoch, [](uint16_t block, CRGB color) { setBlockColorRGB(LAYER_BASE, block, color); });
+	composeFrame(presentationTime(epoch));
+	power.releaseBusy();
 }
+#endif
 
 #if defined(TIMETABLE_MODE)
-void drawTimetableMap(uint32_t second, const std::vector<const TrainRoute*>& routes) {
-	vTaskSuspend(fastLEDDitheringTaskHandle);
-	clearLEDs();
+void drawTimetableMap(uint32_t second, const std::vector<const TrainRoute*>& routes, int64_t presentAt = 0) {
+	power.acquireBusy();
+	compositor.clear(LAYER_BASE);  // Heatmap
+	compositor.beginLayer(LAYER_TRAINS);
 
 	for (size_t routeIndex = 0; routeIndex < routes.size(); routeIndex++) {
 		const TrainRoute* route = routes[routeIndex];
 		auto trains = createTrainsForRoute(route);
 		for (size_t trainIndex = 0; trainIndex < trains.size(); trainIndex++) {
 			if (trains[trainIndex].isVisible(second)) {
-				uint16_t block = trains[trainIndex].getCurrentBlock(second);
-				setBlockColorRGB(block, route->getColor());
+				uint16_t block = trains[trainIndex].getCurrentBlock(second, &traversal);
+				setBlockColorRGB(LAYER_TRAINS, block, route->getColor());
 			}
 		}
 	}
 
-	vTaskResume(fastLEDDitheringTaskHandle);
+	compositor.endLayer(LAYER_TRAINS);
+	trainLayer.invalidate();
+	composeFrame(presentAt);
+	power.releaseBusy();
 }
 
 void drawFastForwardTimetable(const std::vector<const TrainRoute*>& routes, uint32_t start_time, float xSpeed = 1000.0f) {
@@ -367,65 +498,159 @@ void drawFastForwardTimetable(const std::vector<const TrainRoute*>& routes, uint
 }
 #endif
 
-time_t parseLEDMap(const String& downloadedJson) {
-	JsonDocument doc;
-	DeserializationError error = deserializeJson(doc, downloadedJson);
-
-	if (error) {
-		Serial.printf("JSON parse error: %s\n", error.c_str());
+// Decodes a feed document into its FeedSource and merges all feeds into the render schedule
+time_t parseLEDMap(const String& downloadedJson, const char* contentType, FeedSource& feed) {
+	FeedData data;
+	if (!feedDecoders.decode(contentType, reinterpret_cast<const uint8_t*>(downloadedJson.c_str()), downloadedJson.length(), data)) {
 		return 0;
 	}
 
-	String version = doc["version"] | "";
-	time_t baseTimestamp = doc["timestamp"] | 0;
-	updateInterval = doc["update"] | updateInterval;
-	JsonObject colors = doc["colors"];
-	JsonArray updates = doc["updates"];
+	time_t baseTimestamp = data.timestamp;
+	feed.updateInterval = data.updateInterval ? data.updateInterval : settings.get().updateInterval;
 
-	if (baseTimestamp + updateInterval > nextFetchTime) {
-		nextFetchTime = baseTimestamp + updateInterval;
+	if (baseTimestamp + feed.updateInterval > feed.nextFetchTime) {
+		feed.nextFetchTime = baseTimestamp + feed.updateInterval;
 	} else {
-		Serial.println("Fetched the same data twice");
+		LOG_D("Fetched the same data twice");
 		return baseTimestamp;  // No need to update if the data is the same
 	}
 
-	if (String(BACKEND_VERSION) != version) {
-		Serial.printf("Backend version mismatch: expected %s, got %s\n", BACKEND_VERSION, version.c_str());
+	LOG_D("%ld %s v%s base timestamp: %ld, Update offset: %d, Next fetch time: %ld",
+		  time(nullptr),
+		  feed.name,
+		  data.version.c_str(),
+		  baseTimestamp,
+		  feed.updateInterval,
+		  feed.nextFetchTime);
+
+	feed.colors.swap(data.colors);
+	feed.routeKeys.swap(data.routeKeys);
+	feed.updates.swap(data.updates);
+
+	mergeFeeds(feeds, numFeeds, colorTable, colorRouteKeys, ledUpdateSchedule);
+	traversal.setRoutes(colorRouteKeys);
+	blocksTouched = trainLayer.load(ledUpdateSchedule, colorTable, time(nullptr));
+	return baseTimestamp;
+}
+
+// Pushes the active settings to everything that caches them
+void applySettings() {
+	const Settings& current = settings.get();
+	const char* mirrors[SETTINGS_MAX_MIRRORS];
+	for (uint8_t i = 0; i < current.numMirrors; i++) {
+		mirrors[i] = current.mirrors[i];
 	}
+	feeds[0].overrideMirrors(mirrors, current.numMirrors);	// The city's own feed
+	brightness.setBrightness();
+}
 
-	// Serial.printf("%ld Base timestamp: %ld, Update offset: %d, Next fetch time: %ld\n",
-	// 			  time(nullptr),
-	// 			  baseTimestamp,
-	// 			  updateInterval,
-	// 			  nextFetchTime);
-
-	// Populate colorTable from the JSON colors object
-	colorTable.clear();
-	for (JsonPair kv : colors) {
-		JsonArray rgb = kv.value().as<JsonArray>();
-		colorTable.push_back(CRGB(rgb[0] | 0, rgb[1] | 0, rgb[2] | 0));
+// Completes the fetch in flight once the feed client has a result
+void pollFetch(time_t epoch) {
+	FeedSource& feed = *fetchingFeed;
+	int httpCode = finishDownload(feed);
+	if (httpCode == FEED_PENDING) {
+		return;
 	}
+	fetchingFeed = nullptr;
 
-	ledUpdateSchedule.clear();
-	for (JsonObject update : updates) {
-		JsonArray blocks = update["b"];
-		int colorId = update["c"];
-		int offset = update["t"];
-
-		// Schedule color update
-		LedUpdate ledUpdate;
-		ledUpdate.preBlock = blocks[0];
-		ledUpdate.postBlock = blocks[1];
-		if (offset > 0) {
-			ledUpdate.timestamp = baseTimestamp + offset;
-		} else {
-			ledUpdate.timestamp = 0;
-		}
-		ledUpdate.colorId = colorId;
-		ledUpdateSchedule.push_back(ledUpdate);
+	time_t timeOffset = 0;
+	if (settings.reportFetch(httpCode == 200 || httpCode == 304)) {
+		applySettings();  // New settings failed, rolled back
+	}
+	metrics.recordFetch(httpCode, feedFetcher.totalMicros);
+#if defined(TELEMETRY_URL)
+	telemetry.recordFetch(httpCode, feedFetcher.totalMicros);
+#endif
+	if (httpCode == 200 && feedPayload.length() > 0) {
+		setStatusLedState(WIFI_LED_PIN, LED_ON_GREEN, SERVER_LED_PIN, LED_ON_GREEN);
+		power.acquireBusy();
+		timeOffset = epoch - parseLEDMap(feedPayload, feedFetcher.getContentType(), feed);
+		feedPayload = String();
+		power.releaseBusy();
+	} else if (httpCode == 304) {
+		setStatusLedState(WIFI_LED_PIN, LED_ON_GREEN, SERVER_LED_PIN, LED_ON_GREEN);
+		LOG_D("Feed %s not modified", feed.name);
+	} else {
+		LOG_W("Feed %s: all servers failed to provide data.", feed.name);
+		setStatusLedState(WIFI_LED_PIN, LED_ON_GREEN, SERVER_LED_PIN, LED_ON_RED);
 	}
 
-	return baseTimestamp;
+	feed.nextFetchTime = constrain(feed.nextFetchTime, epoch + 6, epoch + feed.updateInterval);
+	eventBus.publishFetch(httpCode, uint8_t(&feed - feeds), uint16_t(min(ledUpdateSchedule.size(), size_t(UINT16_MAX))));
+
+	LOG_RECORD_I(FetchRecord{ uint32_t(epoch),
+							  int16_t(timeOffset),
+							  int8_t(temperatureRead()),
+							  int8_t(WiFi.RSSI()),
+							  uint16_t(ledOutput.frames),
+							  uint16_t(ledOutput.underruns),
+							  uint16_t(ledOutput.retransmits),
+							  uint16_t(min(ledOutput.maxTxMicros, uint32_t(UINT16_MAX))),
+							  ledOutput.maxEncodeCycles,
+							  loopMaxMicros,
+							  blocksTouched,
+							  photonMaxMicros,
+							  photonFrames ? photonTotalMicros / photonFrames : 0 });
+	Serial.flush();
+#if defined(TELEMETRY_URL)
+	telemetry.recordFrames(ledOutput.frames, ledOutput.underruns);
+#endif
+	ledOutput.frames = 0;
+	ledOutput.underruns = 0;
+	ledOutput.retransmits = 0;
+	ledOutput.maxTxMicros = 0;
+	ledOutput.maxEncodeCycles = 0;
+	loopMaxMicros = 0;
+	blocksTouched = 0;
+	photonMaxMicros = 0;
+	photonTotalMicros = 0;
+	photonFrames = 0;
+
+#if defined(CONFIG_URL) && defined(FEED_CLIENT_BLOCKING)
+	remoteConfig.update(feedClient);  // Over the feed connection, holds up the loop like the feed fetch
+#endif
+#if defined(TELEMETRY_URL)
+	telemetry.upload(feedClient, epoch);
+#endif
+}
+
+// Passes bus events on to the open web UI pages as server-sent events (JSON), drops them when none are open
+void forwardWebEvents() {
+	static const char* eventNames[EVENT_TYPES] = { "block", "fetch", "brightness", "mode" };
+	Event event;
+	while (webEventQueue.receive(event)) {
+		if (webEvents.count() == 0) {
+			continue;
+		}
+		char json[80];
+		switch (event.type) {
+			case EVENT_BLOCK:
+				snprintf(json,
+						 sizeof(json),
+						 "{\"from\":%u,\"to\":%u,\"color\":%u}",
+						 event.block.fromBlock,
+						 event.block.toBlock,
+						 event.block.colorId);
+				break;
+			case EVENT_FETCH:
+				snprintf(json,
+						 sizeof(json),
+						 "{\"feed\":\"%s\",\"status\":%d,\"updates\":%u}",
+						 feeds[event.fetch.feed].name,
+						 event.fetch.status,
+						 event.fetch.updates);
+				break;
+			case EVENT_BRIGHTNESS:
+				snprintf(json, sizeof(json), "{\"gain\":%u}", event.brightness.gain);
+				break;
+			case EVENT_MODE:
+				snprintf(json, sizeof(json), "{\"mode\":\"%s\"}", modeNames[event.mode.mode]);
+				break;
+			default:
+				continue;
+		}
+		webEvents.send(json, eventNames[event.type], event.publishedMs);
+	}
 }
 
 void onBrightnessDown() {
@@ -443,14 +668,12 @@ void onPower() {
 #if defined(MODE_BUTTON)
 void onMode() {
 	// Cycle through modes
-	mode = Mode((mode + 1) % 3);
+	mode = Mode((mode + 1) % NUM_MODES);
 	modeStartTime = millis();	// Reset start time for fast forward mode
 	lastMapDrawTime = 0;		// Force immediate redraw
 	brightness.setPower(true);	// Ensure brightness is on when changing modes
-	Serial.printf("Mode button pressed, mode changed to %s\n",
-				  (mode == REALTIME)		  ? "REALTIME"
-				  : (mode == ONE_X_TIMETABLE) ? "1x TIMETABLE"
-											  : "FAST FORWARD TIMETABLE");
+	eventBus.publishMode(mode);
+	LOG_I("Mode button pressed, mode changed to %s", modeNames[mode]);
 }
 #endif
 
@@ -458,7 +681,15 @@ void setup() {
 	// USB Serial
 	Serial.begin();
 	Serial.setDebugOutput(true);
-	xTaskCreate(improvSerialTask, "Improv Serial Task", 4096, nullptr, 2, nullptr);
+	createPlacedTask(TASK_IMPROV_SERIAL, improvSerialTask);
+
+	// --- Runtime settings (Wi-Fi, brightness, factory test) and remote config that passed probation ---
+	recordStore.begin();
+#if defined(RECORD_STORE_BENCHMARK)
+	benchmarkRecordStore(recordStore, preferences);
+#endif
+	settings.begin();
+	registerFeedDecoders(feedDecoders);	 // Feed formats and backend versions this firmware decodes
 
 	// --- Setup Addressable LEDs ---
 #if defined(LVL_Shifter_EN)
@@ -468,15 +699,22 @@ void setup() {
 	pinMode(LED_5V_EN, OUTPUT);
 	digitalWrite(LED_5V_EN, LOW);  // Disable 5V Power
 
-	// FastLED initialization
-	FastLED.addLeds<WS2811, LED_1_PIN, GRB>(leds1, LED_1_PIXELS);
+	// LED output initialization (FastLED is only used for colour maths)
+	ledOutput.add(LED_1_PIN, leds1, LED_1_PIXELS);
+#if defined(LED_2_PIN)
+	ledOutput.add(LED_2_PIN, leds2, LED_2_PIXELS);
+#endif
+	// Renderers draw into the compositor's layers, it writes what changed to the strands
+	compositor.add(leds1, LED_1_PIXELS);
 #if defined(LED_2_PIN)
-	FastLED.addLeds<WS2811, LED_2_PIN, GRB>(leds2, LED_2_PIXELS);
+	compositor.add(leds2, LED_2_PIXELS);
+#endif
+#if defined(COMPOSITOR_BENCHMARK)
+	benchmarkCompositor(compositor, COMPOSITOR_PIXELS);
 #endif
-	FastLED.clear(true);  // Clear all pixels on both strands
-	FastLED.setDither(BINARY_DITHER);
 
-	xTaskCreate(fastLEDDitheringTask, "FastLED Dithering", 1024, NULL, 2, &fastLEDDitheringTaskHandle);
+	power.begin();
+	createPlacedTask(TASK_LED_OUTPUT, ledOutputTask, nullptr, &ledOutputTaskHandle);
 
 #if defined(LVL_Shifter_EN)
 	digitalWrite(LVL_Shifter_EN, LOW);	//Enable LVL Shifter
@@ -492,11 +730,12 @@ void setup() {
 #endif
 	buttons.begin();
 
-	Serial.println(getSystemInfo());
+	LOG_I("%s", getSystemInfo());
 
 #if defined(FACTORY_TEST)
 	factoryTestMode();
 	buttons.setCallback(POWER_BUTTON, onPower);
+	compositor.invalidate();  // The test wrote the strands directly
 #endif
 
 	// --- Time Setup ---
@@ -506,7 +745,7 @@ void setup() {
 	configTzTime(time_zone, ntpServers[0], ntpServers[1], ntpServers[2]);
 
 	// --- WiFi Setup ---
-	xTaskCreate(statusLedManagerTask, "Status LED Manager", 1024, NULL, 1, &statusLedTaskHandle);
+	createPlacedTask(TASK_STATUS_LED, statusLedManagerTask, nullptr, &statusLedTaskHandle);
 	setStatusLedState(WIFI_LED_PIN, LED_BLINK_GREEN_FAST, SERVER_LED_PIN, LED_OFF);
 	WiFi.setTxPower(WIFI_POWER_15dBm);	// Set WiFi power to avoid interference
 
@@ -514,52 +753,96 @@ void setup() {
 
 	WiFiImprovSetup();
 
+	// Learned block traversal times, for the timetable generator and anything predicting train positions
+	traversal.begin();
+	server.on("/traversal.json", HTTP_GET, [](AsyncWebServerRequest* request) {
+		JsonDocument doc;
+		traversal.toJson(doc);	// Under the learner's lock, the loop may be merging feeds or learning
+		String json;
+		serializeJson(doc, json);
+		request->send(200, "application/json", json);
+	});
+
+	// Minute by minute health history, decode with "Host Tools/metrics-decoder.py"
+	metrics.begin();
+	server.on("/metrics.bin", HTTP_GET, [](AsyncWebServerRequest* request) {
+		AsyncWebServerResponse* response = request->beginResponse(
+			"application/octet-stream", metrics.size(), [](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+				return metrics.read(index, buffer, maxLen);
+			});
+		response->addHeader("Content-Disposition", "attachment; filename=\"metrics.bin\"");
+		request->send(response);
+	});
+
+	// Block, fetch, brightness and mode changes as they happen, for the web UI (EventSource("/events"))
+	eventBus.subscribe(webEventQueue, EVENT_MASK_ALL);
+	server.addHandler(&webEvents);
+
 #if defined(TIMETABLE_MODE)
 	printTimetableSize(routes);
 #endif
 	brightness.begin();
+	applySettings();
+#if defined(TELEMETRY_URL)
+	telemetry.begin();
+#endif
+#if defined(SCHEDULING_BENCHMARK)
+	schedulingProbe.begin();
+#endif
+	LOG_I("Setup done in %lu ms, free heap %" PRIu32, millis(), ESP.getFreeHeap());
 }
 
 void loop() {
+	uint32_t loopStart = micros();
 	time_t epoch = time(nullptr);  // Get current time
 	bool wiFiConnected = (WiFi.status() == WL_CONNECTED);
 	if (!wiFiConnected)
 		manageWiFiConnection();
 
 	switch (mode) {
-		// Run the realtime mode using the LED-Rails backend server (default)
+		// Run the realtime mode using the LED-Rails backend server (default), or show its occupancy heatmap
 		case REALTIME:
+#if defined(HEATMAP_MODE)
+		case HEATMAP:
+#endif
 			if (wiFiConnected) {
-				// --- Fetch new data periodically ---
-				if (epoch > nextFetchTime && millis() % 1000 > fetchOffset) {
-					if (epoch > nextFetchTime + updateInterval) {
-						setStatusLedState(WIFI_LED_PIN, LED_ON_GREEN, SERVER_LED_PIN, LED_BLINK_GREEN_FAST);
-					}
+				// --- Safe point: no fetch or draw in progress, switch to newly fetched settings ---
+				if (fetchingFeed == nullptr && settings.applyStaged()) {
+					applySettings();
+				}
 
-					time_t timeOffset = 0;
-					String downloadedJson = downloadJSON();
-					if (downloadedJson.length() > 0) {
-						setStatusLedState(WIFI_LED_PIN, LED_ON_GREEN, SERVER_LED_PIN, LED_ON_GREEN);
-						time_t timeOffset = epoch - parseLEDMap(downloadedJson);
-					} else {
-						Serial.println("All servers failed to provide data.");
-						setStatusLedState(WIFI_LED_PIN, LED_ON_GREEN, SERVER_LED_PIN, LED_ON_RED);
+				// --- Fetch new data periodically, one feed at a time in the background so the loop stays responsive ---
+				if (fetchingFeed == nullptr && !feedFetcherBusy() && millis() % 1000 > fetchOffset) {
+					for (FeedSource& feed : feeds) {
+						if (feed.isDue(epoch)) {
+							startFetch(feed, epoch);
+							break;
+						}
 					}
-
-					nextFetchTime = constrain(nextFetchTime, epoch + 6, epoch + updateInterval);
-
-					Serial.printf("%s fetchDelay:%is MCU:%2.0f°C WiFi:%idBm\n",
-								  getLocalTime(epoch),
-								  timeOffset,
-								  temperatureRead(),
-								  WiFi.RSSI());
-					Serial.flush();
 				}
+				if (fetchingFeed != nullptr) {
+					pollFetch(epoch);
+				}
+#if defined(CONFIG_URL) && !defined(FEED_CLIENT_BLOCKING)
+				if (fetchingFeed == nullptr) {
+					remoteConfig.update(feedFetcher);  // Between feed fetches, on the feed's client
+				}
+#endif
 
-				// --- Push updates to the LED strips only if changes were made ---
-				if (lastMapDrawTime < epoch) {
-					drawRealtimeMap(epoch);	 // Draw the map with the current updates
-					lastMapDrawTime = epoch;
+				applyTransitions(epoch);  // Only looks at the updates whose time has come
+
+				// --- Draw the next second ahead of time, once the frame before it has been presented ---
+				time_t frameTime = lastMapDrawTime == 0 ? epoch : epoch + renderLookahead;
+				if (lastMapDrawTime < frameTime && !compositor.framePending()) {
+					if (mode == REALTIME) {
+						drawRealtimeMap(frameTime);	 // Draw the map with the current updates
+					}
+#if defined(HEATMAP_MODE)
+					if (mode == HEATMAP) {
+						drawHeatmap(frameTime);
+					}
+#endif
+					lastMapDrawTime = frameTime;
 				}
 
 			} else {
@@ -574,12 +857,13 @@ void loop() {
 #if defined(TIMETABLE_MODE)
 		// Run the timetable mode at 1x speed (uses wiFi for time sync if available)
 		case ONE_X_TIMETABLE:
-			if (epoch > lastMapDrawTime) {
+			if (lastMapDrawTime < epoch + renderLookahead && !compositor.framePending()) {
+				time_t frameTime = lastMapDrawTime == 0 ? epoch : epoch + renderLookahead;
 				struct tm timeinfo;
-				localtime_r(&epoch, &timeinfo);
+				localtime_r(&frameTime, &timeinfo);
 				uint32_t secondsSinceMidnight = timeinfo.tm_hour * 3600 + timeinfo.tm_min * 60 + timeinfo.tm_sec;
-				drawTimetableMap(secondsSinceMidnight, routes);
-				lastMapDrawTime = epoch;
+				drawTimetableMap(secondsSinceMidnight, routes, presentationTime(frameTime));
+				lastMapDrawTime = frameTime;
 			}
 
 			if (wiFiConnected) {
@@ -593,19 +877,32 @@ void loop() {
 
 		// Run the timetable mode at 1000x speed (no wiFi required)
 		case FAST_FORWARD_TIMETABLE:
-			drawFastForwardTimetable(routes, modeStartTime, 1000.0f);  // 1000x speed
+			if (!compositor.framePending()) {
+				drawFastForwardTimetable(routes, modeStartTime, 1000.0f);  // 1000x speed, shown as soon as it is drawn
+			}
 			setStatusLedState(WIFI_LED_PIN, LED_OFF, SERVER_LED_PIN, LED_OFF);
-			nextFetchTime = 0;
+			for (FeedSource& feed : feeds) {
+				feed.nextFetchTime = 0;	 // Fetch straight away when returning to realtime
+			}
 			break;
 #endif
 
 		default:
-			Serial.println("Unknown mode, reverting to REALTIME");
+			LOG_W("Unknown mode, reverting to REALTIME");
 			mode = REALTIME;
+			eventBus.publishMode(mode);
 			break;
 	}
 
 	brightness.update();
+	traversal.update();
+	metrics.update(epoch, brightness.getLux(), ledOutput.getBrightness());
+	recordStore.update();  // Compacts the oldest sector when the store runs low on erased ones
+	forwardWebEvents();
+#if defined(TELEMETRY_URL)
+	telemetry.update(epoch, brightness.getLux());
+#endif
 
+	loopMaxMicros = max(loopMaxMicros, micros() - loopStart);
 	vTaskDelay(pdMS_TO_TICKS(30));
 }
\ No newline at end of file
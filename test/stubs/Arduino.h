@@ -0,0 +1,202 @@
+#pragma once
+
+// Just enough of Arduino and FreeRTOS for the header-only modules tested on the host
+
+#include <algorithm>
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <map>
+
+using std::max;
+using std::min;
+
+#define IRAM_ATTR
+
+/**
+ * @brief Simulated time and the interrupts due in it
+ *
+ * Tests run on one thread. Time only moves when the code under test waits (vTaskDelay(),
+ * a notification or queue wait), and a wait runs the simulated interrupts that fall due
+ * in it, in time order, so a test sees the same interleaving on every run.
+ */
+struct HostClock {
+	uint64_t now = 0;  // Microseconds since boot
+	std::multimap<uint64_t, std::function<void()>> interrupts;
+
+	void reset() {
+		now = 0;
+		interrupts.clear();
+	}
+
+	/// Run an interrupt handler the given time from now
+	void schedule(uint32_t delayMicros, std::function<void()> handler) {
+		interrupts.emplace(now + delayMicros, std::move(handler));
+	}
+
+	/// Run the next interrupt if it is due within the given time, moving time to it
+	bool runNext(uint64_t withinMicros) {
+		if (interrupts.empty() || interrupts.begin()->first > now + withinMicros) {
+			return false;
+		}
+		auto next = interrupts.begin();
+		std::function<void()> handler = std::move(next->second);
+		now = max(now, next->first);
+		interrupts.erase(next);
+		handler();
+		return true;
+	}
+
+	/// Let time pass, running every interrupt due in it
+	void advance(uint64_t micros) {
+		uint64_t end = now + micros;
+		while (runNext(end - now)) {
+		}
+		now = end;
+	}
+};
+
+inline HostClock hostClock;
+
+inline uint32_t micros() {
+	return uint32_t(hostClock.now);
+}
+
+inline uint32_t millis() {
+	return uint32_t(hostClock.now / 1000);
+}
+
+struct HostEsp {
+	uint32_t getCycleCount() {
+		return uint32_t(hostClock.now * 160);
+	}
+};
+
+inline HostEsp ESP;
+
+struct HostSerial {
+	int printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+		va_list args;
+		va_start(args, format);
+		int length = vprintf(format, args);
+		va_end(args);
+		return length;
+	}
+
+	size_t write(const uint8_t*, size_t length) {
+		return length;	// Binary log records are dropped
+	}
+};
+
+inline HostSerial Serial;
+
+// --- FreeRTOS, one tick per millisecond ---
+
+typedef int BaseType_t;
+typedef uint32_t TickType_t;
+typedef void* TaskHandle_t;
+#define portMAX_DELAY 0xFFFFFFFF
+#define pdFALSE 0
+#define pdTRUE 1
+#define portYIELD_FROM_ISR()
+
+inline void vTaskDelay(TickType_t ticks) {
+	hostClock.advance(uint64_t(ticks) * 1000);
+}
+
+// Waits for a condition an interrupt sets, false if it did not within the timeout (portMAX_DELAY
+// gives up once no interrupt is left to run, where the firmware would block forever)
+inline bool hostWaitFor(const std::function<bool()>& ready, TickType_t timeout) {
+	uint64_t end = hostClock.now + uint64_t(timeout) * 1000;
+	while (!ready()) {
+		uint64_t left = timeout == portMAX_DELAY ? UINT64_MAX - hostClock.now : end - hostClock.now;
+		if (!hostClock.runNext(left)) {
+			if (timeout != portMAX_DELAY) {
+				hostClock.now = end;
+			}
+			return false;
+		}
+	}
+	return true;
+}
+
+// The one task the tests run as
+struct HostTask {
+	uint32_t notifications = 0;
+};
+
+inline HostTask hostTask;
+
+inline TaskHandle_t xTaskGetCurrentTaskHandle() {
+	return &hostTask;
+}
+
+inline uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t timeout) {
+	HostTask& task = hostTask;
+	if (!hostWaitFor([&] { return task.notifications > 0; }, timeout)) {
+		return 0;
+	}
+	uint32_t count = task.notifications;
+	task.notifications = clear ? 0 : count - 1;
+	return count;
+}
+
+inline void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higherPriorityTaskWoken) {
+	static_cast<HostTask*>(task)->notifications++;
+	*higherPriorityTaskWoken = pdTRUE;
+}
+
+// Queues copy items into the caller's static storage, as xQueueCreateStatic() does
+struct StaticQueue_t {
+	uint8_t* storage;
+	size_t depth;
+	size_t itemSize;
+	size_t head;
+	size_t count;
+};
+typedef StaticQueue_t* QueueHandle_t;
+
+inline QueueHandle_t xQueueCreateStatic(size_t depth, size_t itemSize, uint8_t* storage, StaticQueue_t* control) {
+	*control = { storage, depth, itemSize, 0, 0 };
+	return control;
+}
+
+inline BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t timeout) {
+	if (!hostWaitFor([&] { return queue->count < queue->depth; }, timeout)) {
+		return pdFALSE;
+	}
+	memcpy(queue->storage + (queue->head + queue->count) % queue->depth * queue->itemSize, item, queue->itemSize);
+	queue->count++;
+	return pdTRUE;
+}
+
+inline BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t timeout) {
+	if (!hostWaitFor([&] { return queue->count > 0; }, timeout)) {
+		return pdFALSE;
+	}
+	memcpy(item, queue->storage + queue->head * queue->itemSize, queue->itemSize);
+	queue->head = (queue->head + 1) % queue->depth;
+	queue->count--;
+	return pdTRUE;
+}
+
+// Tests run on one thread, a mutex is always free
+typedef void* SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex() {
+	static int mutex;
+	return &mutex;
+}
+
+inline int xSemaphoreTake(SemaphoreHandle_t, TickType_t) {
+	return pdTRUE;
+}
+
+inline int xSemaphoreGive(SemaphoreHandle_t) {
+	return pdTRUE;
+}
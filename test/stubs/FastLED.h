@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+struct CRGB {
+	uint8_t r = 0;
+	uint8_t g = 0;
+	uint8_t b = 0;
+
+	CRGB() = default;
+	CRGB(uint8_t r, uint8_t g, uint8_t b) : r(r), g(g), b(b) {}
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <string>
+#include <vector>
+
+/// NVS contents by "namespace/key", kept across Preferences objects like flash is across reboots
+inline std::map<std::string, std::vector<uint8_t>> simulatedNvs;
+
+/**
+ * @brief Preferences on simulatedNvs
+ *
+ * Like the real one, a put in a namespace opened read-only or not opened at all is refused
+ * (and counted so a test can check none were attempted).
+ */
+class Preferences {
+  public:
+	static inline uint32_t refusedWrites = 0;
+
+	bool begin(const char* name, bool readOnly = false) {
+		space = name;
+		this->readOnly = readOnly;
+		open = true;
+		return true;
+	}
+
+	void end() {
+		open = false;
+	}
+
+	bool clear() {
+		if (!writable()) {
+			return false;
+		}
+		for (auto entry = simulatedNvs.begin(); entry != simulatedNvs.end();) {
+			entry = entry->first.compare(0, space.size() + 1, space + "/") == 0 ? simulatedNvs.erase(entry) : std::next(entry);
+		}
+		return true;
+	}
+
+	size_t getBytes(const char* key, void* data, size_t length) {
+		auto entry = open ? simulatedNvs.find(space + "/" + key) : simulatedNvs.end();
+		if (entry == simulatedNvs.end() || entry->second.size() > length) {
+			return 0;
+		}
+		memcpy(data, entry->second.data(), entry->second.size());
+		return entry->second.size();
+	}
+
+	size_t putBytes(const char* key, const void* data, size_t length) {
+		if (!writable()) {
+			return 0;
+		}
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		simulatedNvs[space + "/" + key].assign(bytes, bytes + length);
+		return length;
+	}
+
+	bool getBool(const char* key, bool defaultValue = false) {
+		return get(key, defaultValue);
+	}
+	int32_t getInt(const char* key, int32_t defaultValue = 0) {
+		return get(key, defaultValue);
+	}
+	uint16_t getUShort(const char* key, uint16_t defaultValue = 0) {
+		return get(key, defaultValue);
+	}
+	uint32_t getULong(const char* key, uint32_t defaultValue = 0) {
+		return get(key, defaultValue);
+	}
+	float getFloat(const char* key, float defaultValue = NAN) {
+		return get(key, defaultValue);
+	}
+
+	size_t putUShort(const char* key, uint16_t value) {
+		return putBytes(key, &value, sizeof(value));
+	}
+	size_t putULong(const char* key, uint32_t value) {
+		return putBytes(key, &value, sizeof(value));
+	}
+
+  private:
+	std::string space;
+	bool readOnly = true;
+	bool open = false;
+
+	bool writable() {
+		if (!open || readOnly) {
+			refusedWrites++;
+			return false;
+		}
+		return true;
+	}
+
+	template <typename T>
+	T get(const char* key, T defaultValue) {
+		T value;
+		return getBytes(key, &value, sizeof(value)) == sizeof(value) ? value : defaultValue;
+	}
+};
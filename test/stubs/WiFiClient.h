@@ -0,0 +1,108 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <deque>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The one HTTP server WiFiClient connects to, scripted by the test
+ *
+ * Every request that arrives is recorded and answered with the next queued response,
+ * delivered readSize bytes per read() as TCP segments would be. A response that says
+ * "Connection: close" closes the connection once it has been read.
+ */
+struct SimulatedServer {
+	std::deque<std::string> responses;	// Answers to the next requests, in order
+	std::vector<std::string> requests;	// Requests received (head and body)
+	uint32_t connects = 0;
+	bool refuse = false;		// Connections fail
+	bool dropKeptAlive = false;	 // Take the next request on a reused connection, then close it without answering
+	size_t readSize = 256;
+
+	void reset() {
+		*this = SimulatedServer();
+	}
+};
+
+inline SimulatedServer simulatedServer;
+
+class WiFiClient {
+  public:
+	int connect(const char*, uint16_t, int32_t) {
+		stop();
+		if (simulatedServer.refuse) {
+			return 0;
+		}
+		simulatedServer.connects++;
+		open = true;
+		return 1;
+	}
+
+	uint8_t connected() {
+		deliver();
+		return open || !received.empty();
+	}
+
+	void stop() {
+		open = false;
+		requestsOnConnection = 0;
+		sending.clear();
+		received.clear();
+	}
+
+	void setNoDelay(bool) {}
+
+	size_t write(const uint8_t* data, size_t length) {
+		if (!open) {
+			return 0;
+		}
+		sending.append(reinterpret_cast<const char*>(data), length);
+		return length;
+	}
+
+	int available() {
+		deliver();
+		return int(received.size());
+	}
+
+	int read(uint8_t* data, size_t length) {
+		deliver();
+		size_t count = min(min(length, simulatedServer.readSize), received.size());
+		memcpy(data, received.data(), count);
+		received.erase(0, count);
+		if (received.empty() && closeAfterRead) {
+			open = false;
+		}
+		return int(count);
+	}
+
+  private:
+	bool open = false;
+	bool closeAfterRead = false;
+	uint32_t requestsOnConnection = 0;
+	std::string sending;   // Request written since the last response
+	std::string received;  // Response not read yet
+
+	// The request is complete once the client starts reading the response
+	void deliver() {
+		if (sending.empty() || !open) {
+			return;
+		}
+		simulatedServer.requests.push_back(sending);
+		sending.clear();
+
+		if (requestsOnConnection++ > 0 && simulatedServer.dropKeptAlive) {
+			simulatedServer.dropKeptAlive = false;
+			open = false;
+			return;
+		}
+		if (simulatedServer.responses.empty()) {
+			return;	 // No answer, the client times out
+		}
+		received = simulatedServer.responses.front();
+		simulatedServer.responses.pop_front();
+		closeAfterRead = received.find("Connection: close") != std::string::npos;
+	}
+};
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <vector>
+
+#include "esp_err.h"
+
+#define SOC_RMT_MEM_WORDS_PER_CHANNEL 48
+#define ESP_INTR_FLAG_LEVEL3 (1 << 3)
+
+enum gpio_num_t : int {};
+
+enum rmt_channel_t { RMT_CHANNEL_0, RMT_CHANNEL_1, RMT_CHANNEL_2, RMT_CHANNEL_3, RMT_CHANNEL_MAX };
+
+typedef struct {
+	union {
+		struct {
+			uint32_t duration0 : 15;
+			uint32_t level0 : 1;
+			uint32_t duration1 : 15;
+			uint32_t level1 : 1;
+		};
+		uint32_t val;
+	};
+} rmt_item32_t;
+
+struct rmt_config_t {
+	rmt_channel_t channel;
+	gpio_num_t gpio_num;
+	uint8_t clk_div;
+	uint8_t mem_block_num;
+};
+
+#define RMT_DEFAULT_CONFIG_TX(gpio, channel_id) \
+	{ channel_id, gpio, 80, 1 }
+
+typedef void (*rmt_tx_end_fn_t)(rmt_channel_t channel, void* arg);
+
+/**
+ * @brief The RMT transmit channels of an ESP32-C3, on the simulated clock
+ *
+ * Each channel's memory runs into the blocks of the channels after it, so a channel set up
+ * over another one's blocks is counted as a conflict. A transmit keeps what was sent and
+ * raises the end-of-transmit interrupt once the items' total duration has passed, later
+ * by lateMicros to hold up a refill the way a Wi-Fi interrupt can.
+ */
+struct SimulatedRmt {
+	struct Channel {
+		bool installed = false;
+		uint8_t memBlocks = 0;
+		uint8_t clockDivider = 0;
+		int gpio = -1;
+		uint32_t writes = 0;
+		std::vector<rmt_item32_t> sent;	 // Items of the last transmit
+		bool sending = false;
+	};
+
+	Channel channels[RMT_CHANNEL_MAX];
+	rmt_tx_end_fn_t txEnd = nullptr;
+	void* txEndArg = nullptr;
+	uint32_t conflicts = 0;		   // Overlapping memory, or a write to a channel that is not ready or still sending
+	uint32_t lateMicros = 0;	   // Added to the end of every transmit while set
+	bool failInstall = false;	   // rmt_driver_install() fails
+
+	void reset() {
+		*this = SimulatedRmt();
+	}
+};
+
+inline SimulatedRmt simulatedRmt;
+
+inline esp_err_t rmt_config(const rmt_config_t* config) {
+	if (config->channel + config->mem_block_num > RMT_CHANNEL_MAX) {
+		simulatedRmt.conflicts++;
+		return ESP_FAIL;
+	}
+	SimulatedRmt::Channel& channel = simulatedRmt.channels[config->channel];
+	channel.memBlocks = config->mem_block_num;
+	channel.clockDivider = config->clk_div;
+	channel.gpio = config->gpio_num;
+	return ESP_OK;
+}
+
+inline esp_err_t rmt_driver_install(rmt_channel_t channel, size_t, int) {
+	if (simulatedRmt.failInstall) {
+		return ESP_FAIL;
+	}
+	for (uint8_t other = 0; other < RMT_CHANNEL_MAX; other++) {
+		const SimulatedRmt::Channel& installed = simulatedRmt.channels[other];
+		if (installed.installed && other < channel + simulatedRmt.channels[channel].memBlocks
+			&& channel < other + installed.memBlocks) {
+			simulatedRmt.conflicts++;
+		}
+	}
+	simulatedRmt.channels[channel].installed = true;
+	return ESP_OK;
+}
+
+inline void rmt_register_tx_end_callback(rmt_tx_end_fn_t function, void* arg) {
+	simulatedRmt.txEnd = function;
+	simulatedRmt.txEndArg = arg;
+}
+
+inline esp_err_t rmt_write_items(rmt_channel_t id, const rmt_item32_t* items, int count, bool) {
+	SimulatedRmt::Channel& channel = simulatedRmt.channels[id];
+	if (!channel.installed || channel.sending || items == nullptr) {
+		simulatedRmt.conflicts++;
+		return ESP_FAIL;
+	}
+
+	uint64_t ticks = 0;
+	for (int i = 0; i < count; i++) {
+		ticks += items[i].duration0 + items[i].duration1;
+	}
+	channel.sent.assign(items, items + count);
+	channel.writes++;
+	channel.sending = true;
+
+	// 80MHz APB clock divided by clk_div
+	uint32_t wireMicros = uint32_t((ticks * channel.clockDivider + 79) / 80);
+	hostClock.schedule(wireMicros + simulatedRmt.lateMicros, [id] {
+		simulatedRmt.channels[id].sending = false;
+		if (simulatedRmt.txEnd) {
+			simulatedRmt.txEnd(id, simulatedRmt.txEndArg);
+		}
+	});
+	return ESP_OK;
+}
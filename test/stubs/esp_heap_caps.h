@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+
+/// Heap that runs out after a set number of allocations, for the out of memory paths
+struct SimulatedHeap {
+	int32_t allocationsLeft = -1;  // -1 = never runs out
+	uint32_t allocations = 0;
+
+	void reset() {
+		allocationsLeft = -1;
+		allocations = 0;
+	}
+};
+
+inline SimulatedHeap simulatedHeap;
+
+inline void* heap_caps_malloc(size_t size, uint32_t) {
+	if (simulatedHeap.allocationsLeft == 0) {
+		return nullptr;
+	}
+	if (simulatedHeap.allocationsLeft > 0) {
+		simulatedHeap.allocationsLeft--;
+	}
+	simulatedHeap.allocations++;
+	return malloc(size);
+}
+
+inline void heap_caps_free(void* pointer) {
+	free(pointer);
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "esp_err.h"
+
+enum esp_partition_type_t { ESP_PARTITION_TYPE_DATA = 1 };
+enum esp_partition_subtype_t { ESP_PARTITION_SUBTYPE_ANY = 0xFF };
+
+struct esp_partition_t {
+	uint32_t size;
+};
+
+/**
+ * @brief A data partition on NOR flash, for the host tests
+ *
+ * An erase sets a whole sector to 0xFF and a write can only clear bits, as on the chip.
+ * Writes to bytes that were not erased first and accesses past the end are counted, so a
+ * test can check a flash format never does either. Cutting the power drops every write and
+ * erase from a given byte on, until the next reset().
+ */
+struct SimulatedFlash {
+	esp_partition_t partition = { 0 };
+	std::vector<uint8_t> bytes;
+	uint32_t overwrites = 0;  // Bytes programmed that were not erased
+	uint32_t outOfRange = 0;  // Reads, writes and erases past the end of the partition
+	uint32_t erases = 0;
+	int32_t powerBudget = -1;  // Bytes still programmed before the power is cut, -1 = never
+
+	/// Erased partition of the given size
+	void reset(uint32_t size) {
+		partition.size = size;
+		bytes.assign(size, 0xFF);
+		overwrites = outOfRange = erases = 0;
+		powerBudget = -1;
+	}
+
+	bool inRange(uint32_t offset, size_t length) {
+		if (offset + length > bytes.size()) {
+			outOfRange++;
+			return false;
+		}
+		return true;
+	}
+};
+
+inline SimulatedFlash simulatedFlash;
+
+inline const esp_partition_t* esp_partition_find_first(esp_partition_type_t, esp_partition_subtype_t, const char*) {
+	return simulatedFlash.partition.size ? &simulatedFlash.partition : nullptr;
+}
+
+inline esp_err_t esp_partition_read(const esp_partition_t*, size_t offset, void* data, size_t length) {
+	if (!simulatedFlash.inRange(offset, length)) {
+		return ESP_ERR_INVALID_SIZE;
+	}
+	memcpy(data, &simulatedFlash.bytes[offset], length);
+	return ESP_OK;
+}
+
+inline esp_err_t esp_partition_write(const esp_partition_t*, size_t offset, const void* data, size_t length) {
+	if (!simulatedFlash.inRange(offset, length)) {
+		return ESP_ERR_INVALID_SIZE;
+	}
+	for (size_t i = 0; i < length && simulatedFlash.powerBudget != 0; i++) {
+		uint8_t& byte = simulatedFlash.bytes[offset + i];
+		simulatedFlash.overwrites += byte != 0xFF;
+		byte &= static_cast<const uint8_t*>(data)[i];
+		if (simulatedFlash.powerBudget > 0) {
+			simulatedFlash.powerBudget--;
+		}
+	}
+	return ESP_OK;
+}
+
+inline esp_err_t esp_partition_erase_range(const esp_partition_t*, size_t offset, size_t length) {
+	if (!simulatedFlash.inRange(offset, length)) {
+		return ESP_ERR_INVALID_SIZE;
+	}
+	if (simulatedFlash.powerBudget != 0) {
+		memset(&simulatedFlash.bytes[offset], 0xFF, length);
+		simulatedFlash.erases++;
+	}
+	return ESP_OK;
+}
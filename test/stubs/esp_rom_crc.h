@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+
+/// CRC-32 (IEEE, reflected) with the ROM's conventions: pass 0 to start, or the last result to continue
+inline uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t* data, uint32_t length) {
+	crc = ~crc;
+	while (length--) {
+		crc ^= *data++;
+		for (uint8_t bit = 0; bit < 8; bit++) {
+			crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+		}
+	}
+	return ~crc;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+// The ROM's tinfl API on the host's zlib (link with -lz), raw deflate like tinfl without TINFL_FLAG_PARSE_ZLIB_HEADER
+
+#include <zlib.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#define TINFL_LZ_DICT_SIZE 32768
+#define TINFL_FLAG_HAS_MORE_INPUT 2
+
+enum tinfl_status {
+	TINFL_STATUS_FAILED = -1,
+	TINFL_STATUS_DONE = 0,
+	TINFL_STATUS_NEEDS_MORE_INPUT = 1,
+	TINFL_STATUS_HAS_MORE_OUTPUT = 2
+};
+
+struct tinfl_decompressor {
+	z_stream stream;
+	bool started;
+	tinfl_status ended;	 // Status the stream ended with, TINFL_STATUS_NEEDS_MORE_INPUT while it runs
+};
+
+#define tinfl_init(r)                               \
+	do {                                            \
+		(r)->started = false;                       \
+		(r)->ended = TINFL_STATUS_NEEDS_MORE_INPUT; \
+	} while (0)
+
+inline tinfl_status tinfl_decompress(tinfl_decompressor* r,
+									 const uint8_t* in,
+									 size_t* inSize,
+									 uint8_t*,
+									 uint8_t* outNext,
+									 size_t* outSize,
+									 uint32_t) {
+	if (r->ended != TINFL_STATUS_NEEDS_MORE_INPUT) {
+		*inSize = *outSize = 0;
+		return r->ended;
+	}
+	if (!r->started) {
+		memset(&r->stream, 0, sizeof(r->stream));
+		if (inflateInit2(&r->stream, -15) != Z_OK) {
+			return TINFL_STATUS_FAILED;
+		}
+		r->started = true;
+	}
+
+	z_stream& stream = r->stream;
+	stream.next_in = const_cast<uint8_t*>(in);
+	stream.avail_in = uInt(*inSize);
+	stream.next_out = outNext;
+	stream.avail_out = uInt(*outSize);
+	int result = inflate(&stream, Z_NO_FLUSH);
+	*inSize -= stream.avail_in;
+	*outSize -= stream.avail_out;
+
+	if (result == Z_STREAM_END || (result != Z_OK && result != Z_BUF_ERROR)) {
+		inflateEnd(&stream);
+		r->ended = result == Z_STREAM_END ? TINFL_STATUS_DONE : TINFL_STATUS_FAILED;
+		return r->ended;
+	}
+	return stream.avail_out == 0 ? TINFL_STATUS_HAS_MORE_OUTPUT : TINFL_STATUS_NEEDS_MORE_INPUT;
+}
@@ -0,0 +1,161 @@
+#include <unity.h>
+
+#include <string>
+
+#include "feedClient.h"
+
+void setUp() {
+	hostClock.reset();
+	simulatedServer.reset();
+}
+
+void tearDown() {}
+
+static std::string body;
+
+static bool collect(const uint8_t* data, size_t length) {
+	body.append(reinterpret_cast<const char*>(data), length);
+	return true;
+}
+
+static int get(FeedClient& client, FeedValidators& validators, uint32_t timeoutMs = 5000) {
+	body.clear();
+	return client.get("http://feed.test/trains", validators, collect, timeoutMs);
+}
+
+static std::string gzip(const std::string& text) {
+	z_stream stream = {};
+	deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+	std::string compressed(deflateBound(&stream, text.size()) + 32, '\0');
+	stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(text.data()));
+	stream.avail_in = text.size();
+	stream.next_out = reinterpret_cast<Bytef*>(&compressed[0]);
+	stream.avail_out = compressed.size();
+	deflate(&stream, Z_FINISH);
+	compressed.resize(stream.total_out);
+	deflateEnd(&stream);
+	return compressed;
+}
+
+// A 200 updates the validators, the next request reuses the connection and sends them
+void test_conditional_get_on_one_connection() {
+	simulatedServer.responses = {
+		"HTTP/1.1 200 OK\r\nContent-Type: application/json; charset=utf-8\r\nETag: \"v1\"\r\nContent-Length: 7\r\n\r\n{\"a\":1}",
+		"HTTP/1.1 304 Not Modified\r\nETag: \"v1\"\r\n\r\n",
+	};
+	FeedClient client;
+	FeedValidators validators;
+
+	TEST_ASSERT_EQUAL_INT(200, get(client, validators));
+	TEST_ASSERT_EQUAL_STRING("{\"a\":1}", body.c_str());
+	TEST_ASSERT_EQUAL_STRING("\"v1\"", validators.etag);
+	TEST_ASSERT_EQUAL_STRING("application/json", client.getContentType());
+	TEST_ASSERT_FALSE(client.reused);
+	TEST_ASSERT_TRUE(simulatedServer.requests[0].find("GET /trains HTTP/1.1\r\nHost: feed.test\r\n") == 0);
+
+	TEST_ASSERT_EQUAL_INT(304, get(client, validators));
+	TEST_ASSERT_TRUE(body.empty());
+	TEST_ASSERT_TRUE(client.reused);
+	TEST_ASSERT_EQUAL_UINT32(1, simulatedServer.connects);
+	TEST_ASSERT_TRUE(simulatedServer.requests[1].find("If-None-Match: \"v1\"\r\n") != std::string::npos);
+}
+
+// Chunked and gzip bodies are decoded however the segments split them
+void test_chunked_gzip_in_small_reads() {
+	std::string text;
+	for (uint16_t i = 0; i < 400; i++) {
+		text += "{\"block\":" + std::to_string(100 + i % 135) + "},";
+	}
+	std::string compressed = gzip(text);
+
+	std::string chunked;
+	for (size_t start = 0; start < compressed.size(); start += 700) {
+		std::string chunk = compressed.substr(start, 700);
+		char size[16];
+		snprintf(size, sizeof(size), "%zx\r\n", chunk.size());
+		chunked += size + chunk + "\r\n";
+	}
+	chunked += "0\r\n\r\n";
+
+	for (size_t readSize : { size_t(1), size_t(13), size_t(1024) }) {
+		simulatedServer.reset();
+		simulatedServer.readSize = readSize;
+		simulatedServer.responses = {
+			"HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\nContent-Encoding: gzip\r\n\r\n" + chunked,
+		};
+		FeedClient client;
+		FeedValidators validators;
+		TEST_ASSERT_EQUAL_INT(200, get(client, validators));
+		TEST_ASSERT_TRUE(body == text);
+		TEST_ASSERT_EQUAL_UINT32(text.size(), client.bodyBytes);
+	}
+}
+
+// A body that runs until the server closes, the next request connects again
+void test_close_delimited_body() {
+	simulatedServer.responses = {
+		"HTTP/1.1 200 OK\r\nConnection: close\r\n\r\nall of it",
+		"HTTP/1.1 200 OK\r\nContent-Length: 4\r\n\r\nnext",
+	};
+	FeedClient client;
+	FeedValidators validators;
+	TEST_ASSERT_EQUAL_INT(200, get(client, validators));
+	TEST_ASSERT_EQUAL_STRING("all of it", body.c_str());
+	TEST_ASSERT_EQUAL_INT(200, get(client, validators));
+	TEST_ASSERT_EQUAL_STRING("next", body.c_str());
+	TEST_ASSERT_FALSE(client.reused);
+	TEST_ASSERT_EQUAL_UINT32(2, simulatedServer.connects);
+}
+
+// A GET that finds the kept-alive connection closed is sent again on a new one, a POST is not
+void test_stale_connection_retries_only_a_get() {
+	simulatedServer.responses = {
+		"HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nv1",
+		"HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nv2",
+		"HTTP/1.1 204 No Content\r\n\r\n",
+	};
+	FeedClient client;
+	FeedValidators validators;
+	TEST_ASSERT_EQUAL_INT(200, get(client, validators));
+
+	simulatedServer.dropKeptAlive = true;
+	TEST_ASSERT_EQUAL_INT(200, get(client, validators));
+	TEST_ASSERT_EQUAL_STRING("v2", body.c_str());
+	TEST_ASSERT_EQUAL_UINT32(2, simulatedServer.connects);
+	TEST_ASSERT_EQUAL_UINT32(3, simulatedServer.requests.size());
+
+	simulatedServer.dropKeptAlive = true;
+	const uint8_t batch[] = { 1, 2, 3, 4 };
+	TEST_ASSERT_EQUAL_INT(FEED_ERROR_PROTOCOL,
+						  client.post("http://feed.test/telemetry", "application/octet-stream", batch, sizeof(batch)));
+	TEST_ASSERT_EQUAL_UINT32(2, simulatedServer.connects);
+	TEST_ASSERT_EQUAL_UINT32(4, simulatedServer.requests.size());
+	TEST_ASSERT_TRUE(simulatedServer.requests[3].find("POST /telemetry HTTP/1.1\r\n") == 0);
+	TEST_ASSERT_TRUE(simulatedServer.requests[3].find("Content-Length: 4\r\n") != std::string::npos);
+
+	// The caller sends it again when it chooses
+	TEST_ASSERT_EQUAL_INT(204, client.post("http://feed.test/telemetry", "application/octet-stream", batch, sizeof(batch)));
+	TEST_ASSERT_EQUAL_UINT32(3, simulatedServer.connects);
+}
+
+// The whole request runs against one deadline, and a refused connection is reported as such
+void test_deadline_and_refused_connection() {
+	FeedClient client;
+	FeedValidators validators;
+	TEST_ASSERT_EQUAL_INT(FEED_ERROR_TIMEOUT, get(client, validators, 500));
+	TEST_ASSERT_TRUE(millis() >= 500 && millis() <= 502);
+
+	simulatedServer.refuse = true;
+	TEST_ASSERT_EQUAL_INT(FEED_ERROR_CONNECT, get(client, validators));
+	TEST_ASSERT_EQUAL_INT(FEED_ERROR_URL, client.get("https://feed.test/trains", validators, collect));
+}
+
+int main() {
+	UNITY_BEGIN();
+	RUN_TEST(test_conditional_get_on_one_connection);
+	RUN_TEST(test_chunked_gzip_in_small_reads);
+	RUN_TEST(test_close_delimited_body);
+	RUN_TEST(test_stale_connection_retries_only_a_get);
+	RUN_TEST(test_deadline_and_refused_connection);
+	return UNITY_END();
+}
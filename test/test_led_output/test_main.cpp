@@ -0,0 +1,192 @@
+#include <unity.h>
+
+#include "ledOutput.h"
+
+PowerManager power;
+EventBus eventBus;
+
+void setUp() {
+	hostClock.reset();
+	hostTask.notifications = 0;
+	simulatedRmt.reset();
+	simulatedHeap.reset();
+}
+
+void tearDown() {}
+
+// Value of a sent byte, from its 8 items (a one is the long high pulse)
+static uint8_t sentByte(const rmt_item32_t* items) {
+	uint8_t value = 0;
+	for (uint8_t bit = 0; bit < 8; bit++) {
+		TEST_ASSERT_EQUAL_UINT32(LED_T1_TICKS + LED_T2_TICKS + LED_T3_TICKS, items[bit].duration0 + items[bit].duration1);
+		value = (value << 1) | (items[bit].duration0 == LED_T1_TICKS + LED_T2_TICKS);
+	}
+	return value;
+}
+
+// Expected 8.LED_DITHER_BITS fixed point output of a channel, as the encoder computes it
+static uint32_t expectedLevel(uint8_t colour, uint16_t gain) {
+	uint16_t linear = uint16_t(powf(colour / 255.0f, LED_GAMMA) * 255.0f * 256.0f + 0.5f);
+	return (uint32_t(linear) * gain) >> (24 - LED_DITHER_BITS);
+}
+
+// Bytes go out in GRB order with the WS2811 bit timing, black is all zeros
+void test_encodes_grb() {
+	CRGB pixels[2] = { CRGB(255, 0, 0), CRGB(0, 0, 0) };
+	LedOutput output;
+	output.add(4, pixels, 2);
+	TEST_ASSERT_TRUE(output.begin());
+	output.show();
+	TEST_ASSERT_TRUE(output.waitForCompletion(portMAX_DELAY));
+
+	const std::vector<rmt_item32_t>& sent = simulatedRmt.channels[0].sent;
+	TEST_ASSERT_EQUAL_UINT32(2 * 24, sent.size());
+	TEST_ASSERT_EQUAL_UINT32(0, sentByte(&sent[0]));
+	TEST_ASSERT_GREATER_THAN_UINT32(253, sentByte(&sent[8]));
+	TEST_ASSERT_EQUAL_UINT32(0, sentByte(&sent[16]));
+	for (uint8_t i = 24; i < 48; i += 8) {
+		TEST_ASSERT_EQUAL_UINT32(0, sentByte(&sent[i]));
+	}
+	TEST_ASSERT_EQUAL_UINT32(0, simulatedRmt.conflicts);
+}
+
+// Over 2^LED_DITHER_BITS frames the bytes sent add up to the 16-bit level
+void test_dither_averages_to_the_level() {
+	const uint8_t colours[] = { 1, 7, 100, 254 };
+	const uint16_t gains[] = { 65535, 20000, 600 };
+	for (uint16_t gain : gains) {
+		for (uint8_t colour : colours) {
+			CRGB pixel(colour, colour, colour);
+			LedOutput output;
+			output.add(4, &pixel, 1);
+			TEST_ASSERT_TRUE(output.begin());
+			output.setBrightness(gain);
+
+			uint32_t sum = 0;
+			for (uint8_t frame = 0; frame < (1 << LED_DITHER_BITS); frame++) {
+				output.show();
+				TEST_ASSERT_TRUE(output.waitForCompletion(portMAX_DELAY));
+				sum += sentByte(&simulatedRmt.channels[0].sent[8]);  // Red
+			}
+			uint32_t level = expectedLevel(colour, gain);
+			TEST_ASSERT_EQUAL_UINT32(level, sum);  // The residual is back to its starting phase
+			simulatedRmt.reset();
+		}
+	}
+}
+
+// show() returns while the frame is on the wire, completion comes from the transmit end interrupt
+void test_show_does_not_wait_for_the_wire() {
+	CRGB pixels[235];
+	LedOutput output;
+	output.add(4, pixels, 235);
+	TEST_ASSERT_TRUE(output.begin());
+
+	output.show();
+	TEST_ASSERT_TRUE(output.isBusy());
+	TEST_ASSERT_EQUAL_UINT32(0, micros());
+
+	TEST_ASSERT_TRUE(output.waitForCompletion(portMAX_DELAY));
+	TEST_ASSERT_FALSE(output.isBusy());
+	TEST_ASSERT_EQUAL_UINT32(1, output.frames);
+	TEST_ASSERT_EQUAL_UINT32(0, output.underruns);
+	uint32_t wireMicros = 235 * 24 * LED_BIT_NANOS / 1000;
+	TEST_ASSERT_TRUE(micros() >= wireMicros && micros() <= wireMicros + 1);
+
+	// The next show() encodes while the previous frame is still going out
+	output.show();
+	output.show();
+	TEST_ASSERT_TRUE(output.waitForCompletion(portMAX_DELAY));
+	TEST_ASSERT_EQUAL_UINT32(3, output.frames);
+	TEST_ASSERT_EQUAL_UINT32(0, simulatedRmt.conflicts);
+}
+
+// The longest strand takes the last channel and every memory block the other one leaves
+void test_memory_blocks_do_not_overlap() {
+	CRGB shortStrand[60];
+	CRGB longStrand[175];
+	LedOutput output;
+	output.add(4, longStrand, 175);
+	output.add(5, shortStrand, 60);
+	TEST_ASSERT_TRUE(output.begin());
+
+	TEST_ASSERT_EQUAL_UINT32(5, simulatedRmt.channels[0].gpio);
+	TEST_ASSERT_EQUAL_UINT32(1, simulatedRmt.channels[0].memBlocks);
+	TEST_ASSERT_EQUAL_UINT32(4, simulatedRmt.channels[1].gpio);
+	TEST_ASSERT_EQUAL_UINT32(LED_RMT_MEM_BLOCKS - 1, simulatedRmt.channels[1].memBlocks);
+
+	output.show();
+	TEST_ASSERT_TRUE(output.waitForCompletion(portMAX_DELAY));
+	TEST_ASSERT_EQUAL_UINT32(60 * 24, simulatedRmt.channels[0].sent.size());
+	TEST_ASSERT_EQUAL_UINT32(175 * 24, simulatedRmt.channels[1].sent.size());
+	TEST_ASSERT_EQUAL_UINT32(1, output.frames);
+	TEST_ASSERT_EQUAL_UINT32(0, simulatedRmt.conflicts);
+}
+
+// A transmit that ends late was refilled late, the frame is counted and resent once
+void test_underrun_is_resent() {
+	CRGB pixels[100];
+	LedOutput output;
+	output.add(4, pixels, 100);
+	TEST_ASSERT_TRUE(output.begin());
+
+	simulatedRmt.lateMicros = 200;
+	output.show();
+	simulatedRmt.lateMicros = 0;
+	TEST_ASSERT_TRUE(output.repair());
+	TEST_ASSERT_FALSE(output.repair());
+	TEST_ASSERT_EQUAL_UINT32(2, output.frames);
+	TEST_ASSERT_EQUAL_UINT32(1, output.underruns);
+	TEST_ASSERT_EQUAL_UINT32(1, output.retransmits);
+	TEST_ASSERT_EQUAL_UINT32(2, simulatedRmt.channels[0].writes);
+
+	// Late by less than half the channel's memory is still a good frame
+	simulatedRmt.lateMicros = 10;
+	output.show();
+	TEST_ASSERT_FALSE(output.repair());
+	TEST_ASSERT_EQUAL_UINT32(1, output.underruns);
+}
+
+// begin() reports a channel it could not set up or buffers it could not allocate
+void test_begin_failures() {
+	CRGB pixels[235];
+	simulatedRmt.failInstall = true;
+	LedOutput noChannel;
+	noChannel.add(4, pixels, 235);
+	TEST_ASSERT_FALSE(noChannel.begin());
+
+	for (int32_t allocations = 0; allocations < 3; allocations++) {
+		simulatedRmt.reset();
+		simulatedHeap.allocationsLeft = allocations;
+		LedOutput noMemory;
+		noMemory.add(4, pixels, 235);
+		TEST_ASSERT_FALSE(noMemory.begin());
+	}
+}
+
+// A brightness change is published once, setting the same gain again is not an event
+void test_brightness_is_published() {
+	static StaticEventQueue<4> events;
+	eventBus.subscribe(events, EVENT_MASK(EVENT_BRIGHTNESS));
+
+	LedOutput output;
+	output.setBrightness(1000);
+	output.setBrightness(1000);
+	Event event;
+	TEST_ASSERT_TRUE(events.receive(event));
+	TEST_ASSERT_EQUAL_UINT32(EVENT_BRIGHTNESS, event.type);
+	TEST_ASSERT_EQUAL_UINT32(1000, event.brightness.gain);
+	TEST_ASSERT_FALSE(events.receive(event));
+}
+
+int main() {
+	UNITY_BEGIN();
+	RUN_TEST(test_encodes_grb);
+	RUN_TEST(test_dither_averages_to_the_level);
+	RUN_TEST(test_show_does_not_wait_for_the_wire);
+	RUN_TEST(test_memory_blocks_do_not_overlap);
+	RUN_TEST(test_underrun_is_resent);
+	RUN_TEST(test_begin_failures);
+	RUN_TEST(test_brightness_is_published);
+	return UNITY_END();
+}
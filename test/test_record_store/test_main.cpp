@@ -0,0 +1,151 @@
+#include <unity.h>
+
+#include <cstdlib>
+
+#include "recordStore.h"
+
+#define PARTITION_SIZE 0x10000	// As in boards/default_4MB.csv
+
+// Value a test expects a key to have, and its length (0 = none)
+struct Expected {
+	uint8_t data[STORE_SECTOR_SIZE];
+	uint16_t length = 0;
+};
+
+static Expected expected[RECORD_KEYS];
+
+void setUp() {
+	simulatedFlash.reset(PARTITION_SIZE);
+	for (Expected& value : expected) {
+		value.length = 0;
+	}
+}
+
+void tearDown() {}
+
+static uint16_t fill(uint8_t* data, uint16_t length) {
+	for (uint16_t i = 0; i < length; i++) {
+		data[i] = rand();
+	}
+	return length;
+}
+
+// Checks a store holds exactly the expected values and the flash was used as NOR flash
+static void checkStore(RecordStore& store) {
+	uint8_t data[STORE_SECTOR_SIZE];
+	for (uint16_t key = 1; key < RECORD_KEYS; key++) {
+		if (expected[key].length == 0) {
+			TEST_ASSERT_FALSE(store.get(RecordKey(key), data, 4));
+			continue;
+		}
+		TEST_ASSERT_TRUE(store.get(RecordKey(key), data, expected[key].length));
+		TEST_ASSERT_EQUAL_MEMORY(expected[key].data, data, expected[key].length);
+	}
+	TEST_ASSERT_EQUAL_UINT32(0, simulatedFlash.overwrites);
+	TEST_ASSERT_EQUAL_UINT32(0, simulatedFlash.outOfRange);
+}
+
+static void checkAfterReboot() {
+	RecordStore rebooted;
+	rebooted.begin();
+	checkStore(rebooted);
+}
+
+static bool put(RecordStore& store, RecordKey key, uint16_t length) {
+	uint8_t data[STORE_SECTOR_SIZE];
+	fill(data, length);
+	if (!store.put(key, data, length)) {
+		return false;
+	}
+	memcpy(expected[key].data, data, length);
+	expected[key].length = length;
+	return true;
+}
+
+// Small values put often with a large one now and then, compacted by update() as in the main loop
+void test_values_survive_reboots() {
+	for (uint8_t boot = 0; boot < 20; boot++) {
+		RecordStore store;
+		store.begin();
+		checkStore(store);
+		for (uint16_t i = 0; i < 300; i++) {
+			TEST_ASSERT_TRUE(put(store, RECORD_BRIGHTNESS, 4));
+			if (i % 50 == 0) {
+				TEST_ASSERT_TRUE(put(store, RECORD_WIFI, 1536));
+			}
+			store.update();
+		}
+		checkStore(store);
+	}
+	TEST_ASSERT_GREATER_THAN_UINT32(2 * PARTITION_SIZE / STORE_SECTOR_SIZE, simulatedFlash.erases);
+}
+
+// Without update() every put that needs a sector compacts inline, and may only take the last erased one to do so
+void test_inline_compaction() {
+	RecordStore store;
+	store.begin();
+	for (uint16_t i = 0; i < 2000; i++) {
+		RecordKey key = RecordKey(1 + rand() % (RECORD_KEYS - 1));
+		TEST_ASSERT_TRUE(put(store, key, 4 + rand() % 1200));
+		checkStore(store);
+		if (i % 100 == 0) {
+			checkAfterReboot();
+		}
+	}
+	checkAfterReboot();
+}
+
+// Records too large to all stay current in a small partition, a put with no room fails without writing
+void test_full_store() {
+	simulatedFlash.reset(4 * STORE_SECTOR_SIZE);
+	RecordStore store;
+	store.begin();
+	const uint16_t length = STORE_SECTOR_SIZE - 64;
+	uint16_t failed = 0;
+	for (uint16_t i = 0; i < 200; i++) {
+		RecordKey key = RecordKey(1 + i % (RECORD_KEYS - 1));
+		failed += !put(store, key, length - rand() % 32);
+		store.update();
+		checkStore(store);
+	}
+	TEST_ASSERT_GREATER_THAN_UINT16(0, failed);
+	checkAfterReboot();
+}
+
+// The power is cut part way through a put (and the compaction it may start), each key then has its old or new value
+void test_power_cut() {
+	uint8_t data[STORE_SECTOR_SIZE];
+	for (uint16_t cut = 0; cut < 500; cut++) {
+		RecordStore store;
+		store.begin();
+		checkStore(store);
+
+		RecordKey key = RecordKey(1 + rand() % (RECORD_KEYS - 1));
+		uint16_t length = fill(data, 4 + rand() % 1200);
+		simulatedFlash.powerBudget = rand() % (length + 64);
+		store.put(key, data, length);
+		bool completed = simulatedFlash.powerBudget != 0;
+		simulatedFlash.powerBudget = -1;
+
+		RecordStore rebooted;
+		rebooted.begin();
+		uint8_t stored[STORE_SECTOR_SIZE];
+		if (rebooted.get(key, stored, length) && memcmp(stored, data, length) == 0) {
+			memcpy(expected[key].data, data, length);
+			expected[key].length = length;
+		} else {
+			TEST_ASSERT_FALSE(completed);
+		}
+		checkStore(rebooted);
+	}
+}
+
+int main() {
+	srand(1);
+	UNITY_BEGIN();
+	RUN_TEST(test_values_survive_reboots);
+	RUN_TEST(test_inline_compaction);
+	RUN_TEST(test_full_store);
+	RUN_TEST(test_power_cut);
+	return UNITY_END();
+}
@@ -0,0 +1,120 @@
+#include <unity.h>
+
+#define MIN_BRIGHTNESS 1
+#define MAX_BRIGHTNESS 255
+#define BRIGHTNESS_STEP 10
+
+#include "settings.h"
+
+Preferences preferences;
+
+void setUp() {
+	simulatedNvs.clear();
+	Preferences::refusedWrites = 0;
+}
+
+void tearDown() {
+	TEST_ASSERT_EQUAL_UINT32(0, Preferences::refusedWrites);
+}
+
+static Settings revision(uint32_t number) {
+	Settings settings;
+	settings.revision = number;
+	settings.updateInterval = 10 + number;
+	settings.numMirrors = 1;
+	snprintf(settings.mirrors[0], SETTINGS_URL_LEN, "http://mirror%u.test/feed", unsigned(number));
+	return settings;
+}
+
+static uint32_t revisionAfterReboot() {
+	SettingsCache rebooted;
+	rebooted.begin();
+	return rebooted.get().revision;
+}
+
+// Nothing saved yet, the built in settings are used
+void test_built_in_settings() {
+	SettingsCache settings;
+	settings.begin();
+	TEST_ASSERT_EQUAL_UINT32(0, settings.get().revision);
+	TEST_ASSERT_EQUAL_UINT32(30, settings.get().updateInterval);
+	TEST_ASSERT_EQUAL_UINT32(MIN_BRIGHTNESS, settings.get().minBrightness);
+	TEST_ASSERT_EQUAL_UINT32(0, settings.getRejectedRevision());
+}
+
+// Staged settings wait for applyStaged(), then are saved once they survive probation
+void test_kept_after_probation() {
+	SettingsCache settings;
+	settings.begin();
+	settings.stage(revision(5));
+	TEST_ASSERT_EQUAL_UINT32(0, settings.get().revision);
+	TEST_ASSERT_TRUE(settings.applyStaged());
+	TEST_ASSERT_FALSE(settings.applyStaged());
+	TEST_ASSERT_EQUAL_UINT32(5, settings.get().revision);
+	TEST_ASSERT_EQUAL_STRING("http://mirror5.test/feed", settings.get().mirrors[0]);
+
+	// Failures below the limit do not roll it back
+	for (uint8_t fetch = 0; fetch < SETTINGS_PROBATION_FETCHES; fetch++) {
+		TEST_ASSERT_EQUAL_UINT32(0, revisionAfterReboot());
+		TEST_ASSERT_FALSE(settings.reportFetch(fetch < SETTINGS_PROBATION_FETCHES - (SETTINGS_PROBATION_FAILURES - 1)));
+	}
+	TEST_ASSERT_EQUAL_UINT32(5, settings.get().revision);
+	TEST_ASSERT_EQUAL_UINT32(5, revisionAfterReboot());
+
+	// Out of probation, failures no longer count
+	for (uint8_t fetch = 0; fetch < 2 * SETTINGS_PROBATION_FAILURES; fetch++) {
+		TEST_ASSERT_FALSE(settings.reportFetch(false));
+	}
+	TEST_ASSERT_EQUAL_UINT32(5, settings.get().revision);
+}
+
+// Too many failed fetches on probation restore the previous settings and remember the revision
+void test_rolled_back_after_failures() {
+	SettingsCache settings;
+	settings.begin();
+	settings.stage(revision(5));
+	settings.applyStaged();
+	for (uint8_t fetch = 0; fetch < SETTINGS_PROBATION_FETCHES; fetch++) {
+		settings.reportFetch(true);
+	}
+
+	settings.stage(revision(6));
+	settings.applyStaged();
+	TEST_ASSERT_FALSE(settings.reportFetch(true));
+	for (uint8_t failure = 1; failure < SETTINGS_PROBATION_FAILURES; failure++) {
+		TEST_ASSERT_FALSE(settings.reportFetch(false));
+	}
+	TEST_ASSERT_TRUE(settings.reportFetch(false));
+	TEST_ASSERT_EQUAL_UINT32(5, settings.get().revision);
+	TEST_ASSERT_EQUAL_STRING("http://mirror5.test/feed", settings.get().mirrors[0]);
+	TEST_ASSERT_EQUAL_UINT32(6, settings.getRejectedRevision());
+
+	SettingsCache rebooted;
+	rebooted.begin();
+	TEST_ASSERT_EQUAL_UINT32(5, rebooted.get().revision);
+	TEST_ASSERT_EQUAL_UINT32(6, rebooted.getRejectedRevision());
+}
+
+// Settings saved by a firmware with another layout are ignored
+void test_other_layout_ignored() {
+	Settings old = revision(9);
+	old.layout = SETTINGS_LAYOUT + 1;
+	preferences.begin("settings", false);
+	preferences.putBytes("active", &old, sizeof(old));
+	preferences.end();
+	TEST_ASSERT_EQUAL_UINT32(0, revisionAfterReboot());
+
+	preferences.begin("settings", false);
+	preferences.putBytes("active", &old, sizeof(old) - 1);
+	preferences.end();
+	TEST_ASSERT_EQUAL_UINT32(0, revisionAfterReboot());
+}
+
+int main() {
+	UNITY_BEGIN();
+	RUN_TEST(test_built_in_settings);
+	RUN_TEST(test_kept_after_probation);
+	RUN_TEST(test_rolled_back_after_failures);
+	RUN_TEST(test_other_layout_ignored);
+	return UNITY_END();
+}